@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Archive.cpp
+// Purpose            : Binary format for finished geometries
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "Archive.h"
+
+#include "FloatMesh.h"
+#include "Geometry.h"
+#include "Polygon3.h"
+
+#include <cstring>
+#include <set>
+#include <stdexcept>
+
+static const char magic[8] = { 'O', 'S', 'D', 'G', 'E', 'O', '\r', '\n' };
+static const uint32_t version = 2;
+
+ArchiveWriter::ArchiveWriter(std::ostream &out) :
+		out(out) {
+}
+
+void ArchiveWriter::WriteHeader() {
+	Write(magic, sizeof(magic));
+	WriteValue(version);
+	WriteValue((uint32_t) sizeof(Geometry::Vertex));
+	WriteValue((uint32_t) sizeof(Geometry::Edge));
+	WriteValue((uint32_t) sizeof(Geometry::Triangle));
+}
+
+std::string ArchiveWriter::GetFormat() {
+	return "v" + std::to_string(version) + "-"
+			+ std::to_string(sizeof(Geometry::Vertex)) + "-"
+			+ std::to_string(sizeof(Geometry::Edge)) + "-"
+			+ std::to_string(sizeof(Geometry::Triangle));
+}
+
+void ArchiveWriter::WriteChecksum() {
+	const uint64_t sum = checksum.Get();
+	out.write((const char*) &sum, sizeof(sum));
+	if (!out.good())
+		throw std::runtime_error("ArchiveWriter::Write - Writing failed.");
+}
+
+void ArchiveWriter::WriteString(const std::string &value) {
+	WriteValue((uint64_t) value.size());
+	Write(value.data(), value.size());
+}
+
+static std::vector<uint64_t> ToVector(const std::set<size_t> &values) {
+	return std::vector<uint64_t>(values.begin(), values.end());
+}
+
+void ArchiveWriter::WriteGeometry(const Geometry &geometry) {
+	WriteString(geometry.name);
+	WriteValue(geometry.matrix);
+	const uint8_t flags[] = { geometry.smooth, geometry.paintEdges,
+			geometry.paintTriangles, geometry.paintVertices,
+			geometry.paintNormals, geometry.paintDirection,
+			geometry.paintSelected, geometry.verticesHaveNormal,
+			geometry.verticesHaveColor, geometry.verticesHaveTextur,
+			geometry.edgesHaveNormal, geometry.edgesHaveColor,
+			geometry.trianglesHaveNormal, geometry.trianglesHaveColor,
+			geometry.trianglesHaveTexture, geometry.finished };
+	Write(flags, sizeof(flags));
+	WriteValue((uint64_t) geometry.dotSize);
+	WriteValue(geometry.epsilon);
+	WriteArray(geometry.v);
+	WriteArray(geometry.e);
+	WriteArray(geometry.t);
+	WriteArray(ToVector(geometry.openvertices));
+	WriteArray(ToVector(geometry.openedges));
+}
+
+void ArchiveWriter::WritePolygon(const Polygon3 &polygon) {
+	WriteGeometry(polygon);
+	WriteValue((uint64_t) polygon.groupCount);
+	WriteValue((uint64_t) polygon.firstIndex);
+	WriteValue((uint64_t) polygon.lastIndex);
+}
+
+void ArchiveWriter::WriteMesh(const FloatMesh &mesh) {
+	WriteArray(mesh.p);
+	WriteArray(mesh.n);
+	WriteArray(mesh.idx);
+	WriteArray(mesh.c);
+}
+
+void ArchiveWriter::Write(const void *data, size_t bytes) {
+	out.write((const char*) data, (std::streamsize) bytes);
+	if (!out.good())
+		throw std::runtime_error("ArchiveWriter::Write - Writing failed.");
+	checksum.Add(data, bytes);
+}
+
+ArchiveReader::ArchiveReader(const char *data, size_t size) :
+		data(data), size(size) {
+}
+
+bool ArchiveReader::ReadHeader() {
+	const char *const start = data;
+	if (size < sizeof(magic) || std::memcmp(data, magic, sizeof(magic)) != 0)
+		return false;
+	data += sizeof(magic);
+	size -= sizeof(magic);
+	if (ReadValue<uint32_t>() != version
+			|| ReadValue<uint32_t>() != sizeof(Geometry::Vertex)
+			|| ReadValue<uint32_t>() != sizeof(Geometry::Edge)
+			|| ReadValue<uint32_t>() != sizeof(Geometry::Triangle))
+		return false;
+
+	// The checksum at the end covers everything before, including the
+	// header.
+	uint64_t stored;
+	if (size < sizeof(stored))
+		ThrowEnd();
+	size -= sizeof(stored);
+	std::memcpy(&stored, data + size, sizeof(stored));
+	Fletcher64 checksum;
+	checksum.Add(start, (size_t) (data + size - start));
+	if (checksum.Get() != stored)
+		throw std::runtime_error(
+				"ArchiveReader::ReadHeader - The checksum does not match.");
+	return true;
+}
+
+std::string ArchiveReader::ReadString() {
+	const uint64_t length = ReadValue<uint64_t>();
+	if (length > size)
+		ThrowEnd();
+	std::string value(data, (size_t) length);
+	data += length;
+	size -= length;
+	return value;
+}
+
+static std::set<size_t> ToSet(const std::vector<uint64_t> &values) {
+	return std::set<size_t>(values.begin(), values.end());
+}
+
+static void CheckIndex(size_t index, size_t count, const char *what) {
+	if (index >= count)
+		throw std::runtime_error(
+				std::string("ArchiveReader::ReadGeometry - Index of a ") + what
+						+ " out of range.");
+}
+
+void ArchiveReader::ReadGeometry(Geometry &geometry) {
+	geometry.Clear();
+	geometry.name = ReadString();
+	geometry.matrix = ReadValue<AffineTransformMatrix>();
+	uint8_t flags[16];
+	Read(flags, sizeof(flags));
+	geometry.smooth = flags[0];
+	geometry.paintEdges = flags[1];
+	geometry.paintTriangles = flags[2];
+	geometry.paintVertices = flags[3];
+	geometry.paintNormals = flags[4];
+	geometry.paintDirection = flags[5];
+	geometry.paintSelected = flags[6];
+	geometry.verticesHaveNormal = flags[7];
+	geometry.verticesHaveColor = flags[8];
+	geometry.verticesHaveTextur = flags[9];
+	geometry.edgesHaveNormal = flags[10];
+	geometry.edgesHaveColor = flags[11];
+	geometry.trianglesHaveNormal = flags[12];
+	geometry.trianglesHaveColor = flags[13];
+	geometry.trianglesHaveTexture = flags[14];
+	geometry.finished = flags[15];
+	geometry.dotSize = (size_t) ReadValue<uint64_t>();
+	geometry.epsilon = ReadValue<double>();
+	ReadArray(geometry.v);
+	ReadArray(geometry.e);
+	ReadArray(geometry.t);
+	std::vector<uint64_t> temp;
+	ReadArray(temp);
+	geometry.openvertices = ToSet(temp);
+	ReadArray(temp);
+	geometry.openedges = ToSet(temp);
+
+	// Edges not connected to triangles yet are marked with -1 in the
+	// triangles.
+	const size_t V = geometry.v.size();
+	const size_t E = geometry.e.size();
+	const size_t T = geometry.t.size();
+	for (const Geometry::Edge &ed : geometry.e) {
+		CheckIndex(ed.va, V, "vertex");
+		CheckIndex(ed.vb, V, "vertex");
+		if (ed.trianglecount >= 1)
+			CheckIndex(ed.ta, T, "triangle");
+		if (ed.trianglecount >= 2)
+			CheckIndex(ed.tb, T, "triangle");
+	}
+	for (const Geometry::Triangle &tri : geometry.t) {
+		CheckIndex(tri.va, V, "vertex");
+		CheckIndex(tri.vb, V, "vertex");
+		CheckIndex(tri.vc, V, "vertex");
+		for (size_t idx : { tri.ea, tri.eb, tri.ec })
+			if (idx != (size_t) -1)
+				CheckIndex(idx, E, "edge");
+	}
+	for (size_t idx : geometry.openvertices)
+		CheckIndex(idx, V, "vertex");
+	for (size_t idx : geometry.openedges)
+		CheckIndex(idx, E, "edge");
+}
+
+void ArchiveReader::ReadPolygon(Polygon3 &polygon) {
+	ReadGeometry(polygon);
+	polygon.groupCount = (size_t) ReadValue<uint64_t>();
+	polygon.firstIndex = (size_t) ReadValue<uint64_t>();
+	polygon.lastIndex = (size_t) ReadValue<uint64_t>();
+	// Both point one past the last vertex for a new polygon.
+	if (polygon.firstIndex > polygon.CountVertices()
+			|| polygon.lastIndex > polygon.CountVertices())
+		throw std::runtime_error(
+				"ArchiveReader::ReadPolygon - Index of a vertex out of range.");
+}
+
+void ArchiveReader::ReadMesh(FloatMesh &mesh) {
+	mesh.Clear();
+	ReadArray(mesh.p);
+	ReadArray(mesh.n);
+	ReadArray(mesh.idx);
+	ReadArray(mesh.c);
+	if (mesh.p.size() % 3 != 0 || mesh.idx.size() % 3 != 0
+			|| (mesh.n.size() != 0 && mesh.n.size() != mesh.p.size())
+			|| (mesh.c.size() != 0 && mesh.c.size() != mesh.idx.size() / 3))
+		throw std::runtime_error(
+				"ArchiveReader::ReadMesh - The arrays do not match.");
+	const size_t V = mesh.p.size() / 3;
+	for (uint32_t idx : mesh.idx)
+		if (idx >= V)
+			throw std::runtime_error(
+					"ArchiveReader::ReadMesh - Index of a vertex out of range.");
+}
+
+void ArchiveReader::Read(void *target, size_t bytes) {
+	if (bytes == 0)
+		return;
+	if (bytes > size)
+		ThrowEnd();
+	std::memcpy(target, data, bytes);
+	data += bytes;
+	size -= bytes;
+}
+
+bool ArchiveReader::AtEnd() const {
+	return size == 0;
+}
+
+void ArchiveReader::ThrowEnd() {
+	throw std::runtime_error("ArchiveReader::Read - Unexpected end of data.");
+}
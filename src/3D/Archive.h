@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Archive.h
+// Purpose            : Binary format for finished geometries
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_ARCHIVE_H
+#define L3D_ARCHIVE_H
+
+/** \class ArchiveWriter
+ * 	\code #include "Archive.h"\endcode
+ * 	\ingroup File3D
+ *  \brief Write finished geometries into a compact binary format
+ *
+ * The vertices, edges and triangles of a Geometry are written as they are in
+ * memory. Reading them back is a copy of three arrays; Finish() and the
+ * joining of the vertices are not repeated. This is used for the disk cache
+ * of the imported meshes.
+ *
+ * The format is not meant for exchange: The header contains the sizes of the
+ * structures. A file written by a different build (other compiler, other
+ * version of Geometry) is rejected by ArchiveReader::ReadHeader().
+ *
+ * WriteChecksum() ends the archive with a Fletcher64 checksum over all bytes
+ * written before.
+ *
+ * Increase the version in Archive.cpp, if the layout or the meaning of the
+ * data changes.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../system/Hash.h"
+
+class FloatMesh;
+class Geometry;
+class Polygon3;
+
+class ArchiveWriter {
+public:
+	explicit ArchiveWriter(std::ostream &out);
+
+	void WriteHeader(); ///< Magic number, version and sizes of the structures
+
+	/**\brief Version and sizes of the structures as text
+	 *
+	 * E.g. "v2-88-88-200". Files with a different format are not readable by
+	 * this build. Used to keep them in separate directories.
+	 */
+	static std::string GetFormat();
+	void WriteChecksum(); ///< Ends the archive, nothing may be written afterwards.
+
+	template<typename T> void WriteValue(const T &value) {
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Only plain data can be written directly.");
+		Write(&value, sizeof(T));
+	}
+	template<typename T> void WriteArray(const std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Only plain data can be written directly.");
+		WriteValue((uint64_t) values.size());
+		Write(values.data(), values.size() * sizeof(T));
+	}
+	void WriteString(const std::string &value);
+
+	void WriteGeometry(const Geometry &geometry);
+	void WritePolygon(const Polygon3 &polygon);
+	void WriteMesh(const FloatMesh &mesh);
+
+	/**\brief Write raw bytes
+	 *
+	 * \throw std::runtime_error if the stream fails, e.g. the disk is full.
+	 */
+	void Write(const void *data, size_t bytes);
+
+private:
+	std::ostream &out;
+	Fletcher64 checksum;
+};
+
+/** \class ArchiveReader
+ * 	\code #include "Archive.h"\endcode
+ * 	\ingroup File3D
+ *  \brief Read the format written by ArchiveWriter from memory
+ *
+ * The data is usually the Data() of a MappedFile. All reads are bounds
+ * checked; corrupt or truncated data throws a std::runtime_error. The
+ * checksum is tested by ReadHeader(). The indices of the vertices, edges and
+ * triangles in a Geometry or FloatMesh are checked to be in range, so that a
+ * damaged file cannot lead to an access outside of the arrays later.
+ */
+class ArchiveReader {
+public:
+	ArchiveReader(const char *data, size_t size);
+
+	/**\brief Check the header and the checksum
+	 *
+	 * \return false, if the data was not written by ArchiveWriter or by a
+	 *         build with a different version or memory layout.
+	 * \throw std::runtime_error if the checksum does not match, i.e. the
+	 *        data is damaged.
+	 */
+	bool ReadHeader();
+
+	template<typename T> T ReadValue() {
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Only plain data can be read directly.");
+		T value;
+		Read(&value, sizeof(T));
+		return value;
+	}
+	template<typename T> void ReadArray(std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Only plain data can be read directly.");
+		const uint64_t count = ReadValue<uint64_t>();
+		if (count > (uint64_t) (size / sizeof(T)))
+			ThrowEnd();
+		values.resize((size_t) count);
+		Read(values.data(), values.size() * sizeof(T));
+	}
+	std::string ReadString();
+
+	void ReadGeometry(Geometry &geometry); ///< Replaces the whole geometry.
+	void ReadPolygon(Polygon3 &polygon);
+	void ReadMesh(FloatMesh &mesh);
+
+	void Read(void *target, size_t bytes);
+	bool AtEnd() const;
+
+private:
+	[[noreturn]] static void ThrowEnd();
+
+	const char *data;
+	size_t size;
+};
+
+#endif /* L3D_ARCHIVE_H */
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Archive_test.cpp
+// Purpose            : Test the binary format for finished geometries
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef USE_CPPUNIT
+
+#include "Archive.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FloatMesh.h"
+#include "Geometry.h"
+#include "Polygon3.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+class ArchiveTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( ArchiveTest );
+	CPPUNIT_TEST(testGeometry);
+	CPPUNIT_TEST(testDamaged);
+	CPPUNIT_TEST(testIndices);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	static Geometry Box() {
+		Geometry geo;
+		geo.name = "box";
+		geo.AddQuad(Vector3(0, 0, 0), Vector3(0, 1, 0), Vector3(1, 1, 0),
+				Vector3(1, 0, 0));
+		geo.AddQuad(Vector3(0, 0, 1), Vector3(1, 0, 1), Vector3(1, 1, 1),
+				Vector3(0, 1, 1));
+		geo.AddQuad(Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 0, 1),
+				Vector3(0, 0, 1));
+		geo.Finish();
+		geo.CalculateNormals();
+		geo.matrix.TranslateGlobal(1, 2, 3);
+		return geo;
+	}
+
+	void testGeometry() {
+		const Geometry geo = Box();
+		FloatMesh mesh;
+		mesh.Assign(geo);
+		Polygon3 poly;
+		poly.AddEdge(Vector3(0, 0, 0), Vector3(1, 0, 0));
+		poly.AddEdge(Vector3(1, 0, 0), Vector3(1, 1, 0));
+
+		std::ostringstream out;
+		ArchiveWriter writer(out);
+		writer.WriteHeader();
+		writer.WriteGeometry(geo);
+		writer.WriteMesh(mesh);
+		writer.WritePolygon(poly);
+		writer.WriteValue(1.5);
+		writer.WriteChecksum();
+		const std::string data = out.str();
+
+		ArchiveReader reader(data.data(), data.size());
+		CPPUNIT_ASSERT(reader.ReadHeader());
+		Geometry geo2;
+		geo2.AddVertex(Vector3(5, 5, 5));
+		reader.ReadGeometry(geo2);
+		FloatMesh mesh2;
+		reader.ReadMesh(mesh2);
+		Polygon3 poly2;
+		reader.ReadPolygon(poly2);
+		CPPUNIT_ASSERT_EQUAL(1.5, reader.ReadValue<double>());
+		CPPUNIT_ASSERT(reader.AtEnd());
+
+		CPPUNIT_ASSERT_EQUAL(geo.name, geo2.name);
+		CPPUNIT_ASSERT_EQUAL(geo.CountVertices(), geo2.CountVertices());
+		CPPUNIT_ASSERT_EQUAL(geo.CountEdges(), geo2.CountEdges());
+		CPPUNIT_ASSERT_EQUAL(geo.CountTriangles(), geo2.CountTriangles());
+		CPPUNIT_ASSERT(geo2.PassedSelfCheck(true));
+		CPPUNIT_ASSERT_EQUAL(geo.IsClosed(), geo2.IsClosed());
+		for (size_t n = 0; n < geo.CountVertices(); n++) {
+			CPPUNIT_ASSERT(geo[n] == geo2[n]);
+			CPPUNIT_ASSERT(geo[n].n == geo2[n].n);
+		}
+		for (unsigned char n = 0; n < 16; n++)
+			CPPUNIT_ASSERT_EQUAL(geo.matrix[n], geo2.matrix[n]);
+		CPPUNIT_ASSERT(mesh.p == mesh2.p);
+		CPPUNIT_ASSERT(mesh.idx == mesh2.idx);
+		CPPUNIT_ASSERT_EQUAL(poly.CountEdges(), poly2.CountEdges());
+	}
+
+	void testDamaged() {
+		std::ostringstream out;
+		ArchiveWriter writer(out);
+		writer.WriteHeader();
+		writer.WriteGeometry(Box());
+		writer.WriteChecksum();
+		std::string data = out.str();
+
+		// Truncated
+		ArchiveReader reader(data.data(), data.size() - 1);
+		CPPUNIT_ASSERT_THROW(reader.ReadHeader(), std::runtime_error);
+
+		// A changed bit
+		data[data.size() / 2] ^= 0x10;
+		ArchiveReader reader2(data.data(), data.size());
+		CPPUNIT_ASSERT_THROW(reader2.ReadHeader(), std::runtime_error);
+		data[data.size() / 2] ^= 0x10;
+
+		// Other version
+		data[8]++;
+		ArchiveReader reader3(data.data(), data.size());
+		CPPUNIT_ASSERT(!reader3.ReadHeader());
+	}
+
+	/**\brief Indices out of range with a valid checksum
+	 */
+	void testIndices() {
+		Geometry geo = Box();
+		geo.GetTriangle(1).vc = geo.CountVertices();
+		FloatMesh mesh;
+		mesh.Assign(Box());
+		mesh.idx.back() = (uint32_t) (mesh.p.size() / 3);
+
+		{
+			std::ostringstream out;
+			ArchiveWriter writer(out);
+			writer.WriteHeader();
+			writer.WriteGeometry(geo);
+			writer.WriteChecksum();
+			const std::string data = out.str();
+			ArchiveReader reader(data.data(), data.size());
+			CPPUNIT_ASSERT(reader.ReadHeader());
+			Geometry geo2;
+			CPPUNIT_ASSERT_THROW(reader.ReadGeometry(geo2), std::runtime_error);
+		}
+		{
+			std::ostringstream out;
+			ArchiveWriter writer(out);
+			writer.WriteHeader();
+			writer.WriteMesh(mesh);
+			writer.WriteChecksum();
+			const std::string data = out.str();
+			ArchiveReader reader(data.data(), data.size());
+			CPPUNIT_ASSERT(reader.ReadHeader());
+			FloatMesh mesh2;
+			CPPUNIT_ASSERT_THROW(reader.ReadMesh(mesh2), std::runtime_error);
+		}
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ArchiveTest);
+#endif
@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : BVH.cpp
+// Purpose            : Bounding volume hierarchy over the triangles of a Geometry
+// Thread Safe        : Yes (after construction)
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+// Maximum number of triangles in a leaf
+static const size_t leafSize = 4;
+
+static inline double Component(const Vector3 &a, uint_fast8_t i) {
+	return (i == 0) ? a.x : ((i == 1) ? a.y : a.z);
+}
+
+BVH::BVH(const std::vector<Geometry::Vertex> &v,
+		const std::vector<Geometry::Triangle> &t) {
+	Build(v, t);
+}
+
+void BVH::Build(const std::vector<Geometry::Vertex> &v,
+		const std::vector<Geometry::Triangle> &t) {
+	nodes.clear();
+	idx.resize(t.size());
+	std::iota(idx.begin(), idx.end(), 0);
+	if (t.empty())
+		return;
+
+	// Bounding box of every triangle. The center of the box is used for
+	// sorting the triangles into the tree.
+	std::vector<Vector3> tmin(t.size());
+	std::vector<Vector3> tmax(t.size());
+	std::vector<Vector3> center(t.size());
+	for (size_t i = 0; i < t.size(); i++) {
+		const Vector3 &a = v[t[i].va];
+		const Vector3 &b = v[t[i].vb];
+		const Vector3 &c = v[t[i].vc];
+		tmin[i].Set(std::fmin(a.x, std::fmin(b.x, c.x)),
+				std::fmin(a.y, std::fmin(b.y, c.y)),
+				std::fmin(a.z, std::fmin(b.z, c.z)));
+		tmax[i].Set(std::fmax(a.x, std::fmax(b.x, c.x)),
+				std::fmax(a.y, std::fmax(b.y, c.y)),
+				std::fmax(a.z, std::fmax(b.z, c.z)));
+		center[i] = (tmin[i] + tmax[i]) / 2.0;
+	}
+
+	// Leaves hold at least leafSize / 2 + 1 triangles.
+	nodes.reserve(2 * (t.size() / (leafSize / 2 + 1)) + 1);
+	nodes.emplace_back();
+	nodes[0].first = 0;
+	nodes[0].count = t.size();
+
+	// Split the nodes top-down. The children of a node are appended to the
+	// vector, so the loop reaches them later.
+	for (size_t n = 0; n < nodes.size(); n++) {
+		const size_t first = nodes[n].first;
+		const size_t count = nodes[n].count;
+
+		Vector3 bmin(DBL_MAX, DBL_MAX, DBL_MAX);
+		Vector3 bmax(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+		Vector3 cmin = bmin;
+		Vector3 cmax = bmax;
+		for (size_t i = first; i < first + count; i++) {
+			const size_t k = idx[i];
+			bmin.Set(std::fmin(bmin.x, tmin[k].x), std::fmin(bmin.y, tmin[k].y),
+					std::fmin(bmin.z, tmin[k].z));
+			bmax.Set(std::fmax(bmax.x, tmax[k].x), std::fmax(bmax.y, tmax[k].y),
+					std::fmax(bmax.z, tmax[k].z));
+			cmin.Set(std::fmin(cmin.x, center[k].x),
+					std::fmin(cmin.y, center[k].y),
+					std::fmin(cmin.z, center[k].z));
+			cmax.Set(std::fmax(cmax.x, center[k].x),
+					std::fmax(cmax.y, center[k].y),
+					std::fmax(cmax.z, center[k].z));
+		}
+		nodes[n].min = bmin;
+		nodes[n].max = bmax;
+		if (count <= leafSize)
+			continue;
+
+		const Vector3 size = cmax - cmin;
+		uint_fast8_t axis = 0;
+		if (size.y > size.x && size.y >= size.z)
+			axis = 1;
+		if (size.z > size.x && size.z > size.y)
+			axis = 2;
+		const size_t mid = first + count / 2;
+		std::nth_element(idx.begin() + first, idx.begin() + mid,
+				idx.begin() + first + count,
+				[&center, axis](size_t a, size_t b) {
+					return Component(center[a], axis)
+							< Component(center[b], axis);
+				});
+
+		const size_t left = nodes.size();
+		nodes.emplace_back();
+		nodes.emplace_back();
+		nodes[left].first = first;
+		nodes[left].count = mid - first;
+		nodes[left + 1].first = mid;
+		nodes[left + 1].count = first + count - mid;
+		nodes[n].first = left;
+		nodes[n].count = 0;
+	}
+}
+
+size_t BVH::CountTriangles() const {
+	return idx.size();
+}
+
+size_t BVH::GetMemoryUsage() const {
+	return sizeof(BVH) + nodes.capacity() * sizeof(Node)
+			+ idx.capacity() * sizeof(size_t);
+}
+
+// Entry distance of a ray into a box. Returns false, if the box is missed or
+// only entered after tmax.
+static bool RayBox(const Vector3 &p0, const Vector3 &dir, const Vector3 &min,
+		const Vector3 &max, double tmax, double &tnear) {
+	double t0 = 0.0;
+	double t1 = tmax;
+	for (uint_fast8_t i = 0; i < 3; i++) {
+		const double p = Component(p0, i);
+		const double d = Component(dir, i);
+		const double lo = Component(min, i);
+		const double hi = Component(max, i);
+		if (d == 0.0) {
+			if (p < lo || p > hi)
+				return false;
+			continue;
+		}
+		double ta = (lo - p) / d;
+		double tb = (hi - p) / d;
+		if (ta > tb)
+			std::swap(ta, tb);
+		t0 = std::fmax(t0, ta);
+		t1 = std::fmin(t1, tb);
+		if (t0 > t1)
+			return false;
+	}
+	tnear = t0;
+	return true;
+}
+
+BVH::Hit BVH::IntersectRay(const std::vector<Geometry::Vertex> &v,
+		const std::vector<Geometry::Triangle> &t, const Vector3 &p0,
+		const Vector3 &dir, int facing) const {
+	Hit hit;
+	if (nodes.empty())
+		return hit;
+	double best = DBL_MAX;
+
+	std::vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const Node &node = nodes[stack.back()];
+		stack.pop_back();
+		double tnear;
+		if (!RayBox(p0, dir, node.min, node.max, best, tnear))
+			continue;
+		if (node.count == 0) {
+			// Visit the nearer child first.
+			double tl = DBL_MAX;
+			double tr = DBL_MAX;
+			const bool hl = RayBox(p0, dir, nodes[node.first].min,
+					nodes[node.first].max, best, tl);
+			const bool hr = RayBox(p0, dir, nodes[node.first + 1].min,
+					nodes[node.first + 1].max, best, tr);
+			if (hl && hr) {
+				if (tl < tr) {
+					stack.push_back(node.first + 1);
+					stack.push_back(node.first);
+				} else {
+					stack.push_back(node.first);
+					stack.push_back(node.first + 1);
+				}
+			} else if (hl) {
+				stack.push_back(node.first);
+			} else if (hr) {
+				stack.push_back(node.first + 1);
+			}
+			continue;
+		}
+		for (size_t i = node.first; i < node.first + node.count; i++) {
+			// Moeller-Trumbore intersection
+			const Geometry::Triangle &tri = t[idx[i]];
+			const Vector3 &a = v[tri.GetVertexIndex(0)];
+			const Vector3 &b = v[tri.GetVertexIndex(1)];
+			const Vector3 &c = v[tri.GetVertexIndex(2)];
+			const Vector3 e1 = b - a;
+			const Vector3 e2 = c - a;
+			const Vector3 pvec = dir * e2;
+			const double det = e1.Dot(pvec);
+			if (std::fabs(det) < DBL_MIN)
+				continue;
+			// det = -dir.Dot(e1 * e2), i.e. negative for triangles facing in
+			// the direction of the ray.
+			if (facing > 0 && det > 0.0)
+				continue;
+			if (facing < 0 && det < 0.0)
+				continue;
+			const double inv = 1.0 / det;
+			const Vector3 tvec = p0 - a;
+			const double u = tvec.Dot(pvec) * inv;
+			if (u < 0.0 || u > 1.0)
+				continue;
+			const Vector3 qvec = tvec * e1;
+			const double w = dir.Dot(qvec) * inv;
+			if (w < 0.0 || u + w > 1.0)
+				continue;
+			const double d = e2.Dot(qvec) * inv;
+			if (d < 0.0 || d >= best)
+				continue;
+			best = d;
+			hit.triangle = idx[i];
+			hit.t = d;
+		}
+	}
+	if (hit.triangle != (size_t) -1)
+		hit.p = p0 + dir * hit.t;
+	return hit;
+}
+
+std::vector<size_t> BVH::FindInSlab(const std::vector<Geometry::Vertex> &v,
+		const std::vector<Geometry::Triangle> &t, const Vector3 &n,
+		double dmin, double dmax) const {
+	std::vector<size_t> ret;
+	if (nodes.empty())
+		return ret;
+	std::vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const Node &node = nodes[stack.back()];
+		stack.pop_back();
+		const Vector3 c = (node.min + node.max) / 2.0;
+		const Vector3 h = (node.max - node.min) / 2.0;
+		const double dc = n.Dot(c);
+		const double r = std::fabs(n.x) * h.x + std::fabs(n.y) * h.y
+				+ std::fabs(n.z) * h.z;
+		if (dc + r < dmin || dc - r > dmax)
+			continue;
+		if (node.count == 0) {
+			stack.push_back(node.first + 1);
+			stack.push_back(node.first);
+			continue;
+		}
+		for (size_t i = node.first; i < node.first + node.count; i++) {
+			const Geometry::Triangle &tri = t[idx[i]];
+			const double da = n.Dot(v[tri.va]);
+			const double db = n.Dot(v[tri.vb]);
+			const double dd = n.Dot(v[tri.vc]);
+			if (std::fmax(da, std::fmax(db, dd)) < dmin)
+				continue;
+			if (std::fmin(da, std::fmin(db, dd)) > dmax)
+				continue;
+			ret.push_back(idx[i]);
+		}
+	}
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+
+// Closest point on a triangle (Ericson, Real-Time Collision Detection, 5.1.5)
+static Vector3 ClosestPointTriangle(const Vector3 &p, const Vector3 &a,
+		const Vector3 &b, const Vector3 &c) {
+	const Vector3 ab = b - a;
+	const Vector3 ac = c - a;
+	const Vector3 ap = p - a;
+	const double d1 = ab.Dot(ap);
+	const double d2 = ac.Dot(ap);
+	if (d1 <= 0.0 && d2 <= 0.0)
+		return a;
+	const Vector3 bp = p - b;
+	const double d3 = ab.Dot(bp);
+	const double d4 = ac.Dot(bp);
+	if (d3 >= 0.0 && d4 <= d3)
+		return b;
+	const double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+		return a + ab * (d1 / (d1 - d3));
+	const Vector3 cp = p - c;
+	const double d5 = ab.Dot(cp);
+	const double d6 = ac.Dot(cp);
+	if (d6 >= 0.0 && d5 <= d6)
+		return c;
+	const double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+		return a + ac * (d2 / (d2 - d6));
+	const double va = d3 * d6 - d5 * d4;
+	if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	const double denom = 1.0 / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+static double DistanceBox2(const Vector3 &p, const Vector3 &min,
+		const Vector3 &max) {
+	double d2 = 0.0;
+	for (uint_fast8_t i = 0; i < 3; i++) {
+		const double pi = Component(p, i);
+		const double d = std::fmax(0.0,
+				std::fmax(Component(min, i) - pi, pi - Component(max, i)));
+		d2 += d * d;
+	}
+	return d2;
+}
+
+BVH::Hit BVH::ClosestPoint(const std::vector<Geometry::Vertex> &v,
+		const std::vector<Geometry::Triangle> &t, const Vector3 &p) const {
+	Hit hit;
+	if (nodes.empty())
+		return hit;
+	double best2 = DBL_MAX;
+
+	std::vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const Node &node = nodes[stack.back()];
+		stack.pop_back();
+		if (DistanceBox2(p, node.min, node.max) >= best2)
+			continue;
+		if (node.count == 0) {
+			const double dl = DistanceBox2(p, nodes[node.first].min,
+					nodes[node.first].max);
+			const double dr = DistanceBox2(p, nodes[node.first + 1].min,
+					nodes[node.first + 1].max);
+			if (dl < dr) {
+				stack.push_back(node.first + 1);
+				stack.push_back(node.first);
+			} else {
+				stack.push_back(node.first);
+				stack.push_back(node.first + 1);
+			}
+			continue;
+		}
+		for (size_t i = node.first; i < node.first + node.count; i++) {
+			const Geometry::Triangle &tri = t[idx[i]];
+			const Vector3 q = ClosestPointTriangle(p, v[tri.va], v[tri.vb],
+					v[tri.vc]);
+			const double d2 = (q - p).Abs2();
+			if (d2 < best2) {
+				best2 = d2;
+				hit.triangle = idx[i];
+				hit.p = q;
+			}
+		}
+	}
+	if (hit.triangle != (size_t) -1)
+		hit.t = std::sqrt(best2);
+	return hit;
+}
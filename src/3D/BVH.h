@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : BVH.h
+// Purpose            : Bounding volume hierarchy over the triangles of a Geometry
+// Thread Safe        : Yes (after construction)
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_BVH_H
+#define L3D_BVH_H
+
+/** \class BVH
+ * 	\code #include "BVH.h"\endcode
+ * 	\ingroup Base3D
+ *  \brief Bounding volume hierarchy over the triangles of a Geometry
+ *
+ * A binary tree of axis aligned boxes. Each leaf holds a few triangles. The
+ * tree is split at the median of the triangle centers along the longest
+ * side of the box.
+ *
+ * The tree only stores the indices of the triangles. The queries get the
+ * vertices and triangles passed in again. They have to be unchanged since
+ * the construction of the tree.
+ *
+ * Normally the BVH is not used directly. The Geometry builds one on the
+ * first query (Geometry::GetBVH()) and drops it, when the geometry is
+ * modified.
+ */
+
+#include "Geometry.h"
+#include "Vector3.h"
+
+#include <cstddef>
+#include <vector>
+
+class BVH {
+public:
+	/**\brief Result of a ray query
+	 */
+	struct Hit {
+		size_t triangle = (size_t) -1; ///< Index of the triangle, -1 if nothing was hit.
+		double t = 0.0; ///< Distance along the ray in units of the direction vector
+		Vector3 p; ///< Point of intersection
+	};
+
+	BVH() = default;
+	BVH(const std::vector<Geometry::Vertex> &v,
+			const std::vector<Geometry::Triangle> &t);
+
+	void Build(const std::vector<Geometry::Vertex> &v,
+			const std::vector<Geometry::Triangle> &t);
+
+	size_t CountTriangles() const;
+	size_t GetMemoryUsage() const;
+
+	/**\brief Nearest intersection of a ray with the triangles
+	 *
+	 * Only intersections with 0 <= t are reported.
+	 *
+	 * \param p0 Start of the ray
+	 * \param dir Direction of the ray, need not be normalized.
+	 * \param facing +1: Only triangles facing in the direction of the ray
+	 *               (i.e. the ray leaves the object), -1: only triangles
+	 *               facing against the ray, 0: all triangles.
+	 * \return Hit::triangle is -1, if nothing was hit.
+	 */
+	Hit IntersectRay(const std::vector<Geometry::Vertex> &v,
+			const std::vector<Geometry::Triangle> &t, const Vector3 &p0,
+			const Vector3 &dir, int facing = 0) const;
+
+	/**\brief Triangles, that may touch a slab between two parallel planes
+	 *
+	 * Returns all triangles with a vertex range along n overlapping
+	 * [dmin, dmax]. The indices are sorted.
+	 */
+	std::vector<size_t> FindInSlab(const std::vector<Geometry::Vertex> &v,
+			const std::vector<Geometry::Triangle> &t, const Vector3 &n,
+			double dmin, double dmax) const;
+
+	/**\brief Point on the triangles closest to p
+	 *
+	 * \return Hit::t is the distance to p.
+	 */
+	Hit ClosestPoint(const std::vector<Geometry::Vertex> &v,
+			const std::vector<Geometry::Triangle> &t, const Vector3 &p) const;
+
+private:
+	struct Node {
+		Vector3 min;
+		Vector3 max;
+		size_t first = 0; ///< Leaf: first index in idx, Node: index of the left child
+		size_t count = 0; ///< Leaf: number of triangles, Node: 0
+	};
+
+	std::vector<Node> nodes;
+	std::vector<size_t> idx;
+};
+
+#endif /* L3D_BVH_H */
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : BVH_test.cpp
+// Purpose            : Queries of the BVH against a search over all triangles
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "BVH.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Geometry.h"
+#include "Polygon3.h"
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+class BVHTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( BVHTest );
+	CPPUNIT_TEST(testIntersectRay);
+	CPPUNIT_TEST(testFindInSlab);
+	CPPUNIT_TEST(testClosestPoint);
+	CPPUNIT_TEST(testGeometry);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief Closed, bumpy sphere with the normals pointing outwards
+	 */
+	static Geometry Sphere(size_t N) {
+		Geometry geo;
+		geo.SetEpsilon(1e-9);
+		auto P = [N](size_t i, size_t j) {
+			const double phi = M_PI * (double) i / (double) N;
+			const double theta = 2.0 * M_PI * (double) j / (double) (2 * N);
+			const double r = 1.0 + 0.1 * std::sin(5.0 * theta) * std::sin(phi);
+			return Geometry::Vertex(r * std::sin(phi) * std::cos(theta),
+					r * std::sin(phi) * std::sin(theta), r * std::cos(phi));
+		};
+		for (size_t i = 0; i < N; i++)
+			for (size_t j = 0; j < 2 * N; j++) {
+				if (i > 0)
+					geo.AddTriangle(P(i, j), P(i + 1, j), P(i, j + 1));
+				if (i + 1 < N)
+					geo.AddTriangle(P(i + 1, j), P(i + 1, j + 1), P(i, j + 1));
+			}
+		geo.Join();
+		geo.CalculateNormals();
+		return geo;
+	}
+
+	static std::vector<Geometry::Vertex> Vertices(const Geometry &geo) {
+		std::vector<Geometry::Vertex> v;
+		for (size_t i = 0; i < geo.CountVertices(); i++)
+			v.push_back(geo.GetVertex(i));
+		return v;
+	}
+
+	static std::vector<Geometry::Triangle> Triangles(const Geometry &geo) {
+		std::vector<Geometry::Triangle> t;
+		for (size_t i = 0; i < geo.CountTriangles(); i++)
+			t.push_back(geo.GetTriangle(i));
+		return t;
+	}
+
+	void testIntersectRay() {
+		const Geometry geo = Sphere(40);
+		const auto v = Vertices(geo);
+		const auto t = Triangles(geo);
+		const BVH bvh(v, t);
+		std::mt19937 gen { 1234 };
+		std::uniform_real_distribution<double> dist { -1.5, 1.5 };
+		for (size_t n = 0; n < 200; n++) {
+			const Vector3 p0(dist(gen), dist(gen), dist(gen));
+			const Vector3 dir(dist(gen), dist(gen), dist(gen));
+			for (int facing = -1; facing <= 1; facing++) {
+				const BVH::Hit hit = bvh.IntersectRay(v, t, p0, dir, facing);
+				// Search all triangles.
+				double tmin = DBL_MAX;
+				for (size_t i = 0; i < t.size(); i++) {
+					const Vector3 a = v[t[i].GetVertexIndex(0)];
+					const Vector3 b = v[t[i].GetVertexIndex(1)];
+					const Vector3 c = v[t[i].GetVertexIndex(2)];
+					const Vector3 nt = (b - a) * (c - a);
+					const double den = nt.Dot(dir);
+					if (facing * den < 0.0 || den == 0.0)
+						continue;
+					const double x = nt.Dot(a - p0) / den;
+					if (x < 0.0)
+						continue;
+					const Vector3 p = p0 + dir * x;
+					if (((b - a) * (p - a)).Dot(nt) < 0.0
+							|| ((c - b) * (p - b)).Dot(nt) < 0.0
+							|| ((a - c) * (p - c)).Dot(nt) < 0.0)
+						continue;
+					tmin = std::fmin(tmin, x);
+				}
+				if (tmin == DBL_MAX) {
+					CPPUNIT_ASSERT_EQUAL((size_t) -1, hit.triangle);
+				} else {
+					CPPUNIT_ASSERT(hit.triangle != (size_t) -1);
+					CPPUNIT_ASSERT_DOUBLES_EQUAL(tmin, hit.t, 1e-9);
+				}
+			}
+		}
+	}
+
+	void testFindInSlab() {
+		const Geometry geo = Sphere(40);
+		const auto v = Vertices(geo);
+		const auto t = Triangles(geo);
+		const BVH bvh(v, t);
+		const Vector3 n = Vector3(0.3, -0.2, 0.9).Normal();
+		for (double d = -1.2; d < 1.2; d += 0.05) {
+			std::vector<size_t> expected;
+			for (size_t i = 0; i < t.size(); i++) {
+				const double da = v[t[i].va].Dot(n);
+				const double db = v[t[i].vb].Dot(n);
+				const double dc = v[t[i].vc].Dot(n);
+				if (std::fmax(da, std::fmax(db, dc)) >= d - 0.01
+						&& std::fmin(da, std::fmin(db, dc)) <= d + 0.01)
+					expected.push_back(i);
+			}
+			const std::vector<size_t> found = bvh.FindInSlab(v, t, n, d - 0.01,
+					d + 0.01);
+			CPPUNIT_ASSERT(expected == found);
+		}
+	}
+
+	void testClosestPoint() {
+		const Geometry geo = Sphere(30);
+		const auto v = Vertices(geo);
+		const auto t = Triangles(geo);
+		const BVH bvh(v, t);
+		std::mt19937 gen { 4321 };
+		std::uniform_real_distribution<double> dist { -2.0, 2.0 };
+		for (size_t n = 0; n < 100; n++) {
+			const Vector3 p(dist(gen), dist(gen), dist(gen));
+			const BVH::Hit hit = bvh.ClosestPoint(v, t, p);
+			CPPUNIT_ASSERT(hit.triangle < t.size());
+			CPPUNIT_ASSERT_DOUBLES_EQUAL((hit.p - p).Abs(), hit.t, 1e-12);
+			// No vertex may be closer than the point found.
+			for (const Vector3 &vert : v)
+				CPPUNIT_ASSERT(hit.t <= (vert - p).Abs() + 1e-12);
+		}
+	}
+
+	void testGeometry() {
+		Geometry geo = Sphere(40);
+		// The outer side of the sphere faces upwards.
+		const Vector3 top = geo.IntersectArrow( { 0.1, 0.2, 0.0 },
+				{ 0.0, 0.0, 1.0 });
+		const Vector3 bottom = geo.IntersectArrow( { 0.1, 0.2, 0.0 },
+				{ 0.0, 0.0, -1.0 });
+		CPPUNIT_ASSERT(top.z > 0.9);
+		CPPUNIT_ASSERT(bottom.z < -0.9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, top.x, 1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, bottom.y, 1e-12);
+		// From outside the nearest exit face is behind the start point.
+		const Vector3 behind = geo.IntersectArrow( { 0.1, 0.2, 3.0 },
+				{ 0.0, 0.0, -1.0 });
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(bottom.z, behind.z, 1e-12);
+
+		// Every triangle crossing the plane adds one edge.
+		const Polygon3 cut = geo.IntersectPlane( { 0.0, 0.0, 1.0 }, 0.25);
+		size_t crossing = 0;
+		for (size_t i = 0; i < geo.CountTriangles(); i++) {
+			const Geometry::Triangle &tri = geo.GetTriangle(i);
+			const double za = geo.GetVertex(tri.va).z;
+			const double zb = geo.GetVertex(tri.vb).z;
+			const double zc = geo.GetVertex(tri.vc).z;
+			if (std::fmin(za, std::fmin(zb, zc)) < 0.25
+					&& std::fmax(za, std::fmax(zb, zc)) > 0.25)
+				crossing++;
+		}
+		CPPUNIT_ASSERT_EQUAL(crossing, cut.CountEdges());
+		for (size_t i = 0; i < cut.CountVertices(); i++)
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, cut.GetVertex(i).z, 1e-12);
+
+		// Modifying the geometry replaces the tree.
+		const auto tree = geo.GetBVH();
+		geo.Transform(AffineTransformMatrix::Translation(0.0, 0.0, 1.0));
+		CPPUNIT_ASSERT(tree != geo.GetBVH());
+		const Vector3 top2 = geo.IntersectArrow( { 0.1, 0.2, 1.0 },
+				{ 0.0, 0.0, 1.0 });
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(top.z + 1.0, top2.z, 1e-12);
+
+		// The non-const access alone keeps the tree. Moving a vertex through
+		// it needs InvalidateCache().
+		const auto tree2 = geo.GetBVH();
+		Geometry::Vertex &vert = geo.GetVertex(0);
+		geo.GetTriangle(0);
+		CPPUNIT_ASSERT(tree2 == geo.GetBVH());
+		vert.z += 1.0;
+		geo.InvalidateCache();
+		CPPUNIT_ASSERT(tree2 != geo.GetBVH());
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BVHTest);
+#endif
@@ -0,0 +1,508 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : DistanceField.cpp
+// Purpose            : Signed distance field on a regular grid
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DistanceField.h"
+
+#include "../system/Cancellation.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+void DistanceField::SetGrid(const Vector3 &min, const Vector3 &max,
+		double resolution) {
+	if (resolution <= 0.0) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The resolution has to be positive.";
+		throw std::runtime_error(err.str());
+	}
+	const size_t Nx = (size_t) std::max(ceil((max.x - min.x) / resolution), 0.0)
+			+ 1;
+	const size_t Ny = (size_t) std::max(ceil((max.y - min.y) / resolution), 0.0)
+			+ 1;
+	const size_t Nz = (size_t) std::max(ceil((max.z - min.z) / resolution), 0.0)
+			+ 1;
+	SetSize(Nx, Ny, Nz, resolution);
+	SetOrigin(min);
+	std::fill(begin(), end(), maxDistance);
+	surface = 0.0;
+	geometry.Clear();
+}
+
+/*!\brief Closest point on the triangle abc to p
+ *
+ * From: Christer Ericson, "Real-Time Collision Detection", chapter 5.1.5
+ */
+static Vector3 ClosestPoint(const Vector3 &p, const Vector3 &a,
+		const Vector3 &b, const Vector3 &c) {
+	const Vector3 ab = b - a;
+	const Vector3 ac = c - a;
+	const Vector3 ap = p - a;
+	const double d1 = ab.Dot(ap);
+	const double d2 = ac.Dot(ap);
+	if (d1 <= 0.0 && d2 <= 0.0)
+		return a;
+	const Vector3 bp = p - b;
+	const double d3 = ab.Dot(bp);
+	const double d4 = ac.Dot(bp);
+	if (d3 >= 0.0 && d4 <= d3)
+		return b;
+	const double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+		return a + ab * (d1 / (d1 - d3));
+	const Vector3 cp = p - c;
+	const double d5 = ab.Dot(cp);
+	const double d6 = ac.Dot(cp);
+	if (d6 >= 0.0 && d5 <= d6)
+		return c;
+	const double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+		return a + ac * (d2 / (d2 - d6));
+	const double va = d3 * d6 - d5 * d4;
+	if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	const double denom = 1.0 / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+void DistanceField::FromGeometry(const Geometry &geometry) {
+	const size_t Nx = Size(0);
+	const size_t Ny = Size(1);
+	const size_t Nz = Size(2);
+	const size_t L = Nx * Ny;
+	const double h = dx;
+	const double band = 2.0 * h;
+
+	std::vector<double> d(Numel(), maxDistance);
+	std::vector<uint8_t> frozen(Numel(), 0);
+	// Crossings of the mesh with the rays in +Z through the voxel columns: a
+	// crossing between voxel k - 1 and voxel k toggles entry k of the column.
+	std::vector<uint8_t> toggle(L * (Nz + 1), 0);
+
+	// First and last voxel index in [lo, hi] along an axis of N voxels
+	auto First = [&](double lo, size_t N) {
+		return (int64_t) std::min(std::max(ceil(lo / h), 0.0), (double) N);
+	};
+	auto Last = [&](double hi, size_t N) {
+		return (int64_t) std::min(std::max(floor(hi / h), -1.0),
+				(double) N - 1.0);
+	};
+	for (size_t n = 0; n < geometry.CountTriangles(); n++) {
+		if ((n & 0xFF) == 0)
+			Cancellation::Check();
+		const Vector3 a = geometry.GetTriangleVertex(n, 0) - origin;
+		const Vector3 b = geometry.GetTriangleVertex(n, 1) - origin;
+		const Vector3 c = geometry.GetTriangleVertex(n, 2) - origin;
+
+		// Exact distances in a band around the triangle
+		Vector3 normal = (b - a) * (c - a);
+		const double area = normal.Abs();
+		if (area > 0.0)
+			normal /= area;
+		const int64_t i0 = First(std::min( { a.x, b.x, c.x }) - band, Nx);
+		const int64_t i1 = Last(std::max( { a.x, b.x, c.x }) + band, Nx);
+		const int64_t j0 = First(std::min( { a.y, b.y, c.y }) - band, Ny);
+		const int64_t j1 = Last(std::max( { a.y, b.y, c.y }) + band, Ny);
+		const int64_t k0 = First(std::min( { a.z, b.z, c.z }) - band, Nz);
+		const int64_t k1 = Last(std::max( { a.z, b.z, c.z }) + band, Nz);
+		for (int64_t k = k0; k <= k1; k++)
+			for (int64_t j = j0; j <= j1; j++)
+				for (int64_t i = i0; i <= i1; i++) {
+					const Vector3 p(i * h, j * h, k * h);
+					if (area > 0.0 && fabs(normal.Dot(p - a)) >= band)
+						continue;
+					const double dist = (ClosestPoint(p, a, b, c) - p).Abs();
+					const size_t idx = i + Nx * (j + Ny * k);
+					if (dist < d[idx])
+						d[idx] = dist;
+				}
+
+		// Columns, whose center is inside of the projection of the triangle.
+		// The rays are shifted by an odd fraction of a cell, so that they do
+		// not pass through the vertices of meshes aligned to the grid. The
+		// edges are assigned to one side only, so that a ray through an edge
+		// shared by two triangles is still counted once.
+		double det = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (det == 0.0)
+			continue;
+		const Vector3 &p0 = a;
+		const Vector3 &p1 = (det > 0.0) ? b : c;
+		const Vector3 &p2 = (det > 0.0) ? c : b;
+		det = fabs(det);
+		auto Inside = [](const Vector3 &s, const Vector3 &e, double x,
+				double y, double &w) {
+			const double ex = e.x - s.x;
+			const double ey = e.y - s.y;
+			w = ex * (y - s.y) - ey * (x - s.x);
+			return w > 0.0 || (w == 0.0 && (ey > 0.0 || (ey == 0.0 && ex < 0.0)));
+		};
+		const int64_t ci0 = First(std::min( { a.x, b.x, c.x }) - h, Nx);
+		const int64_t ci1 = Last(std::max( { a.x, b.x, c.x }), Nx);
+		const int64_t cj0 = First(std::min( { a.y, b.y, c.y }) - h, Ny);
+		const int64_t cj1 = Last(std::max( { a.y, b.y, c.y }), Ny);
+		for (int64_t j = cj0; j <= cj1; j++)
+			for (int64_t i = ci0; i <= ci1; i++) {
+				const double x = (i + 1.3e-4) * h;
+				const double y = (j + 1.7e-4) * h;
+				double w0, w1, w2;
+				if (!Inside(p1, p2, x, y, w0) || !Inside(p2, p0, x, y, w1)
+						|| !Inside(p0, p1, x, y, w2))
+					continue;
+				const double z = (w0 * p0.z + w1 * p1.z + w2 * p2.z) / det;
+				const double kc = std::min(std::max(ceil(z / h), 0.0),
+						(double) Nz);
+				toggle[(i + Nx * j) * (Nz + 1) + (size_t) kc] ^= 1;
+			}
+	}
+
+	std::vector<uint8_t> inside(Numel(), 0);
+	for (size_t col = 0; col < L; col++) {
+		uint8_t p = 0;
+		for (size_t k = Nz; k-- > 0;) {
+			p ^= toggle[col * (Nz + 1) + k + 1];
+			inside[col + L * k] = p;
+		}
+	}
+	toggle.clear();
+	toggle.shrink_to_fit();
+
+	// The voxels near the mesh are fixed. Voxels at a change of the sign
+	// without a triangle nearby (below the border of an open mesh) are put
+	// halfway to the surface.
+	for (size_t k = 0; k < Nz; k++)
+		for (size_t j = 0; j < Ny; j++)
+			for (size_t i = 0; i < Nx; i++) {
+				const size_t idx = i + Nx * (j + Ny * k);
+				if (d[idx] <= band) {
+					frozen[idx] = 1;
+					continue;
+				}
+				const uint8_t s = inside[idx];
+				if ((i > 0 && inside[idx - 1] != s)
+						|| (i + 1 < Nx && inside[idx + 1] != s)
+						|| (j > 0 && inside[idx - Nx] != s)
+						|| (j + 1 < Ny && inside[idx + Nx] != s)
+						|| (k > 0 && inside[idx - L] != s)
+						|| (k + 1 < Nz && inside[idx + L] != s)) {
+					d[idx] = std::min(d[idx], 0.5 * h);
+					frozen[idx] = 1;
+				}
+			}
+
+	Sweep(d, frozen);
+	for (size_t idx = 0; idx < Numel(); idx++)
+		operator[](idx) = inside[idx] ? -d[idx] : d[idx];
+}
+
+void DistanceField::Apply(Operation op,
+		const std::function<double(const Vector3&)> &f) {
+	const size_t Nx = Size(0);
+	const size_t Ny = Size(1);
+	const size_t Nz = Size(2);
+	const double h = dx;
+	double *v = data();
+
+	// Voxels, where the function can change the result
+	auto Needed = [&](size_t idx) {
+		if (op == Operation::Union)
+			return v[idx] > -maxDistance;
+		return v[idx] < maxDistance;
+	};
+
+	// 0: not sampled, 1: interpolated, 2: evaluated
+	std::vector<uint8_t> state(Numel(), 0);
+	std::vector<double> g(Numel(), 0.0);
+	auto Eval = [&](size_t i, size_t j, size_t k) {
+		const size_t idx = i + Nx * (j + Ny * k);
+		if (state[idx] != 2) {
+			g[idx] = f(origin + Vector3(i * h, j * h, k * h));
+			state[idx] = 2;
+		}
+		return g[idx];
+	};
+
+	// Blocks of voxels [i0, i1] x [j0, j1] x [k0, k1]. The function changes at
+	// most by the distance from a corner. If its values at the corners are
+	// further from 0 than from every voxel to the nearest corner plus one
+	// cell, no edge of the grid in the block is crossed by the surface and
+	// the block is interpolated.
+	std::function<void(size_t, size_t, size_t, size_t, size_t, size_t)> Refine =
+			[&](size_t i0, size_t i1, size_t j0, size_t j1, size_t k0,
+					size_t k1) {
+				bool needed = false;
+				for (size_t k = k0; k <= k1 && !needed; k++)
+					for (size_t j = j0; j <= j1 && !needed; j++)
+						for (size_t i = i0; i <= i1 && !needed; i++)
+							needed = Needed(i + Nx * (j + Ny * k));
+				if (!needed)
+					return;
+				const double c[8] = { Eval(i0, j0, k0), Eval(i1, j0, k0), Eval(
+						i0, j1, k0), Eval(i1, j1, k0), Eval(i0, j0, k1), Eval(i1,
+						j0, k1), Eval(i0, j1, k1), Eval(i1, j1, k1) };
+				const size_t si = i1 - i0;
+				const size_t sj = j1 - j0;
+				const size_t sk = k1 - k0;
+				if (si <= 1 && sj <= 1 && sk <= 1) {
+					for (size_t k = k0; k <= k1; k++)
+						for (size_t j = j0; j <= j1; j++)
+							for (size_t i = i0; i <= i1; i++)
+								Eval(i, j, k);
+					return;
+				}
+				const double reach = h
+						* (0.5 * sqrt((double) (si * si + sj * sj + sk * sk))
+								+ 1.0);
+				bool far = true;
+				for (uint_fast8_t n = 0; n < 8 && far; n++)
+					far = fabs(c[n]) > reach && (c[n] > 0.0) == (c[0] > 0.0);
+				if (far) {
+					for (size_t k = k0; k <= k1; k++) {
+						const double mz = (sk > 0) ? (double) (k - k0) / sk : 0.0;
+						for (size_t j = j0; j <= j1; j++) {
+							const double my =
+									(sj > 0) ? (double) (j - j0) / sj : 0.0;
+							for (size_t i = i0; i <= i1; i++) {
+								const size_t idx = i + Nx * (j + Ny * k);
+								if (state[idx] != 0)
+									continue;
+								const double mx =
+										(si > 0) ? (double) (i - i0) / si : 0.0;
+								g[idx] = c[0] * (1 - mx) * (1 - my) * (1 - mz)
+										+ c[1] * mx * (1 - my) * (1 - mz)
+										+ c[2] * (1 - mx) * my * (1 - mz)
+										+ c[3] * mx * my * (1 - mz)
+										+ c[4] * (1 - mx) * (1 - my) * mz
+										+ c[5] * mx * (1 - my) * mz
+										+ c[6] * (1 - mx) * my * mz
+										+ c[7] * mx * my * mz;
+								state[idx] = 1;
+							}
+						}
+					}
+					return;
+				}
+				const size_t im = i0 + si / 2;
+				const size_t jm = j0 + sj / 2;
+				const size_t km = k0 + sk / 2;
+				for (uint_fast8_t n = 0; n < 8; n++) {
+					if (((n & 1) && si <= 1) || ((n & 2) && sj <= 1)
+							|| ((n & 4) && sk <= 1))
+						continue;
+					Refine((n & 1) ? im : i0, ((n & 1) || si <= 1) ? i1 : im,
+							(n & 2) ? jm : j0, ((n & 2) || sj <= 1) ? j1 : jm,
+							(n & 4) ? km : k0, ((n & 4) || sk <= 1) ? k1 : km);
+				}
+			};
+
+	const size_t B = 16;
+	for (size_t k = 0; k + 1 < std::max<size_t>(Nz, 2); k += B) {
+		Cancellation::Check();
+		for (size_t j = 0; j + 1 < std::max<size_t>(Ny, 2); j += B)
+			for (size_t i = 0; i + 1 < std::max<size_t>(Nx, 2); i += B)
+				Refine(i, std::min(i + B, Nx - 1), j, std::min(j + B, Ny - 1), k,
+						std::min(k + B, Nz - 1));
+	}
+
+	for (size_t idx = 0; idx < Numel(); idx++) {
+		if (state[idx] == 0 || !Needed(idx))
+			continue;
+		switch (op) {
+		case Operation::Union:
+			v[idx] = std::min(v[idx], g[idx]);
+			break;
+		case Operation::Intersection:
+			v[idx] = std::max(v[idx], g[idx]);
+			break;
+		case Operation::Difference:
+			v[idx] = std::max(v[idx], -g[idx]);
+			break;
+		}
+	}
+}
+
+void DistanceField::Apply(Operation op, const DistanceField &other) {
+	CheckGrid(other);
+	double *v = data();
+	const double *w = other.data();
+	const size_t N = Numel();
+	switch (op) {
+	case Operation::Union:
+		for (size_t idx = 0; idx < N; idx++)
+			v[idx] = std::min(v[idx], w[idx]);
+		break;
+	case Operation::Intersection:
+		for (size_t idx = 0; idx < N; idx++)
+			v[idx] = std::max(v[idx], w[idx]);
+		break;
+	case Operation::Difference:
+		for (size_t idx = 0; idx < N; idx++)
+			v[idx] = std::max(v[idx], -w[idx]);
+		break;
+	}
+}
+
+void DistanceField::Offset(double distance) {
+	for (double &value : *this)
+		value -= distance;
+}
+
+void DistanceField::Redistance() {
+	const size_t Nx = Size(0);
+	const size_t Ny = Size(1);
+	const size_t Nz = Size(2);
+	const size_t L = Nx * Ny;
+	const double h = dx;
+	const double *v = data();
+
+	std::vector<double> d(Numel(), maxDistance);
+	std::vector<uint8_t> frozen(Numel(), 0);
+	for (size_t k = 0; k < Nz; k++)
+		for (size_t j = 0; j < Ny; j++)
+			for (size_t i = 0; i < Nx; i++) {
+				const size_t idx = i + Nx * (j + Ny * k);
+				const bool in = v[idx] <= 0.0;
+				auto Cross = [&](size_t other) {
+					if ((v[other] <= 0.0) == in)
+						return;
+					const double a = fabs(v[idx]);
+					const double b = fabs(v[other]);
+					d[idx] = std::min(d[idx], h * a / (a + b));
+					frozen[idx] = 1;
+				};
+				if (i > 0)
+					Cross(idx - 1);
+				if (i + 1 < Nx)
+					Cross(idx + 1);
+				if (j > 0)
+					Cross(idx - Nx);
+				if (j + 1 < Ny)
+					Cross(idx + Nx);
+				if (k > 0)
+					Cross(idx - L);
+				if (k + 1 < Nz)
+					Cross(idx + L);
+			}
+	Sweep(d, frozen);
+	for (size_t idx = 0; idx < Numel(); idx++)
+		operator[](idx) = (v[idx] <= 0.0) ? -d[idx] : d[idx];
+}
+
+BoundingBox DistanceField::GetBoundingBox(double distance) const {
+	const size_t Nx = Size(0);
+	const size_t Ny = Size(1);
+	const size_t Nz = Size(2);
+	const double h = dx;
+	BoundingBox bb;
+	for (size_t k = 0; k < Nz; k++)
+		for (size_t j = 0; j < Ny; j++)
+			for (size_t i = 0; i < Nx; i++)
+				if (operator[](i + Nx * (j + Ny * k)) < distance)
+					bb.Insert(origin + Vector3(i * h, j * h, k * h));
+	return bb;
+}
+
+void DistanceField::CalcSurface(unsigned int threads) {
+	surface = 0.0;
+	Volume::CalcSurface(threads);
+	geometry.FlipInsideOutside();
+}
+
+void DistanceField::Sweep(std::vector<double> &d,
+		const std::vector<uint8_t> &frozen) const {
+	const size_t Nx = Size(0);
+	const size_t Ny = Size(1);
+	const size_t Nz = Size(2);
+	const size_t L = Nx * Ny;
+	const double h = dx;
+	const double h2 = h * h;
+
+	// Gauss-Seidel iterations in the 8 diagonal directions of the grid
+	for (uint_fast8_t dir = 0; dir < 8; dir++) {
+		Cancellation::Check();
+		for (size_t kk = 0; kk < Nz; kk++) {
+			const size_t k = (dir & 4) ? (Nz - 1 - kk) : kk;
+			for (size_t jj = 0; jj < Ny; jj++) {
+				const size_t j = (dir & 2) ? (Ny - 1 - jj) : jj;
+				for (size_t ii = 0; ii < Nx; ii++) {
+					const size_t i = (dir & 1) ? (Nx - 1 - ii) : ii;
+					const size_t idx = i + Nx * (j + Ny * k);
+					if (frozen[idx])
+						continue;
+					double a = DBL_MAX;
+					double b = DBL_MAX;
+					double c = DBL_MAX;
+					if (i > 0)
+						a = d[idx - 1];
+					if (i + 1 < Nx)
+						a = std::min(a, d[idx + 1]);
+					if (j > 0)
+						b = d[idx - Nx];
+					if (j + 1 < Ny)
+						b = std::min(b, d[idx + Nx]);
+					if (k > 0)
+						c = d[idx - L];
+					if (k + 1 < Nz)
+						c = std::min(c, d[idx + L]);
+					// The update is always larger than the smallest neighbor.
+					if (a >= d[idx] && b >= d[idx] && c >= d[idx])
+						continue;
+					if (a > b)
+						std::swap(a, b);
+					if (b > c)
+						std::swap(b, c);
+					if (a > b)
+						std::swap(a, b);
+					double u = a + h;
+					if (u > b) {
+						u = 0.5 * (a + b + sqrt(2.0 * h2 - (a - b) * (a - b)));
+						if (u > c) {
+							const double s = a + b + c;
+							const double q = s * s
+									- 3.0 * (a * a + b * b + c * c - h2);
+							u = (s + sqrt(std::max(q, 0.0))) / 3.0;
+						}
+					}
+					if (u < d[idx])
+						d[idx] = u;
+				}
+			}
+		}
+	}
+}
+
+void DistanceField::CheckGrid(const DistanceField &other) const {
+	if (Size(0) != other.Size(0) || Size(1) != other.Size(1)
+			|| Size(2) != other.Size(2) || dx != other.dx
+			|| origin != other.origin) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The fields are not on the same grid.";
+		throw std::runtime_error(err.str());
+	}
+}
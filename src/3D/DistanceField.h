@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : DistanceField.h
+// Purpose            : Signed distance field on a regular grid
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_DISTANCEFIELD_H
+#define L3D_DISTANCEFIELD_H
+
+/** \class DistanceField
+ * 	\code #include "DistanceField.h"\endcode
+ * 	\ingroup Base3D
+ *  \brief Signed distance field on a regular grid
+ *
+ * Every voxel stores the distance to the surface of a solid. Values are
+ * negative inside and positive outside of the solid. (This is the opposite
+ * of the morph-objects of the Volume, where greater values are inside.)
+ *
+ * A field is generated from a mesh (FromGeometry()) or from a function
+ * (Apply()) and modified by the CSG operations. CalcSurface() extracts the
+ * surface with the marching cubes of the Volume.
+ *
+ * Far from the surface the values are only bounds: they have the correct sign
+ * and their magnitude is at least maxDistance. Redistance() restores the
+ * distances near the surface after CSG operations, e.g. before an Offset().
+ *
+ * The voxels are cubes, i.e. dx == dy == dz.
+ */
+
+#include "BoundingBox.h"
+#include "Geometry.h"
+#include "Vector3.h"
+#include "Volume.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class DistanceField: public Volume {
+public:
+	enum class Operation {
+		Union, ///< Solid of this field or of the other one
+		Intersection, ///< Solid of this field and of the other one
+		Difference ///< Solid of this field, with the other one removed
+	};
+
+public:
+	DistanceField() = default;
+	virtual ~DistanceField() = default;
+
+	/** \brief Set up a grid covering a box
+	 *
+	 * The grid starts at min and covers max. All voxels are set to
+	 * maxDistance, i.e. the field is empty.
+	 */
+	void SetGrid(const Vector3 &min, const Vector3 &max, double resolution);
+
+	/** \brief Distance to the surface of a mesh
+	 *
+	 * The voxels within two cells of a triangle get the exact distance to the
+	 * mesh. The sign is found by counting the crossings of the mesh along a
+	 * ray in +Z. Thus a closed mesh gives its inside and an open mesh (e.g.
+	 * an insole) the column below of it. The remaining distances are
+	 * calculated by fast sweeping.
+	 */
+	void FromGeometry(const Geometry &geometry);
+
+	/** \brief Combine the field with a function
+	 *
+	 * The function is only evaluated, where it can change the result. It is
+	 * sampled coarse to fine: blocks, where the values at the corners prove
+	 * that the surface does not pass through, are interpolated. For this the
+	 * function has to be a signed distance (or a bound of it) with a gradient
+	 * of at most 1.
+	 *
+	 * \param op Operation, the function is the other solid
+	 * \param f Signed distance function of a point in global coordinates
+	 */
+	void Apply(Operation op, const std::function<double(const Vector3&)> &f);
+
+	/** \brief Combine the field with another field on the same grid
+	 */
+	void Apply(Operation op, const DistanceField &other);
+
+	/** \brief Grow (distance > 0) or shrink (distance < 0) the solid
+	 */
+	void Offset(double distance);
+
+	/** \brief Recalculate the distances from the surface by fast sweeping
+	 *
+	 * The distance of the voxels next to the surface is estimated from the
+	 * linear interpolation of the values. All others are the solution of the
+	 * Eikonal equation |grad(d)| = 1 found by fast sweeping (Zhao 2004).
+	 */
+	void Redistance();
+
+	/** \brief Bounding box of the solid grown by a distance
+	 *
+	 * Box of the voxels with values below the distance, in global
+	 * coordinates. Empty, if there are none.
+	 */
+	BoundingBox GetBoundingBox(double distance = 0.0) const;
+
+	/** \brief Extract the surface at 0
+	 *
+	 * Runs Volume::CalcSurface() and flips the triangles, so that the normals
+	 * point out of the solid. The Geometry is in the local coordinates of the
+	 * grid, like the one of the Volume.
+	 */
+	void CalcSurface(unsigned int threads = 0);
+
+public:
+	double maxDistance = 0.01; ///< Distances are calculated up to this value.
+
+private:
+	/// Fast sweeping of the unsigned distances, frozen voxels are kept.
+	void Sweep(std::vector<double> &d, const std::vector<uint8_t> &frozen) const;
+	void CheckGrid(const DistanceField &other) const;
+};
+
+#endif /* L3D_DISTANCEFIELD_H */
@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : DistanceField_test.cpp
+// Purpose            : Distances, CSG and the construction of a heel
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "DistanceField.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "../system/StopWatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+class DistanceFieldTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( DistanceFieldTest );
+	CPPUNIT_TEST(testFromGeometry);
+	CPPUNIT_TEST(testOperations);
+	CPPUNIT_TEST(testHeel);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	static Geometry Sphere(const Vector3 &center, double r) {
+		Geometry geo;
+		const size_t N = 48;
+		auto P = [&](size_t i, size_t j) {
+			const double u = 2.0 * M_PI * (double) i / N;
+			const double v = M_PI * (double) j / N;
+			return Geometry::Vertex(
+					center
+							+ Vector3(cos(u) * sin(v), sin(u) * sin(v), cos(v))
+									* r);
+		};
+		for (size_t j = 0; j < N; j++)
+			for (size_t i = 0; i < N; i++) {
+				geo.AddTriangle(P(i, j), P(i, j + 1), P(i + 1, j + 1));
+				geo.AddTriangle(P(i, j), P(i + 1, j + 1), P(i + 1, j));
+			}
+		return geo;
+	}
+
+	/**\brief Open surface of an insole, 0.05 m high at the heel
+	 */
+	static Geometry Insole() {
+		Geometry geo;
+		const double h = 0.005;
+		auto Z = [](double x) {
+			if (x < 0.08)
+				return 0.05;
+			if (x > 0.17)
+				return 0.005;
+			return 0.005 + 0.045 * (0.5 + 0.5 * cos(M_PI * (x - 0.08) / 0.09));
+		};
+		for (double x = 0.0; x < 0.26 - h / 2; x += h)
+			for (double y = -0.05; y < 0.05 - h / 2; y += h) {
+				const double cx = (x + h / 2 - 0.13) / 0.13;
+				const double cy = (y + h / 2) / 0.05;
+				if (pow(cx, 4) + pow(cy, 4) > 1.0)
+					continue;
+				const Geometry::Vertex a(x, y, Z(x));
+				const Geometry::Vertex b(x + h, y, Z(x + h));
+				const Geometry::Vertex c(x + h, y + h, Z(x + h));
+				const Geometry::Vertex d(x, y + h, Z(x));
+				geo.AddTriangle(a, b, c);
+				geo.AddTriangle(a, c, d);
+			}
+		return geo;
+	}
+
+	/**\brief Signed distance of a box
+	 */
+	static double Box(const Vector3 &p, const Vector3 &center,
+			const Vector3 &half) {
+		const Vector3 q(fabs(p.x - center.x) - half.x,
+				fabs(p.y - center.y) - half.y, fabs(p.z - center.z) - half.z);
+		const Vector3 o(std::max(q.x, 0.0), std::max(q.y, 0.0),
+				std::max(q.z, 0.0));
+		return o.Abs() + std::min(std::max( { q.x, q.y, q.z }), 0.0);
+	}
+
+	void testFromGeometry() {
+		const Vector3 center(0.01, -0.02, 0.03);
+		const double r = 0.02;
+		DistanceField field;
+		field.maxDistance = 0.1;
+		field.SetGrid(center - Vector3(0.03, 0.03, 0.03),
+				center + Vector3(0.03, 0.03, 0.03), 0.001);
+		field.FromGeometry(Sphere(center, r));
+		const size_t Nx = field.Size(0);
+		const size_t Ny = field.Size(1);
+		const size_t Nz = field.Size(2);
+		for (size_t k = 0; k < Nz; k++)
+			for (size_t j = 0; j < Ny; j++)
+				for (size_t i = 0; i < Nx; i++) {
+					const Vector3 p = field.origin
+							+ Vector3(i, j, k) * (double) field.dx;
+					const double d = (p - center).Abs() - r;
+					// Fast sweeping is of first order.
+					CPPUNIT_ASSERT_DOUBLES_EQUAL(d,
+							field[i + Nx * (j + Ny * k)], 2e-4 + 0.07 * fabs(d));
+				}
+	}
+
+	void testOperations() {
+		const Vector3 c1(0.0, 0.0, 0.0);
+		const Vector3 c2(0.015, 0.0, 0.0);
+		auto S1 = [&](const Vector3 &p) {
+			return (p - c1).Abs() - 0.02;
+		};
+		auto S2 = [&](const Vector3 &p) {
+			return (p - c2).Abs() - 0.01;
+		};
+		DistanceField field;
+		field.maxDistance = 0.005;
+		field.SetGrid(Vector3(-0.03, -0.03, -0.03), Vector3(0.03, 0.03, 0.03),
+				0.0005);
+		field.Apply(DistanceField::Operation::Union, S1);
+		field.Apply(DistanceField::Operation::Difference, S2);
+
+		// Near the surface all values are exact.
+		const size_t Nx = field.Size(0);
+		const size_t Ny = field.Size(1);
+		const size_t Nz = field.Size(2);
+		for (size_t k = 0; k < Nz; k++)
+			for (size_t j = 0; j < Ny; j++)
+				for (size_t i = 0; i < Nx; i++) {
+					const Vector3 p = field.origin
+							+ Vector3(i, j, k) * (double) field.dx;
+					const double d = std::max(S1(p), -S2(p));
+					const double v = field[i + Nx * (j + Ny * k)];
+					if (fabs(d) < 2.0 * field.dx)
+						CPPUNIT_ASSERT_DOUBLES_EQUAL(d, v, 1e-12);
+					else
+						CPPUNIT_ASSERT((d > 0.0) == (v > 0.0));
+				}
+
+		field.CalcSurface();
+		const double V0 = field.geometry.GetVolume();
+		// Large sphere without the lens shared with the small one
+		const double R = 0.02;
+		const double r = 0.01;
+		const double d = 0.015;
+		const double V = 4.0 / 3.0 * M_PI * R * R * R
+				- M_PI * (R + r - d) * (R + r - d)
+						* (d * d + 2 * d * r - 3 * r * r + 2 * d * R + 6 * r * R
+								- 3 * R * R) / (12 * d);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(V, V0, V * 0.01);
+
+		field.Redistance();
+		field.Offset(0.002);
+		field.CalcSurface();
+		CPPUNIT_ASSERT(field.geometry.GetVolume() > V0 * 1.2);
+		const BoundingBox bb = field.GetBoundingBox();
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.022, bb.xmin, field.dx);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.022, bb.zmax, field.dx);
+	}
+
+	void testHeel() {
+		// Block heel below an insole: first on a grid of 4 mm to find the
+		// heel, then on the box around it.
+		const Geometry insole = Insole();
+		const Vector3 center(0.04, 0.0, 0.0);
+		const Vector3 half(0.035, 0.03, 1.0);
+		size_t evaluations = 0;
+		auto Heel = [&](const Vector3 &p) {
+			evaluations++;
+			return Box(p, center, half);
+		};
+		auto Ground = [](const Vector3 &p) {
+			return -p.z;
+		};
+		for (double res : { 0.001, 0.0005 }) {
+			StopWatch sw;
+			sw.Start();
+			DistanceField coarse;
+			coarse.SetGrid(Vector3(-0.005, -0.055, -0.005),
+					Vector3(0.265, 0.055, 0.06), 0.004);
+			coarse.FromGeometry(insole);
+			coarse.Apply(DistanceField::Operation::Intersection, Ground);
+			coarse.Apply(DistanceField::Operation::Intersection, Heel);
+			const BoundingBox bb = coarse.GetBoundingBox(2.0 * coarse.dx);
+
+			evaluations = 0;
+			DistanceField field;
+			field.maxDistance = 4.0 * res;
+			field.SetGrid(Vector3(bb.xmin, bb.ymin, bb.zmin),
+					Vector3(bb.xmax, bb.ymax, bb.zmax), res);
+			field.FromGeometry(insole);
+			field.Apply(DistanceField::Operation::Intersection, Ground);
+			field.Apply(DistanceField::Operation::Intersection, Heel);
+			field.CalcSurface();
+			sw.Stop();
+
+			const double V = 0.07 * 0.06 * 0.05;
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(V, field.geometry.GetVolume(),
+					V * 0.02);
+			// The function is only evaluated near the surface of the heel.
+			CPPUNIT_ASSERT(evaluations < field.Numel() / 2);
+			std::cout << "\nHeel at " << res * 1000 << " mm: " << field.Numel()
+					<< " voxels, " << evaluations << " evaluations, "
+					<< field.geometry.CountTriangles() << " triangles in "
+					<< sw.GetSecondsWall() << " s";
+		}
+		std::cout << "\n";
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DistanceFieldTest);
+
+#endif
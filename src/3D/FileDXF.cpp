@@ -35,6 +35,14 @@ FileDXF::FileDXF(const std::string &filename_) :
 		FileGeometry(filename_) {
 }
 
+FileDXF::FileDXF(std::istream *stream) :
+		FileGeometry(stream) {
+}
+
+FileDXF::FileDXF(std::ostream *stream) :
+		FileGeometry(stream) {
+}
+
 void FileDXF::ReadStream(Geometry &geometry) {
 
 	state = StateType::idle;
@@ -56,6 +64,31 @@ void FileDXF::ReadStream(Geometry &geometry) {
 //	}
 }
 
+void FileDXF::WriteStream(const Geometry &geo) {
+	auto point = [this](int code, const Geometry::Vertex &v) {
+		*outp << code << '\n' << v.x << '\n';
+		*outp << (code + 10) << '\n' << v.y << '\n';
+		*outp << (code + 20) << '\n' << v.z << '\n';
+	};
+
+	const std::streamsize precision = outp->precision(10);
+	*outp << "0\nSECTION\n2\nENTITIES\n";
+	for (size_t idx = 0; idx < geo.CountEdges(); idx++) {
+		*outp << "0\nLINE\n8\n0\n";
+		point(10, geo.GetEdgeVertex(idx, 0));
+		point(11, geo.GetEdgeVertex(idx, 1));
+	}
+	for (size_t idx = 0; idx < geo.CountTriangles(); idx++) {
+		*outp << "0\n3DFACE\n8\n0\n";
+		point(10, geo.GetTriangleVertex(idx, 0));
+		point(11, geo.GetTriangleVertex(idx, 1));
+		point(12, geo.GetTriangleVertex(idx, 2));
+		point(13, geo.GetTriangleVertex(idx, 2)); // Triangle: 4th = 3rd corner
+	}
+	*outp << "0\nENDSEC\n0\nEOF\n";
+	outp->precision(precision);
+}
+
 void FileDXF::ProcessCode(int codeNr, const std::string &code, Geometry &geo) {
 
 	if (codeNr == 0 && !entityType.empty()) {
@@ -31,7 +31,11 @@
  * \ingroup File3D
  * \brief DXF file
  *
- * Class for reading in DXF files
+ * Class for reading and writing DXF files
+ *
+ * Only the ENTITIES section is written. Edges are written as LINE and
+ * triangles as 3DFACE entities. This is enough for cutting plotters and CAD
+ * programs to import outlines and patterns.
  *
  * https://images.autodesk.com/adsk/files/autocad_2012_pdf_dxf-reference_enu.pdf
  *
@@ -49,9 +53,11 @@ public:
 	FileDXF() = delete;
 	explicit FileDXF(const std::string &filename_);
 	explicit FileDXF(std::istream *stream);
+	explicit FileDXF(std::ostream *stream);
 	virtual ~FileDXF() = default;
 
 	virtual void ReadStream(Geometry &geometry) override;
+	virtual void WriteStream(const Geometry &geometry) override;
 
 private:
 	void ProcessCode(int codeNr, const std::string &code, Geometry &geometry);
@@ -47,6 +47,18 @@ FileGeometry::FileGeometry(std::ostream *stream) :
 }
 
 void FileGeometry::Read(Geometry &geometry) {
+	ReadInput([&]() {
+		ReadStream(geometry);
+	});
+}
+
+void FileGeometry::Read(FloatMesh &mesh) {
+	ReadInput([&]() {
+		ReadStreamFloat(mesh);
+	});
+}
+
+void FileGeometry::ReadInput(const std::function<void()> &readStream) {
 	if (filename.empty()) {
 		if (inp == nullptr)
 			throw std::logic_error(
@@ -55,7 +67,7 @@ void FileGeometry::Read(Geometry &geometry) {
 		if (!inp->good())
 			throw std::runtime_error(
 					std::string(__FUNCTION__) + "Input stream is not good.");
-		ReadStream(geometry);
+		readStream();
 	} else {
 		std::ifstream tempstream(filename);
 		if (!tempstream.is_open()) {
@@ -71,12 +83,24 @@ void FileGeometry::Read(Geometry &geometry) {
 							+ " for reading.");
 
 		inp = &tempstream;
-		ReadStream(geometry);
+		readStream();
 		inp = nullptr;
 		tempstream.close();
 	}
 }
 
+void FileGeometry::MapInput(MappedFile &file) {
+	if (filename.empty()) {
+		if (inp == nullptr)
+			throw std::logic_error(
+					std::string(__FUNCTION__)
+							+ " - Missing input stream. Check the construction of this object.");
+		file.Load(*inp);
+	} else {
+		file.Open(filename);
+	}
+}
+
 void FileGeometry::Write(const Geometry &geometry) {
 	if (filename.empty()) {
 		if (outp == nullptr)
@@ -125,6 +149,12 @@ void FileGeometry::WriteStream(const Geometry &geometry) {
 					+ " - Not implemented for this type of file.");
 }
 
+void FileGeometry::ReadStreamFloat(FloatMesh &mesh) {
+	Geometry temp;
+	ReadStream(temp);
+	mesh.Assign(temp);
+}
+
 std::string FileGeometry::StringTrim(const std::string &x) const {
 	const size_t pos0 = x.find_first_not_of(" \t\r\n");
 	const size_t pos1 = x.find_last_not_of(" \t\r\n");
@@ -52,9 +52,12 @@
  *
  */
 
+#include "FloatMesh.h"
 #include "Geometry.h"
+#include "MappedFile.h"
 #include "Vector3.h"
 
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -83,13 +86,30 @@ public:
 	void Read(Geometry &geometry);
 	void Write(const Geometry &geometry);
 
+	/**\brief Read into a single precision mesh
+	 *
+	 * Formats storing float coordinates (STL) are read without converting to
+	 * double. All other formats are read into a Geometry and copied.
+	 */
+	void Read(FloatMesh &mesh);
+
 	virtual void ReadStream(Geometry &geometry);
 	virtual void WriteStream(const Geometry &geometry);
+	virtual void ReadStreamFloat(FloatMesh &mesh);
 
 	size_t GeometriesInFile() const;
 
 protected:
 	std::string StringTrim(const std::string &x) const;
+	/// Open the file (if a filename was given) and call readStream.
+	void ReadInput(const std::function<void()> &readStream);
+
+	/**\brief Map the file or copy the stream into memory
+	 *
+	 * For the parsers working on a buffer (see TextScanner). A file given by
+	 * name is mapped from the start. Of a stream the rest is copied.
+	 */
+	void MapInput(MappedFile &file);
 
 	std::string filename; ///< Last file read / last file written to
 	std::istream *inp = nullptr;
@@ -26,25 +26,38 @@
 
 #include "FileOBJ.h"
 
+#include "MappedFile.h"
+#include "TextScanner.h"
+
+#include <charconv>
 #include <fstream>
 
 FileOBJ::FileOBJ(const std::string &filename_) :
 		FileGeometry(filename_) {
 }
 
-int FileOBJ::ExtractNumbers(std::vector<float> &v, int v_width) {
-	static const std::string numchars("+-.ABCDEFINTXYabcdefintxy0123456789");
-	std::string line;
-	std::getline(*inp, line);
+FileOBJ::FileOBJ(std::istream *stream) :
+		FileGeometry(stream) {
+}
+
+int FileOBJ::ExtractNumbers(TextScanner &scan, std::vector<float> &v,
+		int v_width) const {
+	const size_t lineStart = scan.Offset();
+	const std::string_view line = scan.Line();
+	static const std::string_view numchars(
+			"+-.ABCDEFINTXYabcdefintxy0123456789");
 	int numberCount = 0;
 	auto posStart = line.find_first_of(numchars, 0);
-	while (posStart != std::string::npos) {
+	while (posStart != std::string_view::npos) {
 		const auto posEnd = line.find_first_not_of(numchars, posStart);
-		const auto count =
-				(posEnd == std::string::npos) ?
-						(line.length() - posStart) : (posEnd - posStart);
-		const auto numberstring = line.substr(posStart, count);
-		v.push_back(std::strtof(numberstring.c_str(), nullptr));
+		const std::string_view number = line.substr(posStart,
+				posEnd - posStart);
+		// Like strtof: a leading '+' is allowed, no number gives 0.
+		const size_t skip = (number[0] == '+') ? 1 : 0;
+		float value = 0.0f;
+		std::from_chars(number.data() + skip, number.data() + number.size(),
+				value);
+		v.push_back(value);
 		numberCount++;
 		posStart = line.find_first_of(numchars, posEnd);
 	}
@@ -53,32 +66,35 @@ int FileOBJ::ExtractNumbers(std::vector<float> &v, int v_width) {
 		v_width = numberCount;
 	} else {
 		if (numberCount != v_width) {
-			throw std::runtime_error(
-					"FileOBJ::ReadStream : The count of numbers is changing for one type in the OBJ file.");
+			scan.Throw(
+					"The count of numbers is changing for one type in the OBJ file.",
+					lineStart);
 		}
 	}
 	return v_width;
 }
 
-std::string FileOBJ::NextToken() {
-	std::string result;
-	int c = inp->peek();
-	while (c != '\n') {
-		if (c == '/') {
-			inp->get();
-			return std::string("/");
-		}
-		if ((c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.') {
-			while ((c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.') {
-				result += inp->get();
-				c = inp->peek();
-			}
-			return result;
-		}
-		inp->get();
-		c = inp->peek();
-	}
-	return result;
+/**\brief Next "/" or number in the line of a face
+ *
+ * All other characters are skipped. Returns an empty string at the end of
+ * the line.
+ */
+static std::string_view NextToken(std::string_view &line) {
+	auto IsNumber = [](char c) {
+		return (c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.';
+	};
+	size_t pos = 0;
+	while (pos < line.size() && line[pos] != '/' && !IsNumber(line[pos]))
+		pos++;
+	size_t end = pos;
+	if (end < line.size())
+		end++;
+	if (pos < line.size() && line[pos] != '/')
+		while (end < line.size() && IsNumber(line[end]))
+			end++;
+	const std::string_view token = line.substr(pos, end - pos);
+	line.remove_prefix(end);
+	return token;
 }
 
 void FileOBJ::ReadStream(Geometry &geo) {
@@ -96,22 +112,19 @@ void FileOBJ::ReadStream(Geometry &geo) {
 	size_t vp_offs = 0;
 	std::vector<float> vp;
 
-	std::string word;
-	*inp >> std::ws;
-	*inp >> word;
-	while (inp->good()) {
-		if (word.empty())
-			throw std::runtime_error("This should not happen.");
+	MappedFile file;
+	MapInput(file);
+	TextScanner scan(file.Data(), file.Size(), filename);
+
+	std::string_view word = scan.Word();
+	while (!word.empty()) {
 		if (word[0] == '#') {
 			// Move to line-end
-			int c = inp->get();
-			while (c != '\n')
-				c = inp->get();
+			scan.SkipLine();
 		}
 		if (word == "o") {
 			// Entity name found.
-			std::string line;
-			std::getline(*inp, line);
+			const std::string line(scan.Line());
 			if (!geo.IsEmpty()) {
 				// If multiple geometries are found in the file, the last one is
 				// returned, all others are stored in the geometries vector.
@@ -134,13 +147,13 @@ void FileOBJ::ReadStream(Geometry &geo) {
 			vp_width = -1;
 		}
 		if (word == "v")
-			v_width = ExtractNumbers(v, v_width);
+			v_width = ExtractNumbers(scan, v, v_width);
 		if (word == "vt")
-			vt_width = ExtractNumbers(vt, vt_width);
+			vt_width = ExtractNumbers(scan, vt, vt_width);
 		if (word == "vn")
-			vn_width = ExtractNumbers(vn, vn_width);
+			vn_width = ExtractNumbers(scan, vn, vn_width);
 		if (word == "vp")
-			vp_width = ExtractNumbers(vp, vp_width);
+			vp_width = ExtractNumbers(scan, vp, vp_width);
 
 		if (word == "f") {
 			size_t n = 0;
@@ -148,7 +161,8 @@ void FileOBJ::ReadStream(Geometry &geo) {
 			size_t w = 0;
 			bool flag = false;
 			std::vector<int> ids;
-			std::string tok = NextToken();
+			std::string_view line = scan.Line();
+			std::string_view tok = NextToken(line);
 			while (!tok.empty()) {
 				if (tok == "/") {
 					if (!flag)
@@ -166,10 +180,15 @@ void FileOBJ::ReadStream(Geometry &geo) {
 						m = 0;
 						n++;
 					}
-					ids.push_back(std::atoi(tok.c_str()));
+					// Like atoi: no number gives 0.
+					int id = 0;
+					std::from_chars(
+							tok.data() + ((tok[0] == '+') ? 1 : 0),
+							tok.data() + tok.size(), id);
+					ids.push_back(id);
 					flag = true;
 				}
-				tok = NextToken();
+				tok = NextToken(line);
 			}
 			w++;
 			// If there are 6 values per vertex, these are x,y,z,r,g,b
@@ -244,19 +263,16 @@ void FileOBJ::ReadStream(Geometry &geo) {
 		}
 		if (word == "l") {
 			// Lines are not supported: read and ignore
-			std::string line;
-			std::getline(*inp, line);
+			scan.SkipLine();
 		}
 		if (word == "s") {
 			// Smooth shading
-			std::string line;
-			std::getline(*inp, line);
+			scan.SkipLine();
 			//TODO Read value from file
 			geo.smooth = false;
 		}
 		if (word == "g") {
-			std::string line;
-			std::getline(*inp, line);
+			const std::string line(scan.Line());
 			if (!geo.IsEmpty()) {
 				// If multiple geometries are found in the file, the last one is
 				// returned, all others are stored in the geometries vector.
@@ -278,7 +294,7 @@ void FileOBJ::ReadStream(Geometry &geo) {
 			vn_width = -1;
 			vp_width = -1;
 		}
-		*inp >> word;
+		word = scan.Word();
 	}
 	if (!geo.IsEmpty()) {
 		geo.Finish();
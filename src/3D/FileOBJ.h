@@ -33,10 +33,14 @@
  *
  * https://en.wikipedia.org/wiki/Wavefront_.obj_file
  *
+ * The file is mapped into memory and tokenized by a TextScanner.
  */
 
 #include "FileGeometry.h"
 
+#include <vector>
+
+class TextScanner;
 class FileOBJ: public FileGeometry {
 public:
 	explicit FileOBJ(const std::string &filename_);
@@ -47,8 +51,13 @@ public:
 	virtual void WriteStream(const Geometry &geometry) override;
 
 private:
-	int ExtractNumbers(std::vector<float> &v, int v_width);
-	std::string NextToken();
+	/**\brief Read the numbers of the rest of the line
+	 *
+	 * \return The count of numbers, that has to be the same as v_width,
+	 *         if v_width is not -1.
+	 */
+	int ExtractNumbers(TextScanner &scan, std::vector<float> &v,
+			int v_width) const;
 };
 
 #endif /* L3D_FILEOBJ_H */
@@ -26,6 +26,12 @@
 
 #include "FilePLY.h"
 
+#include "MappedFile.h"
+#include "TextScanner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <istream>
 #include <stdexcept>
@@ -44,76 +50,72 @@ FilePLY::FilePLY(std::ostream *stream) :
 }
 
 void FilePLY::ReadStream(Geometry &geo) {
+	MappedFile file;
+	MapInput(file);
+	TextScanner scan(file.Data(), file.Size(), filename);
 
-	std::string word;
-	*inp >> word;
-	if (word != "ply")
-		throw std::runtime_error(
-				"FilePLY::ReadFile : The file " + filename
-						+ " is not a valid PLY file.");
+	if (scan.Word() != "ply")
+		scan.Throw("Not a valid PLY file.");
 
-	ReadHeader(*inp);
+	ReadHeader(scan);
 
 	if (format == "ascii") {
-		ReadStreamAscii(*inp, geo);
+		ReadStreamAscii(scan, geo);
 	} else {
+		const char *data = file.Data() + scan.Offset();
+		const size_t size = file.Size() - scan.Offset();
 		if (format == "binary_little_endian") {
-			ReadStreamBinaryLE(*inp, geo);
+			ReadStreamBinary(data, size, true, geo);
 		} else {
 			if (format != "binary_big_endian")
 				throw std::runtime_error(
 						"FilePLY::ReadFile - The format '" + format
 								+ "' is not recognized.");
-			ReadStreamBinaryBE(*inp, geo);
+			ReadStreamBinary(data, size, false, geo);
 		}
 	}
 }
 
-void FilePLY::ReadHeader(std::istream &stream) {
-
-	std::string word;
-	std::string rest;
+void FilePLY::ReadHeader(TextScanner &scan) {
 	Element e;
-	stream >> word;
+	std::string_view word = scan.Word();
 	while (word != "end_header") {
 
 		if (word == "comment")
-			std::getline(stream, rest);
+			scan.SkipLine();
 		if (word == "format") {
-			stream >> format;
-			stream >> version;
-			std::getline(stream, rest);
+			format = scan.Word();
+			version = scan.Word();
+			scan.SkipLine();
 		}
 		if (word == "element") {
 			if (!e.IsEmpty()) {
 				elements.push_back(e);
 				e = Element();
 			}
-			stream >> e.name;
-			stream >> e.count;
-			std::getline(stream, rest);
+			e.name = scan.Word();
+			e.count = scan.Get<int64_t>();
+			scan.SkipLine();
 		}
 		if (word == "property") {
 			Property p;
-			stream >> word;
+			word = scan.Word();
 			if (word == "list") {
-				stream >> word;
-				p.typeListSize = StringToType(word);
-				stream >> word;
+				p.typeListSize = StringToType(std::string(scan.Word()));
+				word = scan.Word();
 			}
-			p.type = StringToType(word);
-			stream >> p.name;
-			std::getline(stream, rest);
+			p.type = StringToType(std::string(word));
+			p.name = scan.Word();
+			scan.SkipLine();
 			e.properties.push_back(p);
 		}
-		stream >> word;
-		if (stream.eof())
-			throw std::runtime_error(
-					"FilePLY::ReadHeader : Unexpected end of file while reading the header.");
+		word = scan.Word();
+		if (word.empty())
+			scan.Throw("Unexpected end of file while reading the header.");
 	}
 	if (!e.IsEmpty())
 		elements.push_back(e);
-	std::getline(stream, rest); // After end_header follows a return (char(10)).
+	scan.SkipLine(); // After end_header follows a return (char(10)).
 }
 
 bool FilePLY::Property::IsList() const {
@@ -124,87 +126,101 @@ bool FilePLY::Element::IsEmpty() const {
 	return properties.empty();
 }
 
-void FilePLY::ReadStreamAscii(std::istream &stream, Geometry &geo) {
+/**\brief Target of a vertex property
+ *
+ * \return 0..2 for x, y, z, 3..5 for the normal, 6..8 for the color and -1
+ *         for properties, that are not read
+ */
+static int Field(const std::string &name) {
+	static const char *names[] = { "x", "y", "z", "nx", "ny", "nz", "red",
+			"green", "blue" };
+	for (int n = 0; n < 9; n++)
+		if (name == names[n])
+			return n;
+	return -1;
+}
+
+/**\brief Set the coordinate of a field
+ */
+static void SetField(int field, double value, Vector3 &v, Vector3 &vn,
+		Vector3 &vc) {
+	if (field < 0)
+		return;
+	Vector3 &target = (field < 3) ? v : ((field < 6) ? vn : vc);
+	switch (field % 3) {
+	case 0:
+		target.x = value;
+		break;
+	case 1:
+		target.y = value;
+		break;
+	default:
+		target.z = value;
+	}
+}
+
+void FilePLY::ReadStreamAscii(TextScanner &scan, Geometry &geo) {
 	std::vector<Vector3> v;
 	std::vector<Vector3> vn;
 	std::vector<Vector3> vc;
-	bool hasNormals = false; //TODO Speedup
+	bool hasNormals = false;
 	bool hasColors = false;
 	for (const Element &e : elements) {
 		if (e.name == "vertex" || e.name == "vertices") {
 			v.resize(e.count);
 			vn.resize(e.count);
 			vc.resize(e.count);
+			// The names of the properties are compared once, not for every
+			// vertex.
+			std::vector<int> field;
+			for (const Property &p : e.properties) {
+				if (p.IsList())
+					scan.Throw(
+							"A list is not expected in the vertex definition.");
+				if (p.type == DataType::NONE || p.type == DataType::UINT16
+						|| p.type == DataType::UINT32
+						|| p.type == DataType::INT8
+						|| p.type == DataType::INT16
+						|| p.type == DataType::INT32)
+					scan.Throw("Unexpected datatype.");
+				field.push_back(Field(p.name));
+				if (e.count > 0) {
+					hasNormals |= (field.back() == 3);
+					hasColors |= (field.back() == 6);
+				}
+			}
 			for (size_t i = 0; i < e.count; i++) {
-				for (const Property &p : e.properties) {
-					if (p.IsList())
-						throw std::runtime_error(
-								"FilePLY::ReadStreamAscii - A list is not expected in the vertex definition.");
-					float val_float;
-					stream >> val_float;
-
-					if (p.type == DataType::UINT8)
+				for (size_t k = 0; k < field.size(); k++) {
+					float val_float = scan.Get<float>();
+					if (e.properties[k].type == DataType::UINT8)
 						val_float /= 255.0f;
-
-					if (p.type == DataType::NONE || p.type == DataType::UINT16
-							|| p.type == DataType::UINT32
-							|| p.type == DataType::INT8
-							|| p.type == DataType::INT16
-							|| p.type == DataType::INT32)
-						throw std::runtime_error(
-								"FilePLY::ReadStreamAscii - Unexpected datatype.");
-
-					if (p.name == "x") {
-						v[i].x = val_float;
-					} else if (p.name == "y") {
-						v[i].y = val_float;
-					} else if (p.name == "z") {
-						v[i].z = val_float;
-					} else if (p.name == "nx") {
-						vn[i].x = val_float;
-						hasNormals = true;
-					} else if (p.name == "ny") {
-						vn[i].y = val_float;
-					} else if (p.name == "nz") {
-						vn[i].z = val_float;
-					} else if (p.name == "red") {
-						vc[i].x = val_float;
-						hasColors = true;
-					} else if (p.name == "green") {
-						vc[i].y = val_float;
-					} else if (p.name == "blue") {
-						vc[i].z = val_float;
-					}
+					SetField(field[k], val_float, v[i], vn[i], vc[i]);
 				}
 			}
 		}
 		if (e.name == "face" || e.name == "faces") {
 			if (e.properties.size() != 1)
-				throw std::runtime_error(
-						"FilePLY::ReadStreamAscii - Expected exactly one property for '"
-								+ e.name + "'.");
+				scan.Throw(
+						"Expected exactly one property for '" + e.name + "'.");
 			auto p = e.properties[0];
 			if (p.name != "vertex_index" && p.name != "vertex_indices")
-				throw std::runtime_error(
-						"FilePLY::ReadStreamAscii - Expected the name 'vertex_index' or 'vertex_indices' but got '"
+				scan.Throw(
+						"Expected the name 'vertex_index' or 'vertex_indices' but got '"
 								+ p.name + "'.");
 			if (!p.IsList())
-				throw std::runtime_error(
-						"FilePLY::ReadStreamAscii - Expected a list.");
+				scan.Throw("Expected a list.");
 			if (p.typeListSize == DataType::FLOAT32
 					|| p.typeListSize == DataType::DOUBLE64)
-				throw std::runtime_error(
-						"FilePLY::ReadStreamAscii - The list size has to be an integer.");
+				scan.Throw("The list size has to be an integer.");
 			if (p.type == DataType::FLOAT32 || p.type == DataType::DOUBLE64)
-				throw std::runtime_error(
-						"FilePLY::ReadStreamAscii - The index in the list has to be an integer.");
+				scan.Throw("The index in the list has to be an integer.");
 
+			std::vector<int> idx;
 			for (size_t i = 0; i < e.count; i++) {
-				int N;
-				stream >> N;
-				std::vector<int> idx(N, 0);
+				const int N = (int) scan.Get<int64_t>();
+				idx.resize(N);
 				for (int j = 0; j < N; j++)
-					stream >> idx[j];
+					idx[j] = (int) scan.Get<int64_t>();
 
 				if (hasNormals)
 					geo.SetAddNormal(vn[idx[0]]);
@@ -269,177 +285,389 @@ void FilePLY::ReadStreamAscii(std::istream &stream, Geometry &geo) {
 	}
 }
 
-void FilePLY::ReadStreamBinaryLE(std::istream &stream, Geometry &geo) {
+void FilePLY::ReadStreamBinary(const char *data, size_t size,
+		bool littleEndian, Geometry &geo) {
+	// The values are converted into the byte order of this machine.
+	const uint16_t test = 1;
+	const bool hostLittleEndian = (*(const char*) &test == 1);
+	if (littleEndian == hostLittleEndian)
+		DecodeBinary<false>(data, size, geo);
+	else
+		DecodeBinary<true>(data, size, geo);
+}
 
-	std::vector<Vector3> v;
-	std::vector<Vector3> vn;
-	std::vector<Vector3> vc;
+size_t FilePLY::SizeOf(DataType type) {
+	switch (type) {
+	case DataType::INT8:
+	case DataType::UINT8:
+		return 1;
+	case DataType::INT16:
+	case DataType::UINT16:
+		return 2;
+	case DataType::INT32:
+	case DataType::UINT32:
+	case DataType::FLOAT32:
+		return 4;
+	case DataType::DOUBLE64:
+		return 8;
+	default:
+		return 0;
+	}
+}
 
-	std::vector<float> values_float;
+/**\brief Load an unaligned value and optionally reverse its bytes
+ */
+template<bool swapBytes, typename T> static T Load(const char *data) {
+	T value;
+	if (swapBytes) {
+		char temp[sizeof(T)];
+		for (size_t n = 0; n < sizeof(T); n++)
+			temp[n] = data[sizeof(T) - 1 - n];
+		std::memcpy(&value, temp, sizeof(T));
+	} else {
+		std::memcpy(&value, data, sizeof(T));
+	}
+	return value;
+}
 
-	bool hasNormals = false; //TODO Speedup
+template<bool swapBytes, typename T> static double LoadAsDouble(
+		const char *data) {
+	return (double) Load<swapBytes, T>(data);
+}
+
+/**\brief Load three consecutive floats as one block
+ *
+ * Used for x, y, z stored as float32 next to each other.
+ */
+template<bool swapBytes> static void LoadFloat3(const char *data,
+		float *value) {
+	uint32_t word[3];
+	std::memcpy(word, data, sizeof(word));
+	if (swapBytes) {
+		for (uint32_t &w : word)
+			w = (w >> 24) | ((w >> 8) & 0xFF00u) | ((w << 8) & 0xFF0000u)
+					| (w << 24);
+	}
+	std::memcpy(value, word, sizeof(word));
+}
+
+template<bool swapBytes>
+FilePLY::Loader FilePLY::GetLoader(DataType type) {
+	switch (type) {
+	case DataType::INT8:
+		return &LoadAsDouble<swapBytes, int8_t>;
+	case DataType::UINT8:
+		return &LoadAsDouble<swapBytes, uint8_t>;
+	case DataType::INT16:
+		return &LoadAsDouble<swapBytes, int16_t>;
+	case DataType::UINT16:
+		return &LoadAsDouble<swapBytes, uint16_t>;
+	case DataType::INT32:
+		return &LoadAsDouble<swapBytes, int32_t>;
+	case DataType::UINT32:
+		return &LoadAsDouble<swapBytes, uint32_t>;
+	case DataType::FLOAT32:
+		return &LoadAsDouble<swapBytes, float>;
+	case DataType::DOUBLE64:
+		return &LoadAsDouble<swapBytes, double>;
+	default:
+		throw std::runtime_error("FilePLY::GetLoader - No datatype selected.");
+	}
+}
+
+/**\brief Set a field of a vertex
+ */
+static void SetField(int field, double value, Geometry::Vertex &vertex) {
+	switch (field) {
+	case 0:
+		vertex.x = value;
+		break;
+	case 1:
+		vertex.y = value;
+		break;
+	case 2:
+		vertex.z = value;
+		break;
+	case 3:
+		vertex.n.x = value;
+		break;
+	case 4:
+		vertex.n.y = value;
+		break;
+	case 5:
+		vertex.n.z = value;
+		break;
+	case 6:
+		vertex.c.r = (float) value;
+		break;
+	case 7:
+		vertex.c.g = (float) value;
+		break;
+	case 8:
+		vertex.c.b = (float) value;
+		break;
+	default:
+		break;
+	}
+}
+
+template<bool swapBytes>
+void FilePLY::DecodeBinary(const char *data, size_t size, Geometry &geo) {
+	const char *const end = data + size;
+	// Checks, that count items of the given size are left in the buffer.
+	// The product is never formed, so that a forged count cannot overflow.
+	auto Need = [&](size_t count, size_t itemSize) {
+		if (itemSize != 0 && count > (size_t) (end - data) / itemSize)
+			throw std::runtime_error(
+					"FilePLY::ReadStreamBinary - Unexpected end of file.");
+	};
+
+	// The vertices are decoded into vert. Only the vertices used by a face
+	// are added to the geometry, vmap holds their index in the geometry.
+	std::vector<Geometry::Vertex> vert;
+	std::vector<size_t> vmap;
+	bool hasNormals = false;
 	bool hasColors = false;
+	bool hasFaces = false;
+	std::vector<size_t> idx;
+
+	// Layout of a record with lists: size, list size loader and item loader
+	// of each property.
+	struct Column {
+		size_t itemSize;
+		size_t countSize;
+		Loader count;
+		Loader item;
+	};
+
+	// Step through one record with lists. The list with the number 'list'
+	// is decoded into idx, everything else is skipped.
+	auto Record = [&](const std::vector<Column> &columns, size_t list) {
+		for (size_t k = 0; k < columns.size(); k++) {
+			const Column &c = columns[k];
+			if (c.count == nullptr) {
+				Need(1, c.itemSize);
+				data += c.itemSize;
+				continue;
+			}
+			Need(1, c.countSize);
+			const double count = c.count(data);
+			data += c.countSize;
+			if (count < 0.0)
+				throw std::runtime_error(
+						"FilePLY::ReadStreamBinary - Negative list size.");
+			const size_t N = (size_t) count;
+			Need(N, c.itemSize);
+			if (k == list) {
+				idx.resize(N);
+				for (size_t j = 0; j < N; j++) {
+					const double id = c.item(data + j * c.itemSize);
+					if (id < 0.0 || id >= (double) vert.size())
+						throw std::runtime_error(
+								"FilePLY::ReadStreamBinary - Vertex index out of range.");
+					idx[j] = (size_t) id;
+				}
+			}
+			data += N * c.itemSize;
+		}
+	};
+
+	auto Columns = [](const Element &e) {
+		std::vector<Column> columns;
+		for (const Property &p : e.properties) {
+			if (p.IsList())
+				columns.push_back( { SizeOf(p.type), SizeOf(p.typeListSize),
+						GetLoader<swapBytes>(p.typeListSize), GetLoader<
+								swapBytes>(p.type) });
+			else
+				columns.push_back( { SizeOf(p.type), 0, nullptr, nullptr });
+		}
+		return columns;
+	};
+
+	auto Index = [&](size_t i) {
+		if (vmap[i] == (size_t) -1) {
+			if (hasNormals)
+				geo.SetAddNormal(vert[i].n);
+			if (hasColors)
+				geo.SetAddColor(vert[i].c.r, vert[i].c.g, vert[i].c.b,
+						vert[i].c.a);
+			vmap[i] = geo.CountVertices();
+			geo.AddVertex(vert[i]);
+		}
+		return vmap[i];
+	};
+
+	auto AddTriangle = [&](size_t a, size_t b, size_t c) {
+		if (a == b || b == c || a == c)
+			return;
+		geo.AddTriangle(Index(a), Index(b), Index(c));
+	};
 
 	for (const Element &e : elements) {
-		if (e.name == "vertex" || e.name == "vertices") {
-			v.resize(e.count);
-			vn.resize(e.count);
-			vc.resize(e.count);
+		// Records without lists have a fixed size and are decoded as a block.
+		bool fixedSize = true;
+		size_t stride = 0;
+		for (const Property &p : e.properties) {
+			if (p.IsList())
+				fixedSize = false;
+			else
+				stride += SizeOf(p.type);
+		}
 
-			// Check if all properties are FLOAT_32
-			size_t fieldsPerRecord = 0;
+		if (e.name == "vertex" || e.name == "vertices") {
+			if (!fixedSize)
+				throw std::runtime_error(
+						"FilePLY::ReadStreamBinary - A list is not expected in the vertex definition.");
+
+			// Decoding plan: the position of each used property in the
+			// record, its loader and its target in the vertex.
+			struct Step {
+				size_t offset;
+				DataType type;
+				Loader load;
+				int field;
+				bool normalize; ///< uchar colors are scaled to 0..1.
+			};
+			std::vector<Step> plan;
+			hasNormals = false;
+			hasColors = false;
+			size_t offset = 0;
 			for (const Property &p : e.properties) {
-				if (p.IsList())
-					throw std::runtime_error(
-							"FilePLY::ReadStreamBinaryLE - A list is not expected in the vertex definition.");
-				if (p.type != DataType::FLOAT32)
-					throw std::runtime_error(
-							"FilePLY::ReadStreamBinaryLE - Not all elements of a vector are floats.");
-				fieldsPerRecord++;
+				const int field = Field(p.name);
+				const bool normalize = (p.type == DataType::UINT8);
+				if (field >= 0)
+					plan.push_back( { offset, p.type, GetLoader<swapBytes>(
+							p.type), field, normalize });
+				offset += SizeOf(p.type);
+				if (e.count > 0) {
+					hasNormals |= (field == 3);
+					hasColors |= (field == 6);
+				}
 			}
 
-			// Bulk-read all vectors.
-			values_float.resize(e.count * fieldsPerRecord);
-			stream.read((char*) values_float.data(),
-					values_float.size() * sizeof(float));
+			// Fast path: x, y, z as consecutive float32 (as written by most
+			// scanners) are copied as one block of 12 bytes.
+			size_t xyzOffset = 0;
+			bool xyzFloat = false;
+			for (size_t k = 0; k + 2 < plan.size(); k++) {
+				if (plan[k].field == 0 && plan[k + 1].field == 1
+						&& plan[k + 2].field == 2
+						&& plan[k].type == DataType::FLOAT32
+						&& plan[k + 1].type == DataType::FLOAT32
+						&& plan[k + 2].type == DataType::FLOAT32
+						&& plan[k + 1].offset == plan[k].offset + 4
+						&& plan[k + 2].offset == plan[k].offset + 8) {
+					xyzOffset = plan[k].offset;
+					xyzFloat = true;
+					plan.erase(plan.begin() + k, plan.begin() + k + 3);
+					break;
+				}
+			}
 
-			size_t c = 0;
-			for (size_t i = 0; i < e.count; i++) {
-				for (const Property &p : e.properties) {
-					if (p.name == "x") {
-						v[i].x = values_float[c];
-					} else if (p.name == "y") {
-						v[i].y = values_float[c];
-					} else if (p.name == "z") {
-						v[i].z = values_float[c];
-					} else if (p.name == "nx") {
-						vn[i].x = values_float[c];
-						hasNormals = true;
-					} else if (p.name == "ny") {
-						vn[i].y = values_float[c];
-					} else if (p.name == "nz") {
-						vn[i].z = values_float[c];
-					} else if (p.name == "red") {
-						vc[i].x = values_float[c];
-						hasColors = true;
-					} else if (p.name == "green") {
-						vc[i].y = values_float[c];
-					} else if (p.name == "blue") {
-						vc[i].z = values_float[c];
-					}
-					c++;
+			Need(e.count, stride);
+			vert.assign(e.count, Geometry::Vertex());
+			vmap.assign(e.count, (size_t) -1);
+			for (Geometry::Vertex &vertex : vert) {
+				if (xyzFloat) {
+					float xyz[3];
+					LoadFloat3<swapBytes>(data + xyzOffset, xyz);
+					vertex.x = xyz[0];
+					vertex.y = xyz[1];
+					vertex.z = xyz[2];
+				}
+				for (const Step &s : plan) {
+					double value = s.load(data + s.offset);
+					if (s.normalize)
+						value = (float) value / 255.0f;
+					SetField(s.field, value, vertex);
 				}
+				if (hasNormals)
+					vertex.n.Normalize();
+				data += stride;
 			}
+			continue;
 		}
 
 		if (e.name == "face" || e.name == "faces") {
-			if (e.properties.size() != 1)
+			size_t list = 0;
+			while (list < e.properties.size()
+					&& e.properties[list].name != "vertex_index"
+					&& e.properties[list].name != "vertex_indices")
+				list++;
+			if (list == e.properties.size())
 				throw std::runtime_error(
-						"FilePLY::ReadStreamBinaryLE - Expected exactly one property for '"
+						"FilePLY::ReadStreamBinary - Expected a property 'vertex_index' or 'vertex_indices' for '"
 								+ e.name + "'.");
-			auto p = e.properties[0];
-			if (p.name != "vertex_index" && p.name != "vertex_indices")
-				throw std::runtime_error(
-						"FilePLY::ReadStreamBinaryLE - Expected the name 'vertex_index' or 'vertex_indices' but got '"
-								+ p.name + "'.");
+			const Property &p = e.properties[list];
 			if (!p.IsList())
 				throw std::runtime_error(
-						"FilePLY::ReadStreamBinaryLE - Expected a list.");
+						"FilePLY::ReadStreamBinary - Expected a list.");
 			if (p.typeListSize == DataType::FLOAT32
 					|| p.typeListSize == DataType::DOUBLE64)
 				throw std::runtime_error(
-						"FilePLY::ReadStreamBinaryLE - The list size has to be an integer.");
+						"FilePLY::ReadStreamBinary - The list size has to be an integer.");
 			if (p.type == DataType::FLOAT32 || p.type == DataType::DOUBLE64)
 				throw std::runtime_error(
-						"FilePLY::ReadStreamBinaryLE - The index in the list has to be an integer.");
-
-			if (p.typeListSize != DataType::UINT8)
-				throw std::runtime_error(
-						"FilePLY::ReadStreamBinaryLE - Expected uint8 for the ListSize entry (in current implementation).");
-
-			std::vector<uint32_t> idx;
+						"FilePLY::ReadStreamBinary - The index in the list has to be an integer.");
+
+			// Fast path: faces with only a uchar list of 32 bit indices.
+			const bool fastIndices = e.properties.size() == 1
+					&& p.typeListSize == DataType::UINT8
+					&& (p.type == DataType::INT32 || p.type == DataType::UINT32);
+			const std::vector<Column> columns = Columns(e);
+
+			// Most scanners write triangles.
+			hasFaces = true;
+			geo.Reserve(geo.CountVertices() + vert.size(),
+					geo.CountEdges() + 3 * e.count,
+					geo.CountTriangles() + e.count);
 			for (size_t i = 0; i < e.count; i++) {
-				uint8_t N;
-				stream.read((char*) &N, sizeof(uint8_t));
-				idx.resize(N);
-				switch (p.type) {
-				case DataType::UINT32:
-					stream.read((char*) idx.data(), N * sizeof(uint32_t));
-					break;
-				case DataType::INT32:
-					// FIXME: Read the data as int32 and check&cast.
-					stream.read((char*) idx.data(), N * sizeof(uint32_t));
-					break;
-				default:
-					throw std::runtime_error(
-							"FilePLY::ReadStreamBinaryLE - Expected uint32 for the vertex-index entry (in current implementation).");
-				}
-
-				if (hasNormals)
-					geo.SetAddNormal(vn[idx[0]]);
-				else
-					geo.ResetAddNormal();
-				if (hasColors)
-					geo.SetAddColor(vc[idx[0]]);
-				else
-					geo.ResetAddColor();
-				geo.AddVertex(v[idx[0]]);
-				size_t idx0 = geo.CountVertices() - 1;
-				if (hasNormals)
-					geo.SetAddNormal(vn[idx[1]]);
-				else
-					geo.ResetAddNormal();
-				if (hasColors)
-					geo.SetAddColor(vc[idx[1]]);
-				else
-					geo.ResetAddColor();
-				geo.AddVertex(v[idx[1]]);
-				size_t idx1 = geo.CountVertices() - 1;
-				for (int j = 2; j < N; j++) {
-					if (hasNormals)
-						geo.SetAddNormal(vn[idx[j]]);
-					else
-						geo.ResetAddNormal();
-					if (hasColors)
-						geo.SetAddColor(vc[idx[j]]);
-					else
-						geo.ResetAddColor();
-					geo.AddVertex(v[idx[j]]);
-					geo.ResetAddNormal();
-					size_t idx2 = geo.CountVertices() - 1;
-					geo.AddTriangle(idx0, idx1, idx2);
-					idx1 = idx2;
-
-					//					tc.AddTriangleWithNormals(v[idx[0]], v[idx[j - 1]],
-					//							v[idx[j]], , vn[idx[j - 1]],
-					//							vn[idx[j]]);
-					//					else
-					//					tc.AddTriangle(v[idx[0]], v[idx[j - 1]], v[idx[j]]);
-					//					if (hasColors) {
-					//						size_t k = tc.Size() - 1;
-					//						tc.triangles[k].c[0] = vc[idx[0]];
-					//						tc.triangles[k].c[1] = vc[idx[j - 1]];
-					//						tc.triangles[k].c[2] = vc[idx[j]];
-					//					} else {
-					//						geo.ResetAddColor();
-					//					}
+				if (fastIndices) {
+					Need(1, 1);
+					const size_t N = (uint8_t) *data;
+					data++;
+					Need(N, 4);
+					idx.resize(N);
+					for (size_t j = 0; j < N; j++) {
+						const uint32_t id = Load<swapBytes, uint32_t>(
+								data + j * 4);
+						if (id >= vert.size())
+							throw std::runtime_error(
+									"FilePLY::ReadStreamBinary - Vertex index out of range.");
+						idx[j] = id;
+					}
+					data += N * 4;
+				} else {
+					Record(columns, list);
 				}
-				//				if (hasColors)
-				//					tc.useColor = TriangleCollection::Style::Vertex;
-			}
-			geo.Finish();
-			geo.Sort();
-			if (!geo.PassedSelfCheck(true)) {
-				std::cerr << __FILE__ << " (" << __LINE__ << "): "
-						<< "The file seems to contain data that breaks the Finish() method.\n";
+				for (size_t j = 2; j < idx.size(); j++)
+					AddTriangle(idx[0], idx[j - 1], idx[j]);
 			}
+			continue;
+		}
 
+		// Other elements are skipped.
+		if (fixedSize) {
+			Need(e.count, stride);
+			data += e.count * stride;
+		} else {
+			const std::vector<Column> columns = Columns(e);
+			for (size_t i = 0; i < e.count; i++)
+				Record(columns, columns.size());
 		}
 	}
-}
 
-void FilePLY::ReadStreamBinaryBE(std::istream &stream, Geometry &geometry) {
-	throw std::runtime_error("FilePLY::ReadStreamBinaryBE - Not implemented.");
+	geo.ResetAddNormal();
+	geo.ResetAddColor();
+	if (!hasFaces)
+		return;
+	geo.Finish();
+	geo.Sort();
+	if (!geo.PassedSelfCheck(true)) {
+		std::cerr << __FILE__ << " (" << __LINE__ << "): "
+				<< "The file seems to contain data that breaks the Finish() method.\n";
+	}
 }
 
 FilePLY::DataType FilePLY::StringToType(const std::string &name) const {
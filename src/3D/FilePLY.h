@@ -33,12 +33,28 @@
  *
  * https://en.wikipedia.org/wiki/PLY_(file_format)
  *
+ * The file is mapped into memory. The header and ASCII data are tokenized by
+ * a TextScanner.
+ *
+ * Binary files (little or big endian) are decoded by a plan, that is set up
+ * once from the header: each used vertex property is found by its offset in
+ * the record and loaded by a function for its datatype. Normals (nx, ny, nz)
+ * and colors (red, green, blue as uchar or float) are read. Unknown
+ * properties and elements are skipped. Coordinates stored as consecutive
+ * floats and faces with 32 bit indices are copied without a lookup.
+ *
+ * The vertices used by a face are added to the Geometry once, the triangles
+ * by their index. Afterwards the Geometry is finished as for the ASCII
+ * format, i.e. vertices at the same position are welded. Vertices without a
+ * face are dropped.
  */
 
 #include "FileGeometry.h"
 
 #include <vector>
 
+class TextScanner;
+
 class FilePLY: public FileGeometry {
 private:
 	enum class DataType {
@@ -78,10 +94,17 @@ public:
 //	virtual void WriteStream(const Geometry & geometry) override;
 
 private:
-	void ReadHeader(std::istream &stream);
-	void ReadStreamAscii(std::istream &stream, Geometry &geometry);
-	void ReadStreamBinaryLE(std::istream &stream, Geometry &geometry);
-	void ReadStreamBinaryBE(std::istream &stream, Geometry &geometry);
+	void ReadHeader(TextScanner &scan);
+	void ReadStreamAscii(TextScanner &scan, Geometry &geometry);
+	void ReadStreamBinary(const char *data, size_t size, bool littleEndian,
+			Geometry &geometry);
+	template<bool swapBytes>
+	void DecodeBinary(const char *data, size_t size, Geometry &geometry);
+
+	typedef double (*Loader)(const char *data); ///< Loads one value of a datatype
+	template<bool swapBytes>
+	static Loader GetLoader(DataType type);
+	static size_t SizeOf(DataType type);
 
 	DataType StringToType(const std::string &name) const;
 	std::string format;
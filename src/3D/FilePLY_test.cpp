@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : FilePLY_test.cpp
+// Purpose            : Test the binary PLY reader
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef USE_CPPUNIT
+
+#include "FilePLY.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Geometry.h"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+class FilePLYTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( FilePLYTest );
+	CPPUNIT_TEST(testBinary);
+	CPPUNIT_TEST(testLayout);
+	CPPUNIT_TEST(testWeld);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief A colored quad in little and big endian
+	 *
+	 * The faces have an extra property and are followed by an element, that
+	 * is not used.
+	 */
+	static std::string Quad(bool littleEndian) {
+		std::string data = std::string("ply\nformat ")
+				+ (littleEndian ? "binary_little_endian" : "binary_big_endian")
+				+ " 1.0\n"
+						"element vertex 4\n"
+						"property float x\nproperty float y\nproperty float z\n"
+						"property uchar red\nproperty uchar green\n"
+						"property uchar blue\nproperty uchar alpha\n"
+						"element face 1\n"
+						"property list uchar uint vertex_indices\n"
+						"property uchar flags\n"
+						"element material 1\n"
+						"property list uchar uchar name\n"
+						"end_header\n";
+		auto Add = [&](const void *value, size_t size) {
+			const char *p = (const char*) value;
+			for (size_t n = 0; n < size; n++)
+				data += p[littleEndian ? n : (size - 1 - n)];
+		};
+		const float xyz[4][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0,
+				1, 0 } };
+		for (size_t i = 0; i < 4; i++) {
+			for (size_t k = 0; k < 3; k++)
+				Add(&xyz[i][k], sizeof(float));
+			const uint8_t rgba[4] = { 255, 0, 51, 255 };
+			for (size_t k = 0; k < 4; k++)
+				Add(&rgba[k], 1);
+		}
+		const uint8_t N = 4;
+		Add(&N, 1);
+		for (uint32_t i = 0; i < 4; i++)
+			Add(&i, sizeof(uint32_t));
+		data += '\x01'; // flags
+		data += "\x03" "abc"; // material
+		return data;
+	}
+
+	void testBinary() {
+		for (bool littleEndian : { true, false }) {
+			std::istringstream in(Quad(littleEndian));
+			Geometry geo;
+			FilePLY ply(&in);
+			ply.Read(geo);
+			CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountTriangles());
+			CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountVertices());
+			for (size_t i = 0; i < geo.CountVertices(); i++) {
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, geo[i].c.r, 1e-6);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, geo[i].c.g, 1e-6);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, geo[i].c.b, 1e-6);
+			}
+		}
+
+		// Truncated data
+		std::string data = Quad(true);
+		data.resize(data.size() - 10);
+		std::istringstream in(data);
+		Geometry geo;
+		FilePLY ply(&in);
+		CPPUNIT_ASSERT_THROW(ply.Read(geo), std::runtime_error);
+
+		// A vertex count, that overflows count * size of a record.
+		data = Quad(true);
+		const std::string count = "element vertex 4\n";
+		data.replace(data.find(count), count.size(),
+				"element vertex 2305843009213693952\n");
+		std::istringstream in2(data);
+		Geometry geo2;
+		FilePLY ply2(&in2);
+		CPPUNIT_ASSERT_THROW(ply2.Read(geo2), std::runtime_error);
+	}
+
+	/**\brief Double coordinates, ushort indices and an unused vertex
+	 *
+	 * Neither of the fast paths applies. The normals are calculated.
+	 */
+	void testLayout() {
+		std::string data = "ply\nformat binary_little_endian 1.0\n"
+				"element vertex 5\n"
+				"property double x\nproperty double y\nproperty double z\n"
+				"element face 1\n"
+				"property list ushort ushort vertex_index\n"
+				"end_header\n";
+		auto Add = [&](const void *value, size_t size) {
+			data.append((const char*) value, size);
+		};
+		const double xyz[5][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 7, 7, 7 }, { 1,
+				1, 0 }, { 0, 1, 0 } };
+		for (size_t i = 0; i < 5; i++)
+			Add(xyz[i], 3 * sizeof(double));
+		const uint16_t face[] = { 4, 0, 1, 3, 4 };
+		Add(face, sizeof(face));
+		// Check only for a little endian machine.
+		const uint16_t test = 1;
+		if (*(const char*) &test != 1)
+			return;
+
+		std::istringstream in(data);
+		Geometry geo;
+		FilePLY ply(&in);
+		ply.Read(geo);
+		CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountVertices());
+		CPPUNIT_ASSERT_EQUAL((size_t) 5, geo.CountEdges());
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountTriangles());
+		CPPUNIT_ASSERT(geo.PassedSelfCheck(true));
+		for (size_t i = 0; i < geo.CountVertices(); i++) {
+			CPPUNIT_ASSERT(geo[i].z == 0.0);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, geo[i].n.z, 1e-9);
+		}
+	}
+
+	/**\brief A tetrahedron, where each face has its own vertices
+	 *
+	 * The vertices are welded as in the ASCII format.
+	 */
+	void testWeld() {
+		const double xyz[4][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0,
+				0, 1 } };
+		const int face[4][3] = { { 0, 2, 1 }, { 0, 1, 3 }, { 1, 2, 3 }, { 0, 3,
+				2 } };
+		std::string header = "element vertex 12\n"
+				"property float x\nproperty float y\nproperty float z\n"
+				"element face 4\n"
+				"property list uchar int vertex_indices\n"
+				"end_header\n";
+		std::string ascii = "ply\nformat ascii 1.0\n" + header;
+		std::string binary = "ply\nformat binary_little_endian 1.0\n" + header;
+		for (size_t i = 0; i < 4; i++) {
+			for (size_t k = 0; k < 3; k++) {
+				const double *p = xyz[face[i][k]];
+				ascii += std::to_string(p[0]) + " " + std::to_string(p[1])
+						+ " " + std::to_string(p[2]) + "\n";
+				for (size_t j = 0; j < 3; j++) {
+					const float f = (float) p[j];
+					binary.append((const char*) &f, sizeof(float));
+				}
+			}
+		}
+		for (int i = 0; i < 4; i++) {
+			ascii += "3 " + std::to_string(3 * i) + " "
+					+ std::to_string(3 * i + 1) + " "
+					+ std::to_string(3 * i + 2) + "\n";
+			binary += '\x03';
+			for (int k = 0; k < 3; k++) {
+				const int32_t id = 3 * i + k;
+				binary.append((const char*) &id, sizeof(int32_t));
+			}
+		}
+		// Check only for a little endian machine.
+		const uint16_t test = 1;
+		if (*(const char*) &test != 1)
+			return;
+
+		for (const std::string &data : { ascii, binary }) {
+			std::istringstream in(data);
+			Geometry geo;
+			FilePLY ply(&in);
+			ply.Read(geo);
+			CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountVertices());
+			CPPUNIT_ASSERT_EQUAL((size_t) 6, geo.CountEdges());
+			CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountTriangles());
+			CPPUNIT_ASSERT(geo.PassedSelfCheck(true));
+		}
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FilePLYTest);
+#endif
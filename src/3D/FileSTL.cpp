@@ -26,8 +26,15 @@
 
 #include "FileSTL.h"
 
+#include "MappedFile.h"
+#include "TextScanner.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <fstream>
 #include <stdint.h>
+#include <string_view>
 
 // Verify, that float is 32 bit on this architecture.
 #define __ASSERT(e) typedef char __ASSERT__[(e)?1:-1]
@@ -42,93 +49,88 @@ FileSTL::FileSTL(std::istream *stream) :
 }
 
 void FileSTL::ReadStream(Geometry &geo) {
-	// Find the header of the STL file:
-	std::string header(5, '\0');
-
-	if (!inp->read(&header[0], 5)) {
+	MappedFile file;
+	MapInput(file);
+	if (file.Size() < 5)
 		throw std::runtime_error(
 				"STL File " + filename + ": File contains no header.");
-	}
-	if (header.compare("solid") == 0) {
-		// Make sure, that number are written with a dot and not a comma.
-		setlocale(LC_ALL, "C");
-		try {
-			ReadStreamAscii(*inp, header, geo);
-		} catch (std::exception &ex) {
-			setlocale(LC_ALL, "");
-			throw(ex);
-		}
-		setlocale(LC_ALL, "");
+	if (std::string_view(file.Data(), 5) == "solid") {
+		ReadStreamAscii(file.Data(), file.Size(), geo);
 	} else {
-		ReadStreamBinary(*inp, header, geo);
+		ReadStreamBinary(file.Data(), file.Size(), geo);
 	}
-
 }
 
-void FileSTL::ReadStreamAscii(std::istream &stream, std::string &header,
-		Geometry &geo) {
-
-	std::string name;
-	std::getline(stream, name);
-	header += name;
-
-	std::string word = header.substr(0, 5);
-	if (word.compare("solid") != 0)
+void FileSTL::ReadStreamFloat(FloatMesh &mesh) {
+	MappedFile file;
+	MapInput(file);
+	if (file.Size() < 5)
 		throw std::runtime_error(
-				"STL Text File " + filename + ": Incorrect file.");
+				"STL File " + filename + ": File contains no header.");
+	if (std::string_view(file.Data(), 5) == "solid") {
+		// Text files are parsed into a Geometry and converted afterwards.
+		Geometry temp;
+		ReadStreamAscii(file.Data(), file.Size(), temp);
+		mesh.Assign(temp);
+	} else {
+		ReadStreamBinary(file.Data(), file.Size(), mesh);
+	}
+}
+
+void FileSTL::ReadStreamAscii(const char *data, size_t size, Geometry &geo) {
+	// The numbers are converted independent of the locale.
+	TextScanner scan(data + 5, size - 5, filename);
+	const std::string name(scan.Line());
+	std::string_view word = "solid";
 
 	std::array<float, 3> normal;
 	std::array<float, 9> coord;
 	bool solidcomplete = true;
 
-	while (stream.good() && word.substr(0, 5).compare("solid") == 0) {
+	while (word.substr(0, 5) == "solid") {
 		// Set up a new geometry object.
 		solidcomplete = false;
 		geo.name = StringTrim(name);
 
-		stream >> word;
-		while (word.compare("facet") == 0) {
-			stream >> word;
+		word = scan.Word();
+		while (word == "facet") {
+			word = scan.Word();
 
-			if (word.compare("normal") == 0) {
-				stream >> normal[0] >> normal[1] >> normal[2];
+			if (word == "normal") {
+				for (float &value : normal)
+					value = scan.Get<float>();
 				geo.SetAddNormal(normal[0], normal[1], normal[2]);
 			} else {
 				geo.ResetAddNormal();
 			}
-			if (!stream.good())
+			if (scan.AtEnd())
 				break;
 
-			stream >> word;
+			word = scan.Word();
 
-			if (word.compare("outer") != 0)
-				throw std::runtime_error(
-						"STL Text File " + filename + ": 'outer' missing.");
+			if (word != "outer")
+				scan.Throw("'outer' missing.");
 
-			stream >> word;
-			if (word.compare("loop") != 0)
-				throw std::runtime_error(
-						"STL Text File " + filename + ": 'loop' missing.");
+			word = scan.Word();
+			if (word != "loop")
+				scan.Throw("'loop' missing.");
 
 			for (uint_fast8_t m = 0; m < 3; m++) {
-				stream >> word;
-				if (word.compare("vertex") != 0)
-					throw std::runtime_error(
-							"STL Text File " + filename
-									+ ": 'vertex' missing.");
-
-				*inp >> coord[m * 3 + 0] >> coord[m * 3 + 1]
-						>> coord[m * 3 + 2];
+				word = scan.Word();
+				if (word != "vertex")
+					scan.Throw("'vertex' missing.");
+
+				coord[m * 3 + 0] = scan.Get<float>();
+				coord[m * 3 + 1] = scan.Get<float>();
+				coord[m * 3 + 2] = scan.Get<float>();
 			}
-			stream >> word;
-			if (word.compare("endloop") != 0)
-				throw std::runtime_error(
-						"STL Text File " + filename + ": 'endloop' missing.");
+			word = scan.Word();
+			if (word != "endloop")
+				scan.Throw("'endloop' missing.");
 
-			stream >> word;
-			if (word.compare("endfacet") != 0)
-				throw std::runtime_error(
-						"STL Text File " + filename + ": 'endfacet' missing.");
+			word = scan.Word();
+			if (word != "endfacet")
+				scan.Throw("'endfacet' missing.");
 
 			geo.AddTriangle( { coord[0], coord[1], coord[2] }, { coord[3],
 					coord[4], coord[5] }, { coord[6], coord[7], coord[8] });
@@ -157,57 +159,36 @@ void FileSTL::ReadStreamAscii(std::istream &stream, std::string &header,
 //				geometry[n].AddTriangle(tri.p[0], tri.p[1], tri.p[2]);
 //			}
 
-			stream >> word;
+			word = scan.Word();
 		}
-		if (word.compare("endsolid") != 0)
-			throw std::runtime_error(
-					"STL Text File " + filename + ": 'endsolid' missing.");
+		if (word != "endsolid")
+			scan.Throw("'endsolid' missing.");
 		geo.Finish();
 		solidcomplete = true;
 		//TODO Enable AND TEST the line below. The name of the solid should follow the "endsolid" statement.
 		//std::getline(stream, word);
-		stream >> word;
+		word = scan.Word();
 	}
 	if (!solidcomplete)
-		throw std::runtime_error(
-				"STL Text File " + filename
-						+ ": There was an error in the data while reading a solid from the file. Maybe the file was truncated.");
+		scan.Throw(
+				"There was an error in the data while reading a solid from the file. Maybe the file was truncated.");
 }
 
-void FileSTL::ReadStreamBinary(std::istream &stream, std::string &header,
-		Geometry &geo) {
-	// NOTE: When changing to std::istream, check https://stackoverflow.com/questions/5605125/why-is-iostreameof-inside-a-loop-condition-i-e-while-stream-eof-cons
-
-	{
-		const size_t bytestoread = 80 - header.size();
-		std::string temp(bytestoread, '\0');
-		if (!stream.read(&temp[0], bytestoread) || stream.eof()) {
-			throw std::runtime_error(
-					"STL File " + filename + ": File contains no header.");
-		}
-		header += temp;
-	}
-
+void FileSTL::ReadStreamBinary(const char *data, size_t size, Geometry &geo) {
 	uint32_t nrOfTriangles;
-	if (!stream.read(reinterpret_cast<char*>(&nrOfTriangles),
-			sizeof nrOfTriangles) || stream.eof())
-		throw std::runtime_error(
-				"STL File " + filename + ": File to short. Unexpected EOF.");
+	ReadHeaderBinary(data, size, nrOfTriangles);
+
+	geo.Reserve(geo.CountVertices() + 3 * (size_t) nrOfTriangles,
+			geo.CountEdges() + 3 * (size_t) nrOfTriangles,
+			geo.CountTriangles() + nrOfTriangles);
 
 	std::array<float, 12> coord;
 	uint16_t attribute;
 	for (size_t i = 0; i < nrOfTriangles; i++) {
-		if (!stream.read(reinterpret_cast<char*>(&(coord[0])),
-				coord.size() * sizeof(float)) || stream.eof())
-			throw std::runtime_error(
-					"STL File " + filename
-							+ ": File to short. Unexpected EOF.");
-
-		if (!stream.read(reinterpret_cast<char*>(&attribute), sizeof attribute)
-				|| stream.eof())
-			throw std::runtime_error(
-					"STL File " + filename
-							+ ": File to short. Unexpected EOF.");
+		const char *record = data + 50 * i;
+		std::memcpy(coord.data(), record, coord.size() * sizeof(float));
+		std::memcpy(&attribute, record + coord.size() * sizeof(float),
+				sizeof attribute);
 
 		if (attribute & (1 << 15)) {
 			Vector3 newColor;
@@ -256,6 +237,55 @@ void FileSTL::ReadStreamBinary(std::istream &stream, std::string &header,
 	//			}
 }
 
+void FileSTL::ReadStreamBinary(const char *data, size_t size,
+		FloatMesh &mesh) {
+	uint32_t nrOfTriangles;
+	ReadHeaderBinary(data, size, nrOfTriangles);
+
+	// The normal vector at the start of every record is ignored. The normals
+	// of the vertices are calculated after reading.
+	mesh.AddTriangles(data + 3 * sizeof(float), nrOfTriangles, 50);
+
+	const size_t first = mesh.CountTriangles() - nrOfTriangles;
+	for (size_t i = 0; i < nrOfTriangles; i++) {
+		uint16_t attribute;
+		std::memcpy(&attribute, data + 50 * i + 12 * sizeof(float),
+				sizeof attribute);
+		if (!(attribute & (1 << 15)))
+			continue;
+		// The colors are only stored, once the first triangle has a color.
+		if (!mesh.HasColors())
+			mesh.c.resize(mesh.CountTriangles());
+		Geometry::Color &newColor = mesh.c[first + i];
+		newColor.r = (float) ((attribute >> 0) & 31) / 31.0f;
+		newColor.g = (float) ((attribute >> 5) & 31) / 31.0f;
+		newColor.b = (float) ((attribute >> 10) & 31) / 31.0f;
+	}
+	mesh.CalculateNormals();
+	mesh.Shrink();
+}
+
+void FileSTL::ReadHeaderBinary(const char *&data, size_t &size,
+		uint32_t &nrOfTriangles) {
+	// The 80 bytes of the header are ignored.
+	if (size < 80)
+		throw std::runtime_error(
+				"STL File " + filename + ": File contains no header.");
+	data += 80;
+	size -= 80;
+
+	if (size < sizeof nrOfTriangles)
+		throw std::runtime_error(
+				"STL File " + filename + ": File to short. Unexpected EOF.");
+	std::memcpy(&nrOfTriangles, data, sizeof nrOfTriangles);
+	data += sizeof nrOfTriangles;
+	size -= sizeof nrOfTriangles;
+
+	if (size / 50 < nrOfTriangles)
+		throw std::runtime_error(
+				"STL File " + filename + ": File to short. Unexpected EOF.");
+}
+
 void FileSTL::WriteStream(const Geometry &geo) {
 	uint8_t header[81] =
 			"Generated by FileSTL::WriteStream                                               ";
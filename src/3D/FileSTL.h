@@ -39,6 +39,10 @@
  *
  * Color is represented in the VisCAM / SolidView schema.
  *
+ * Files are mapped into memory (see MappedFile) and the triangles are parsed
+ * directly from the mapping. Streams are copied into memory first. Text
+ * files are tokenized by a TextScanner.
+ *
  * \todo Check header for Materialise Magics color tags. Also this software uses
  *       BGR instead of RGB.
  *
@@ -46,6 +50,7 @@
 
 #include "FileGeometry.h"
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -57,12 +62,20 @@ public:
 
 	virtual void ReadStream(Geometry &geometry) override;
 	virtual void WriteStream(const Geometry &geometry) override;
+	virtual void ReadStreamFloat(FloatMesh &mesh) override;
 
 private:
-	void ReadStreamBinary(std::istream &stream, std::string &header,
-			Geometry &geometry);
-	void ReadStreamAscii(std::istream &stream, std::string &header,
-			Geometry &geometry);
+	void ReadStreamBinary(const char *data, size_t size, Geometry &geometry);
+	void ReadStreamAscii(const char *data, size_t size, Geometry &geometry);
+	void ReadStreamBinary(const char *data, size_t size, FloatMesh &mesh);
+
+	/**\brief Read the header of a binary file
+	 *
+	 * \param data Start of the file, moved to the first triangle
+	 * \param size Size of the file, reduced to the bytes behind data
+	 */
+	void ReadHeaderBinary(const char *&data, size_t &size,
+			uint32_t &nrOfTriangles);
 
 //	void TriangleToStream(std::ostream &stream, const Triangle &tri) const;
 };
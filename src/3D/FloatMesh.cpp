@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : FloatMesh.cpp
+// Purpose            : Indexed triangle mesh in single precision
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FloatMesh.h"
+
+#include "../system/Cancellation.h"
+#include "../system/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "OpenGL.h"
+
+void FloatMesh::Clear() {
+	p.clear();
+	n.clear();
+	idx.clear();
+	c.clear();
+	vmap.clear();
+}
+
+void FloatMesh::AddTriangle(const std::array<float, 9> &q) {
+	if (!c.empty())
+		c.emplace_back();
+	for (uint_fast8_t i = 0; i < 3; i++)
+		idx.push_back(FindOrAddVertex(q[3 * i], q[3 * i + 1], q[3 * i + 2]));
+}
+
+void FloatMesh::AddTriangle(const std::array<float, 9> &q,
+		const Geometry::Color &color) {
+	// The colors are only stored, once the first triangle has a color.
+	if (c.empty())
+		c.resize(CountTriangles());
+	c.push_back(color);
+	for (uint_fast8_t i = 0; i < 3; i++)
+		idx.push_back(FindOrAddVertex(q[3 * i], q[3 * i + 1], q[3 * i + 2]));
+}
+
+void FloatMesh::AddTriangles(const char *data, size_t count, size_t stride,
+		unsigned int threads) {
+	if (!p.empty()) {
+		// The vertices already in the mesh would have to be in the tables.
+		for (size_t i = 0; i < count; i++) {
+			std::array<float, 9> q;
+			std::memcpy(q.data(), data + i * stride, sizeof(q));
+			AddTriangle(q);
+		}
+		return;
+	}
+	const size_t C = 3 * count;
+	if (C >= UINT32_MAX) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The mesh has more than 2^32 corners.";
+		throw std::runtime_error(err.str());
+	}
+	idx.resize(C);
+	uint32_t *corner = idx.data();
+
+	auto Key = [&](size_t n) {
+		// Same key as in FindOrAddVertex().
+		float q[3];
+		std::memcpy(q, data + (n / 3) * stride + (n % 3) * sizeof(q),
+				sizeof(q));
+		std::array<uint32_t, 3> key;
+		for (uint_fast8_t i = 0; i < 3; i++)
+			q[i] += 0.0f;
+		std::memcpy(key.data(), q, sizeof(q));
+		return key;
+	};
+
+	// Every thread joins the corners with the hashes of its part. For every
+	// corner the first corner with the same coordinates is stored.
+	if (threads == 0)
+		threads = ThreadPool::GetThreads();
+	threads = (unsigned int) std::min<size_t>(threads,
+			std::max<size_t>(C / 65536, 1));
+	auto Join = [&](size_t part) {
+		struct Slot {
+			std::array<uint32_t, 3> key;
+			uint32_t first = UINT32_MAX;
+		};
+		// Closed meshes have about half as many vertices as triangles, i.e.
+		// a sixth of the corners.
+		size_t S = 1024;
+		while (S < C / (2 * threads))
+			S *= 2;
+		std::vector<Slot> table(S);
+		size_t mask = S - 1;
+		size_t used = 0;
+		const KeyHash hash;
+		for (size_t n = 0; n < C; n++) {
+			if ((n & 0xFFFF) == 0)
+				Cancellation::Check();
+			const std::array<uint32_t, 3> key = Key(n);
+			const size_t h = hash(key);
+			if (threads > 1 && (h >> 40) % threads != part)
+				continue;
+			size_t s = h & mask;
+			while (table[s].first != UINT32_MAX && table[s].key != key)
+				s = (s + 1) & mask;
+			if (table[s].first != UINT32_MAX) {
+				corner[n] = table[s].first;
+				continue;
+			}
+			table[s].key = key;
+			table[s].first = (uint32_t) n;
+			corner[n] = (uint32_t) n;
+			// Keep the table at most half full.
+			if (2 * (++used) > S) {
+				std::vector<Slot> temp(2 * S);
+				table.swap(temp);
+				S = table.size();
+				mask = S - 1;
+				for (const Slot &slot : temp) {
+					if (slot.first == UINT32_MAX)
+						continue;
+					size_t t = hash(slot.key) & mask;
+					while (table[t].first != UINT32_MAX)
+						t = (t + 1) & mask;
+					table[t] = slot;
+				}
+			}
+		}
+	};
+	ThreadPool::ForEach(threads, Join, threads);
+
+	// Number the vertices in the order of their first corner. The first
+	// corner always comes before the others.
+	size_t V = 0;
+	for (size_t n = 0; n < C; n++)
+		if (corner[n] == n)
+			V++;
+	p.resize(3 * V);
+	V = 0;
+	for (size_t n = 0; n < C; n++) {
+		if (corner[n] != n) {
+			corner[n] = corner[corner[n]];
+			continue;
+		}
+		std::memcpy(&p[3 * V],
+				data + (n / 3) * stride + (n % 3) * 3 * sizeof(float),
+				3 * sizeof(float));
+		corner[n] = (uint32_t) V++;
+	}
+}
+
+size_t FloatMesh::CountVertices() const {
+	return p.size() / 3;
+}
+
+size_t FloatMesh::CountTriangles() const {
+	return idx.size() / 3;
+}
+
+bool FloatMesh::HasColors() const {
+	return !c.empty();
+}
+
+size_t FloatMesh::GetMemoryUsage() const {
+	return sizeof(FloatMesh) + (p.capacity() + n.capacity()) * sizeof(float)
+			+ idx.capacity() * sizeof(uint32_t)
+			+ c.capacity() * sizeof(Geometry::Color)
+			+ vmap.size() * (sizeof(std::array<uint32_t, 3>) + sizeof(uint32_t)
+							+ 2 * sizeof(void*))
+			+ vmap.bucket_count() * sizeof(void*);
+}
+
+Vector3 FloatMesh::GetVertex(size_t index) const {
+	return Vector3(p[3 * index], p[3 * index + 1], p[3 * index + 2]);
+}
+
+void FloatMesh::Assign(const Geometry &geometry) {
+	Clear();
+	const size_t V = geometry.CountVertices();
+	const size_t T = geometry.CountTriangles();
+	if (V > UINT32_MAX) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The geometry has more than 2^32 vertices.";
+		throw std::runtime_error(err.str());
+	}
+	p.reserve(3 * V);
+	for (size_t i = 0; i < V; i++) {
+		const Geometry::Vertex &vert = geometry.GetVertex(i);
+		p.push_back((float) vert.x);
+		p.push_back((float) vert.y);
+		p.push_back((float) vert.z);
+	}
+	idx.reserve(3 * T);
+	c.reserve(T);
+	for (size_t i = 0; i < T; i++) {
+		const Geometry::Triangle &tri = geometry.GetTriangle(i);
+		idx.push_back((uint32_t) tri.GetVertexIndex(0));
+		idx.push_back((uint32_t) tri.GetVertexIndex(1));
+		idx.push_back((uint32_t) tri.GetVertexIndex(2));
+		c.push_back(tri.c);
+	}
+	CalculateNormals();
+}
+
+void FloatMesh::CopyTo(Geometry &geometry) const {
+	const size_t offset = geometry.CountVertices();
+	const size_t V = CountVertices();
+	for (size_t i = 0; i < V; i++)
+		geometry.AddVertex(GetVertex(i));
+	const size_t T = CountTriangles();
+	for (size_t i = 0; i < T; i++) {
+		if (HasColors())
+			geometry.SetAddColor(c[i].r, c[i].g, c[i].b, c[i].a);
+		geometry.AddTriangle(offset + idx[3 * i], offset + idx[3 * i + 1],
+				offset + idx[3 * i + 2]);
+	}
+	if (HasColors())
+		geometry.ResetAddColor();
+	geometry.Finish();
+}
+
+void FloatMesh::CalculateNormals() {
+	n.assign(p.size(), 0.0f);
+	const size_t T = CountTriangles();
+	for (size_t i = 0; i < T; i++) {
+		const uint32_t a = 3 * idx[3 * i];
+		const uint32_t b = 3 * idx[3 * i + 1];
+		const uint32_t d = 3 * idx[3 * i + 2];
+		// Accumulate in double, the cross product loses many digits.
+		const double x1 = (double) p[b] - p[a];
+		const double y1 = (double) p[b + 1] - p[a + 1];
+		const double z1 = (double) p[b + 2] - p[a + 2];
+		const double x2 = (double) p[d] - p[a];
+		const double y2 = (double) p[d + 1] - p[a + 1];
+		const double z2 = (double) p[d + 2] - p[a + 2];
+		const float cx = (float) (y1 * z2 - z1 * y2);
+		const float cy = (float) (z1 * x2 - x1 * z2);
+		const float cz = (float) (x1 * y2 - y1 * x2);
+		for (uint32_t k : { a, b, d }) {
+			n[k] += cx;
+			n[k + 1] += cy;
+			n[k + 2] += cz;
+		}
+	}
+	for (size_t k = 0; k < n.size(); k += 3) {
+		const float L = std::sqrt(
+				n[k] * n[k] + n[k + 1] * n[k + 1] + n[k + 2] * n[k + 2]);
+		if (L > 0.0f) {
+			n[k] /= L;
+			n[k + 1] /= L;
+			n[k + 2] /= L;
+		}
+	}
+}
+
+void FloatMesh::Shrink() {
+	std::unordered_map<std::array<uint32_t, 3>, uint32_t, KeyHash>().swap(
+			vmap);
+	p.shrink_to_fit();
+	n.shrink_to_fit();
+	idx.shrink_to_fit();
+	c.shrink_to_fit();
+}
+
+void FloatMesh::Paint() const {
+	const bool hasNormals = (n.size() == p.size());
+	glBegin(GL_TRIANGLES);
+	const size_t T = CountTriangles();
+	for (size_t i = 0; i < T; i++) {
+		if (HasColors())
+			glColor4f(c[i].r, c[i].g, c[i].b, c[i].a);
+		for (uint_fast8_t j = 0; j < 3; j++) {
+			const size_t k = 3 * (size_t) idx[3 * i + j];
+			if (hasNormals)
+				glNormal3fv(&n[k]);
+			glVertex3fv(&p[k]);
+		}
+	}
+	glEnd();
+}
+
+uint32_t FloatMesh::FindOrAddVertex(float x, float y, float z) {
+	// The vertices are compared by their bit pattern. -0.0f and 0.0f are
+	// mapped onto the same key.
+	std::array<uint32_t, 3> key;
+	const float q[3] = { x + 0.0f, y + 0.0f, z + 0.0f };
+	std::memcpy(key.data(), q, sizeof(q));
+	if (vmap.empty() && !p.empty()) {
+		// Rebuild the map after Shrink() or Assign().
+		for (size_t i = 0; i < CountVertices(); i++) {
+			std::array<uint32_t, 3> k;
+			const float r[3] = { p[3 * i] + 0.0f, p[3 * i + 1] + 0.0f,
+					p[3 * i + 2] + 0.0f };
+			std::memcpy(k.data(), r, sizeof(r));
+			vmap.emplace(k, (uint32_t) i);
+		}
+	}
+	auto it = vmap.find(key);
+	if (it != vmap.end())
+		return it->second;
+	if (CountVertices() >= UINT32_MAX) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The mesh has more than 2^32 vertices.";
+		throw std::runtime_error(err.str());
+	}
+	const uint32_t index = (uint32_t) CountVertices();
+	vmap.emplace(key, index);
+	p.push_back(x);
+	p.push_back(y);
+	p.push_back(z);
+	return index;
+}
+
+size_t FloatMesh::KeyHash::operator()(const std::array<uint32_t, 3> &k) const {
+	uint64_t h = k[0];
+	h = h * 0x9E3779B97F4A7C15ULL + k[1];
+	h = h * 0x9E3779B97F4A7C15ULL + k[2];
+	h ^= h >> 31;
+	return (size_t) h;
+}
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : FloatMesh.h
+// Purpose            : Indexed triangle mesh in single precision
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_FLOATMESH_H
+#define L3D_FLOATMESH_H
+
+/** \class FloatMesh
+ * 	\code #include "FloatMesh.h"\endcode
+ * 	\ingroup Base3D
+ *  \brief Indexed triangle mesh in single precision
+ *
+ * Storage for large scans, that are mostly displayed. A vertex needs 24
+ * bytes (position and normal as float), a triangle 12 bytes (three 32 bit
+ * indices) plus 16 bytes, if the triangles are colored. A Geometry needs
+ * about 100 bytes per vertex and 200 bytes per triangle plus the edges.
+ *
+ * STL files store float coordinates. FileSTL::Read(FloatMesh&) reads them
+ * without conversion and joins vertices with the exact same coordinates.
+ * The arrays can be passed to OpenGL as they are.
+ *
+ * For calculations the mesh is copied into a Geometry with CopyTo(). This
+ * converts to double precision.
+ */
+
+#include "Geometry.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class FloatMesh {
+public:
+	FloatMesh() = default;
+
+	void Clear();
+
+	/**\brief Add a triangle by the coordinates of its corners
+	 *
+	 * Corners with the exact same coordinates as an existing vertex reuse
+	 * that vertex.
+	 *
+	 * \param p Coordinates x, y, z of the three corners (counter-clockwise)
+	 */
+	void AddTriangle(const std::array<float, 9> &p);
+	void AddTriangle(const std::array<float, 9> &p,
+			const Geometry::Color &color);
+
+	/**\brief Add many triangles at once
+	 *
+	 * Gives the same mesh as calling AddTriangle() for every triangle, but
+	 * the arrays are allocated once and the vertices are joined by hash
+	 * tables, that are split over threads. The triangles are read directly
+	 * from memory, e.g. from a MappedFile.
+	 *
+	 * \param data Record of the first triangle, need not be aligned
+	 * \param count Number of triangles
+	 * \param stride Bytes from one record to the next, the first 9 floats of
+	 *               a record are x, y, z of the three corners
+	 * \param threads Number of threads, 0 for one per core
+	 */
+	void AddTriangles(const char *data, size_t count, size_t stride,
+			unsigned int threads = 0);
+
+	size_t CountVertices() const;
+	size_t CountTriangles() const;
+	bool HasColors() const;
+	size_t GetMemoryUsage() const; ///< Number of bytes used by the arrays.
+
+	Vector3 GetVertex(size_t index) const;
+
+	/**\brief Replace the mesh by a copy of a Geometry
+	 *
+	 * The colors of the triangles are copied. The normals are recalculated.
+	 */
+	void Assign(const Geometry &geometry);
+
+	/**\brief Append the mesh to a Geometry in double precision
+	 *
+	 * The vertices are added as they are and the triangles by index.
+	 * Afterwards Geometry::Finish() is called.
+	 */
+	void CopyTo(Geometry &geometry) const;
+
+	/**\brief Area weighted vertex normals
+	 */
+	void CalculateNormals();
+
+	/**\brief Release the map for joining vertices
+	 *
+	 * After loading a mesh the map is not needed anymore. AddTriangle()
+	 * rebuilds it if needed.
+	 */
+	void Shrink();
+
+	void Paint() const; ///< Paint the triangles with the current matrix.
+
+	std::vector<float> p; ///< Positions of the vertices: x, y, z, x, y, z, ...
+	std::vector<float> n; ///< Normals of the vertices: x, y, z, x, y, z, ...
+	std::vector<uint32_t> idx; ///< Three vertex indices per triangle
+	std::vector<Geometry::Color> c; ///< Colors of the triangles, may be empty
+
+private:
+	uint32_t FindOrAddVertex(float x, float y, float z);
+
+	struct KeyHash {
+		size_t operator()(const std::array<uint32_t, 3> &k) const;
+	};
+	std::unordered_map<std::array<uint32_t, 3>, uint32_t, KeyHash> vmap;
+};
+
+#endif /* L3D_FLOATMESH_H */
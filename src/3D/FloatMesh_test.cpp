@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : FloatMesh_test.cpp
+// Purpose            : Reading STL files into a FloatMesh
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "FloatMesh.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FileSTL.h"
+#include "Geometry.h"
+
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+class FloatMeshTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( FloatMeshTest );
+	CPPUNIT_TEST(testReadSTL);
+	CPPUNIT_TEST(testAddTriangles);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	void testReadSTL() {
+		// Closed torus with 2 * N * M triangles
+		const size_t N = 400;
+		const size_t M = 200;
+		Geometry geo;
+		auto P = [](size_t i, size_t j) {
+			const double a = 2.0 * M_PI * (double) (i % N) / (double) N;
+			const double b = 2.0 * M_PI * (double) (j % M) / (double) M;
+			const double r = 0.1 + 0.03 * std::cos(b);
+			return Vector3(r * std::cos(a), r * std::sin(a),
+					0.03 * std::sin(b));
+		};
+		for (size_t i = 0; i < N; i++)
+			for (size_t j = 0; j < M; j++) {
+				geo.AddTriangle(P(i, j), P(i + 1, j), P(i + 1, j + 1));
+				geo.AddTriangle(P(i, j), P(i + 1, j + 1), P(i, j + 1));
+			}
+		geo.Finish();
+		geo.CalculateNormals();
+
+		const std::string filename = (std::filesystem::temp_directory_path()
+				/ "FloatMesh_test.stl").string();
+		{
+			FileSTL stl(filename);
+			stl.Write(geo);
+		}
+
+		Geometry full;
+		{
+			FileSTL stl(filename);
+			stl.Read(full);
+		}
+		FloatMesh mesh;
+		{
+			FileSTL stl(filename);
+			stl.Read(mesh);
+		}
+		std::remove(filename.c_str());
+
+		CPPUNIT_ASSERT_EQUAL(N * M, mesh.CountVertices());
+		CPPUNIT_ASSERT_EQUAL(2 * N * M, mesh.CountTriangles());
+		CPPUNIT_ASSERT_EQUAL(full.CountVertices(), mesh.CountVertices());
+
+		Geometry expanded;
+		mesh.CopyTo(expanded);
+		expanded.CalculateNormals();
+		CPPUNIT_ASSERT_EQUAL(full.CountTriangles(), expanded.CountTriangles());
+		CPPUNIT_ASSERT_EQUAL(true, expanded.IsClosed());
+		CPPUNIT_ASSERT_EQUAL(true,
+				std::fabs(expanded.GetVolume() - full.GetVolume()) < 1e-12);
+
+		std::cout << "\nSTL with " << mesh.CountTriangles()
+				<< " triangles: Geometry " << full.GetMemoryUsage() / 1048576
+				<< " MiB, FloatMesh " << mesh.GetMemoryUsage() / 1048576
+				<< " MiB.\n";
+	}
+
+	void testAddTriangles() {
+		// Records of 50 bytes like in a binary STL file, sphere of 2 * N * N
+		// triangles
+		const size_t N = 300;
+		auto P = [](size_t i, size_t j, char *q) {
+			const double u = 2.0 * M_PI * (double) i / N;
+			const double v = M_PI * ((double) j + 0.5) / (N + 1);
+			const float r[3] = { (float) (std::cos(u) * std::sin(v)),
+					(float) (std::sin(u) * std::sin(v)), (float) std::cos(v) };
+			std::memcpy(q, r, sizeof(r));
+		};
+		std::string data(2 * N * N * 50, '\0');
+		for (size_t j = 0; j < N; j++)
+			for (size_t i = 0; i < N; i++) {
+				char *q = &data[(2 * (j * N + i)) * 50 + 12];
+				P(i, j, q);
+				P(i, j + 1, q + 12);
+				P(i + 1, j + 1, q + 24);
+				P(i, j, q + 50);
+				P(i + 1, j + 1, q + 62);
+				P(i + 1, j, q + 74);
+			}
+
+		FloatMesh reference;
+		StopWatch sw0;
+		sw0.Start();
+		for (size_t i = 0; i < 2 * N * N; i++) {
+			std::array<float, 9> q;
+			std::memcpy(q.data(), &data[i * 50 + 12], sizeof(q));
+			reference.AddTriangle(q);
+		}
+		sw0.Stop();
+		std::cout << "\n" << 2 * N * N << " triangles: AddTriangle "
+				<< sw0.GetSecondsWall() << " s";
+		for (unsigned int threads : { 1, 4 }) {
+			FloatMesh mesh;
+			StopWatch sw1;
+			sw1.Start();
+			mesh.AddTriangles(&data[12], 2 * N * N, 50, threads);
+			sw1.Stop();
+			CPPUNIT_ASSERT(mesh.p == reference.p);
+			CPPUNIT_ASSERT(mesh.idx == reference.idx);
+			std::cout << ", AddTriangles (" << threads << " threads) "
+					<< sw1.GetSecondsWall() << " s";
+		}
+		std::cout << "\n";
+
+		// A truncated file is detected before reading the triangles.
+		std::stringstream stream;
+		stream << std::string(80, ' ');
+		const uint32_t count = 10;
+		stream.write(reinterpret_cast<const char*>(&count), sizeof count);
+		stream << data.substr(0, 9 * 50);
+		FileSTL stl(&stream);
+		FloatMesh mesh;
+		CPPUNIT_ASSERT_THROW(stl.Read(mesh), std::runtime_error);
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FloatMeshTest);
+#endif
@@ -26,13 +26,18 @@
 
 #include "Geometry.h"
 
+#include "BVH.h"
+#include "MeshView.h"
 #include "Polygon3.h"
+#include "../system/ThreadPool.h"
 
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <numeric>
 #include <regex>
 #include <utility>
@@ -364,8 +369,13 @@ void Geometry::SetEpsilon(double newEpsilon) {
 	epsilon = newEpsilon;
 }
 
+void Geometry::SetWeldMethod(WeldMethod method) {
+	weldMethod = method;
+}
+
 void Geometry::CopyPropertiesFrom(const Geometry &other) {
 	epsilon = other.epsilon;
+	weldMethod = other.weldMethod;
 	this->verticesHaveNormal = other.verticesHaveNormal;
 	this->verticesHaveColor = other.verticesHaveColor;
 	this->edgesHaveNormal = other.edgesHaveNormal;
@@ -385,6 +395,7 @@ void Geometry::CopyPropertiesFrom(const Geometry &other) {
 }
 
 void Geometry::Clear() {
+	InvalidateCache();
 	v.clear();
 	e.clear();
 	t.clear();
@@ -474,7 +485,14 @@ void Geometry::ResetPresets() {
 	ResetAddMatrix();
 }
 
+void Geometry::Reserve(size_t vertices, size_t edges, size_t triangles) {
+	v.reserve(vertices);
+	e.reserve(edges);
+	t.reserve(triangles);
+}
+
 void Geometry::AddVertex(const Geometry::Vertex &vertex) {
+	InvalidateCache();
 	Geometry::Vertex temp = vertex;
 
 	if (addColors)
@@ -573,7 +591,7 @@ void Geometry::AddTriangle(size_t vidx0, size_t vidx1, size_t vidx2) {
 }
 
 void Geometry::AddTriangleFromEdges(size_t eidx0, size_t eidx1, size_t eidx2) {
-
+	InvalidateCache();
 	Geometry::Edge &edge0 = e[eidx0];
 	Geometry::Edge &edge1 = e[eidx1];
 	Geometry::Edge &edge2 = e[eidx2];
@@ -676,6 +694,7 @@ void Geometry::AddQuad(size_t idx0, size_t idx1, size_t idx2, size_t idx3) {
 
 void Geometry::AddVertexWithIndex(const Geometry::Vertex &vertex,
 		size_t sourceIndex) {
+	InvalidateCache();
 	verticesHaveNormal |= addNormals;
 	verticesHaveColor |= addColors;
 	if (sourceIndex != nothing) {
@@ -709,6 +728,7 @@ void Geometry::AddEdgeWithIndex(const Geometry::Edge &edge,
 
 void Geometry::AddTriangleWithIndex(const Geometry::Triangle &triangle,
 		size_t sourceIndex) {
+	InvalidateCache();
 	trianglesHaveNormal |= addNormals;
 	trianglesHaveColor |= addColors;
 	if (sourceIndex != nothing) {
@@ -724,6 +744,7 @@ void Geometry::AddTriangleWithIndex(const Geometry::Triangle &triangle,
 }
 
 void Geometry::AddFrom(const Geometry &other) {
+	InvalidateCache();
 	vmap.clear();
 	emap.clear();
 	tmap.clear();
@@ -753,6 +774,7 @@ void Geometry::AddFrom(const Geometry &other) {
 }
 
 void Geometry::AddSelectedFrom(const Geometry &other) {
+	InvalidateCache();
 	vmap.assign(other.v.size(), nothing);
 	emap.assign(other.e.size(), nothing);
 	tmap.assign(other.t.size(), nothing);
@@ -829,6 +851,7 @@ void Geometry::FlipMap() {
 }
 
 void Geometry::Remap(int vstart, int estart, int tstart) {
+	InvalidateCache();
 	if (!vmap.empty()) {
 		for (std::vector<Edge>::iterator ed = e.begin() + estart; ed != e.end();
 				ed++) {
@@ -897,6 +920,7 @@ void Geometry::Remap(int vstart, int estart, int tstart) {
 }
 
 void Geometry::Fix() {
+	InvalidateCache();
 	for (Edge &ed : e)
 		ed.Fix();
 	for (Triangle &tri : t)
@@ -904,6 +928,7 @@ void Geometry::Fix() {
 }
 
 void Geometry::Sort() {
+	InvalidateCache();
 	// Note, that the lambdas below are different to the lambdas in Join().
 	auto vertex_less = [eps=epsilon, &vref=v](const size_t &idxa,
 			const size_t &idxb) {
@@ -997,14 +1022,7 @@ void Geometry::Sort() {
 		ed.Fix();
 }
 
-void Geometry::Join() {
-	vmap.clear();
-	emap.clear();
-	tmap.clear();
-
-	if (v.empty())
-		return;
-
+void Geometry::JoinVerticesSort() {
 	auto vertex_less = [eps = epsilon](const Vector3 &a, const Vector3 &b) {
 		if (a.x < (b.x - eps))
 			return true;
@@ -1035,6 +1053,125 @@ void Geometry::Join() {
 		return true;
 	};
 
+	vmap.assign(v.size(), nothing);
+	std::sort(v.begin(), v.end(), vertex_less);
+	size_t j = 0;
+	vmap[v[j].group] = j;
+	for (size_t i = 1; i < v.size(); i++) {
+		if (vertex_equal(v[j], v[i])) {
+			v[j].n += v[i].n;
+			vmap[v[i].group] = j;
+		} else {
+			j++;
+			v[j] = v[i];
+			vmap[v[j].group] = j;
+		}
+	}
+	v.erase(v.begin() + (int) j + 1, v.end());
+}
+
+void Geometry::JoinVerticesGrid() {
+	// The space is divided into cubic cells with a side length of two times
+	// epsilon. Vertices closer than epsilon are either in the same cell or in
+	// the neighbouring cells on the side of the half the vertex is in. So only
+	// 8 cells have to be searched. The own cell is searched first, because
+	// most duplicated vertices (e.g. from STL files) are found there.
+	//
+	// The joined vertices are stored in a hash table with open addressing.
+	// Collisions only cost time, because the distance of the vertices is
+	// tested anyway.
+
+	auto vertex_equal = [eps = epsilon](const Vector3 &a, const Vector3 &b) {
+		return std::fabs(a.x - b.x) <= eps && std::fabs(a.y - b.y) <= eps
+				&& std::fabs(a.z - b.z) <= eps;
+	};
+
+	auto cell_hash = [](int64_t i, int64_t j, int64_t k) {
+		uint64_t h = (uint64_t) i * 0x9E3779B97F4A7C15ULL;
+		h ^= (uint64_t) j * 0xC2B2AE3D27D4EB4FULL;
+		h ^= (uint64_t) k * 0x165667B19E3779F9ULL;
+		h ^= h >> 32;
+		h *= 0xD6E8FEB86659FD93ULL;
+		h ^= h >> 32;
+		return (size_t) h;
+	};
+
+	struct Slot {
+		size_t hash = 0;
+		size_t vertex = nothing;
+	};
+	std::vector<Slot> table(1024);
+	size_t mask = table.size() - 1;
+
+	auto find = [&](size_t hash, const Vector3 &p) {
+		for (size_t s = hash & mask; table[s].vertex != nothing;
+				s = (s + 1) & mask)
+			if (table[s].hash == hash && vertex_equal(v[table[s].vertex], p))
+				return table[s].vertex;
+		return nothing;
+	};
+	auto insert = [&](size_t hash, size_t vertex) {
+		size_t s = hash & mask;
+		while (table[s].vertex != nothing)
+			s = (s + 1) & mask;
+		table[s].hash = hash;
+		table[s].vertex = vertex;
+	};
+
+	const size_t N = v.size();
+	const double scale = 0.5 / epsilon;
+	vmap.assign(N, nothing);
+	size_t j = 0;
+	for (size_t i = 0; i < N; i++) {
+		const double fx = v[i].x * scale;
+		const double fy = v[i].y * scale;
+		const double fz = v[i].z * scale;
+		const int64_t cx = (int64_t) std::floor(fx);
+		const int64_t cy = (int64_t) std::floor(fy);
+		const int64_t cz = (int64_t) std::floor(fz);
+		const int64_t dx = (fx - (double) cx < 0.5) ? -1 : 1;
+		const int64_t dy = (fy - (double) cy < 0.5) ? -1 : 1;
+		const int64_t dz = (fz - (double) cz < 0.5) ? -1 : 1;
+
+		const size_t hash = cell_hash(cx, cy, cz);
+		size_t found = find(hash, v[i]);
+		for (uint8_t n = 1; n < 8 && found == nothing; n++)
+			found = find(
+					cell_hash(cx + ((n & 1) ? dx : 0), cy + ((n & 2) ? dy : 0),
+							cz + ((n & 4) ? dz : 0)), v[i]);
+
+		if (found != nothing) {
+			v[found].n += v[i].n;
+			vmap[i] = found;
+			continue;
+		}
+		if (j != i)
+			v[j] = v[i];
+		// Keep the table at most half full.
+		if (2 * (j + 1) > table.size()) {
+			std::vector<Slot> temp(2 * table.size());
+			table.swap(temp);
+			mask = table.size() - 1;
+			for (const Slot &slot : temp)
+				if (slot.vertex != nothing)
+					insert(slot.hash, slot.vertex);
+		}
+		insert(hash, j);
+		vmap[i] = j;
+		j++;
+	}
+	v.erase(v.begin() + (int) j, v.end());
+}
+
+void Geometry::Join() {
+	InvalidateCache();
+	vmap.clear();
+	emap.clear();
+	tmap.clear();
+
+	if (v.empty())
+		return;
+
 	auto edge_less = [](const Edge &a, const Edge &b) {
 		if (a.va < b.va)
 			return true;
@@ -1078,21 +1215,10 @@ void Geometry::Join() {
 	// Remove duplicated vertices
 
 	if (!v.empty()) {
-		vmap.assign(v.size(), nothing);
-		std::sort(v.begin(), v.end(), vertex_less);
-		size_t j = 0;
-		vmap[v[j].group] = j;
-		for (size_t i = 1; i < v.size(); i++) {
-			if (vertex_equal(v[j], v[i])) {
-				v[j].n += v[i].n;
-				vmap[v[i].group] = j;
-			} else {
-				j++;
-				v[j] = v[i];
-				vmap[v[j].group] = j;
-			}
-		}
-		v.erase(v.begin() + (int) j + 1, v.end());
+		if (weldMethod == WeldMethod::Grid && epsilon > 0.0)
+			JoinVerticesGrid();
+		else
+			JoinVerticesSort();
 
 		// Normalize normal vectors.
 		if (verticesHaveNormal)
@@ -1215,6 +1341,7 @@ void Geometry::Finish() {
 }
 
 void Geometry::CleanupVertices() {
+	InvalidateCache();
 	vmap.clear();
 	emap.clear();
 	tmap.clear();
@@ -1737,6 +1864,7 @@ void Geometry::FlipNormals() {
 }
 
 void Geometry::FlipInsideOutside() {
+	InvalidateCache();
 	for (Edge &ed : e)
 		ed.flip = !ed.flip;
 	for (Triangle &tri : t)
@@ -2207,6 +2335,16 @@ size_t Geometry::CountTriangles() const {
 	return t.size();
 }
 
+size_t Geometry::GetMemoryUsage() const {
+	const std::shared_ptr<const BVH> tree = std::atomic_load(&bvh);
+	const std::shared_ptr<const MeshView> view = std::atomic_load(&meshView);
+	return sizeof(Geometry) + v.capacity() * sizeof(Vertex)
+			+ e.capacity() * sizeof(Edge) + t.capacity() * sizeof(Triangle)
+			+ (vmap.capacity() + emap.capacity() + tmap.capacity())
+					* sizeof(size_t) + (tree ? tree->GetMemoryUsage() : 0)
+			+ (view ? view->GetMemoryUsage() : 0);
+}
+
 const Geometry::Vertex& Geometry::operator [](size_t index) const {
 	return v[index];
 }
@@ -2262,6 +2400,7 @@ const Geometry::Vertex& Geometry::GetTriangleVertex(const size_t indexTriangle,
 }
 
 void Geometry::Transform(const AffineTransformMatrix &matrix) {
+	InvalidateCache();
 	AffineTransformMatrix::Orientation orientation = matrix.CheckOrientation();
 
 	AffineTransformMatrix matrixnormal = matrix.GetNormalMatrix();
@@ -2287,6 +2426,7 @@ void Geometry::Transform(const AffineTransformMatrix &matrix) {
 }
 
 void Geometry::Transform(std::function<Vector3(Vector3)> func) {
+	InvalidateCache();
 	//TODO Modify the normals as well.
 	for (Vertex &vertex : v) {
 		//FIXME Check if the temp vector is still needed
@@ -2366,41 +2506,11 @@ Vector3 Geometry::GetCenterOfMass() const {
 }
 
 double Geometry::GetArea() const {
-	double A = 0.0;
-	for (const Triangle &tri : t) {
-		const Vertex &v0 = v[tri.GetVertexIndex(0)];
-		const Vertex &v1 = v[tri.GetVertexIndex(1)];
-		const Vertex &v2 = v[tri.GetVertexIndex(2)];
-		const Vector3 d1 = v1 - v0;
-		const Vector3 d2 = v2 - v0;
-		const Vector3 x = d1 * d2;
-		A += x.Abs();
-	}
-	return A / 2.0;
+	return GetMeshView()->GetArea();
 }
 
 double Geometry::GetVolume() const {
-	double V = 0.0;
-	for (const Triangle &tri : t) {
-		const Vertex &v0 = v[tri.GetVertexIndex(0)];
-		const Vertex &v1 = v[tri.GetVertexIndex(1)];
-		const Vertex &v2 = v[tri.GetVertexIndex(2)];
-		// Fricas code:
-		// )set fortran optlevel 2
-		// )set output fortran on
-		//	v321 := v2x*v1y*v0z
-		//	v231 := v1x*v2y*v0z
-		//	v312 := v2x*v0y*v1z
-		//	v132 := v0x*v2y*v1z
-		//	v213 := v1x*v0y*v2z
-		//	v123 := v0x*v1y*v2z
-		//	(-v321 + v231 + v312 - v132 - v213 + v123)
-		double Vt = (v0.x * v1.y - v0.y * v1.x) * v2.z
-				+ (-v0.x * v1.z + v0.z * v1.x) * v2.y
-				+ (v0.y * v1.z - v0.z * v1.y) * v2.x;
-		V += Vt;
-	}
-	return V / 6.0;
+	return GetMeshView()->GetVolume();
 }
 
 double Geometry::GetNormalCurvature() const {
@@ -2432,112 +2542,164 @@ Polygon3 Geometry::IntersectPlane(const Vector3 &n_, double d) const {
 	Vector3 n_unit = n_.Normal();
 	Polygon3 temp;
 
-	// Map all vertices onto the plane normal, shift by d.
+	// Only the triangles reaching the plane are checked, if the vertices of
+	// the triangle intersect with the plane. i.e. two vertices are on one side
+	// and one is on the other side of the plane.
+	const std::vector<size_t> candidates = GetBVH()->FindInSlab(v, t, n_unit,
+			d - DBL_EPSILON, d + DBL_EPSILON);
+	for (size_t it : candidates) {
+		const Triangle &tri = t[it];
+		// Map the vertices onto the plane normal, shift by d.
+		const double da = v[tri.va].Dot(n_unit) - d;
+		const double db = v[tri.vb].Dot(n_unit) - d;
+		const double dc = v[tri.vc].Dot(n_unit) - d;
+		CutTriangle(temp, tri, da, db, dc);
+	}
+	FinishSection(temp, n_unit);
+	return temp;
+}
+
+std::vector<Polygon3> Geometry::IntersectPlanes(const Vector3 &n_,
+		const std::vector<double> &d, bool parallel) const {
+	const Vector3 n_unit = n_.Normal();
+	std::vector<Polygon3> ret(d.size());
+	if (d.empty())
+		return ret;
+
+	// Map all vertices onto the plane normal once.
 	std::vector<double> vd;
-	vd.reserve(v.size());
-	for (const Vertex &vert : v) {
-		const double h = vert.Dot(n_unit) - d;
-		vd.push_back(h);
-	}
+	GetMeshView()->Project(n_unit, vd);
+
+	// Sort the triangles into buckets, one for each plane they reach.
+	std::vector<size_t> order(d.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&d](size_t a, size_t b) {
+		return d[a] < d[b];
+	});
+	std::vector<double> ds;
+	ds.reserve(d.size());
+	for (size_t k : order)
+		ds.push_back(d[k]);
+	std::vector<std::vector<size_t>> bucket(d.size());
+	for (size_t it = 0; it < t.size(); it++) {
+		const double da = vd[t[it].va];
+		const double db = vd[t[it].vb];
+		const double dc = vd[t[it].vc];
+		const double hmin = std::fmin(da, std::fmin(db, dc));
+		const double hmax = std::fmax(da, std::fmax(db, dc));
+		auto p = std::lower_bound(ds.begin(), ds.end(), hmin - DBL_EPSILON);
+		for (; p != ds.end() && *p <= hmax + DBL_EPSILON; ++p)
+			bucket[order[p - ds.begin()]].push_back(it);
+	}
+
+	auto Section = [&](size_t k) {
+		Polygon3 &temp = ret[k];
+		for (size_t it : bucket[k]) {
+			const Triangle &tri = t[it];
+			CutTriangle(temp, tri, vd[tri.va] - d[k], vd[tri.vb] - d[k],
+					vd[tri.vc] - d[k]);
+		}
+		FinishSection(temp, n_unit);
+	};
 
-	// Check all triangles, if the vertices of the triangle intersect with the
-	// plane. i.e. two vertices are on one side and one is on the other side
-	// of the plane.
-	for (const Triangle &tri : t) {
-		const size_t va = tri.va;
-		const size_t vb = tri.vb;
-		const size_t vc = tri.vc;
+	// Every thread takes the next plane, until all are done.
+	ThreadPool::ForEach(d.size(), Section, parallel ? 0 : 1);
+	return ret;
+}
 
-		const double da = vd[va];
-		const double db = vd[vb];
-		const double dc = vd[vc];
+void Geometry::CutTriangle(Polygon3 &temp, const Triangle &tri, double da,
+		double db, double dc) const {
+	const size_t va = tri.va;
+	const size_t vb = tri.vb;
+	const size_t vc = tri.vc;
 
-		// Two vertices might sit on the plane if one edge is in the plane.
-		if (da < DBL_EPSILON && db < DBL_EPSILON && dc < DBL_EPSILON)
-			continue;
-		if (da > -DBL_EPSILON && db > -DBL_EPSILON && dc > -DBL_EPSILON)
-			continue;
+	// Two vertices might sit on the plane if one edge is in the plane.
+	if (da < DBL_EPSILON && db < DBL_EPSILON && dc < DBL_EPSILON)
+		return;
+	if (da > -DBL_EPSILON && db > -DBL_EPSILON && dc > -DBL_EPSILON)
+		return;
 
-		Vertex vea;
-		Vertex veb;
-		int8_t ia = -1;
-		int8_t ib = -1;
-		int8_t dira = 0;
-		int8_t dirb = 0;
-
-		// Find the edges, that need to be cut.
-		if ((da <= DBL_EPSILON && db > DBL_EPSILON)
-				|| (db <= DBL_EPSILON && da > DBL_EPSILON)) {
-			const double f =
-					(fabs(da - db) < DBL_EPSILON) ? (0.5) : (da / (da - db));
-			vea = v[va].Interp(v[vb], f);
-			ia = 0;
-			dira = (da <= DBL_EPSILON) ? 1 : -1;
-			if (e[tri.ea].sharp)
+	Vertex vea;
+	Vertex veb;
+	int8_t ia = -1;
+	int8_t ib = -1;
+	int8_t dira = 0;
+	int8_t dirb = 0;
+
+	// Find the edges, that need to be cut.
+	if ((da <= DBL_EPSILON && db > DBL_EPSILON)
+			|| (db <= DBL_EPSILON && da > DBL_EPSILON)) {
+		const double f =
+				(fabs(da - db) < DBL_EPSILON) ? (0.5) : (da / (da - db));
+		vea = v[va].Interp(v[vb], f);
+		ia = 0;
+		dira = (da <= DBL_EPSILON) ? 1 : -1;
+		if (e[tri.ea].sharp)
+			vea.n = tri.n;
+		else
+			vea.n = e[tri.ea].n;
+	}
+	if ((db <= DBL_EPSILON && dc > DBL_EPSILON)
+			|| (dc <= DBL_EPSILON && db > DBL_EPSILON)) {
+		const double f =
+				(fabs(db - dc) < DBL_EPSILON) ? (0.5) : (db / (db - dc));
+		if (ia == -1) {
+			vea = v[vb].Interp(v[vc], f);
+			ia = 1;
+			dira = (db <= DBL_EPSILON) ? 1 : -1;
+			if (e[tri.eb].sharp)
 				vea.n = tri.n;
 			else
-				vea.n = e[tri.ea].n;
-		}
-		if ((db <= DBL_EPSILON && dc > DBL_EPSILON)
-				|| (dc <= DBL_EPSILON && db > DBL_EPSILON)) {
-			const double f =
-					(fabs(db - dc) < DBL_EPSILON) ? (0.5) : (db / (db - dc));
-			if (ia == -1) {
-				vea = v[vb].Interp(v[vc], f);
-				ia = 1;
-				dira = (db <= DBL_EPSILON) ? 1 : -1;
-				if (e[tri.eb].sharp)
-					vea.n = tri.n;
-				else
-					vea.n = e[tri.eb].n;
-			} else {
-				veb = v[vb].Interp(v[vc], f);
-				ib = 1;
-				dirb = (db <= DBL_EPSILON) ? 1 : -1;
-				if (e[tri.eb].sharp)
-					veb.n = tri.n;
-				else
-					veb.n = e[tri.eb].n;
-			}
-		}
-		if ((dc <= DBL_EPSILON && da > DBL_EPSILON)
-				|| (da <= DBL_EPSILON && dc > DBL_EPSILON)) {
-			const double f =
-					(fabs(dc - da) < DBL_EPSILON) ? (0.5) : (dc / (dc - da));
-			if (ia == -1) {
-				vea = v[vc].Interp(v[va], f);
-				ia = 2;
-				dira = (dc <= DBL_EPSILON) ? 1 : -1;
-				if (e[tri.ec].sharp)
-					vea.n = tri.n;
-				else
-					vea.n = e[tri.ec].n;
-			} else {
-				veb = v[vc].Interp(v[va], f);
-				ib = 2;
-				dirb = (dc <= DBL_EPSILON) ? 1 : -1;
-				if (e[tri.ec].sharp)
-					veb.n = tri.n;
-				else
-					veb.n = e[tri.ec].n;
-			}
+				vea.n = e[tri.eb].n;
+		} else {
+			veb = v[vb].Interp(v[vc], f);
+			ib = 1;
+			dirb = (db <= DBL_EPSILON) ? 1 : -1;
+			if (e[tri.eb].sharp)
+				veb.n = tri.n;
+			else
+				veb.n = e[tri.eb].n;
+		}
+	}
+	if ((dc <= DBL_EPSILON && da > DBL_EPSILON)
+			|| (da <= DBL_EPSILON && dc > DBL_EPSILON)) {
+		const double f =
+				(fabs(dc - da) < DBL_EPSILON) ? (0.5) : (dc / (dc - da));
+		if (ia == -1) {
+			vea = v[vc].Interp(v[va], f);
+			ia = 2;
+			dira = (dc <= DBL_EPSILON) ? 1 : -1;
+			if (e[tri.ec].sharp)
+				vea.n = tri.n;
+			else
+				vea.n = e[tri.ec].n;
+		} else {
+			veb = v[vc].Interp(v[va], f);
+			ib = 2;
+			dirb = (dc <= DBL_EPSILON) ? 1 : -1;
+			if (e[tri.ec].sharp)
+				veb.n = tri.n;
+			else
+				veb.n = e[tri.ec].n;
 		}
-		const size_t idx = temp.v.size();
-		temp.AddVertex(vea);
-		temp.AddVertex(veb);
+	}
+	const size_t idx = temp.v.size();
+	temp.AddVertex(vea);
+	temp.AddVertex(veb);
 
-		if (tri.flip)
-			dira = -dira;
-		if (dira < 0)
-			temp.AddEdge(idx, idx + 1);
-		else
-			temp.AddEdge(idx + 1, idx);
+	if (tri.flip)
+		dira = -dira;
+	if (dira < 0)
+		temp.AddEdge(idx, idx + 1);
+	else
+		temp.AddEdge(idx + 1, idx);
 
 //			temp.e.back().flip = !temp.e.back().flip;
-		temp.e.back().n = tri.n;
-		temp.e.back().c = tri.c;
-	}
+	temp.e.back().n = tri.n;
+	temp.e.back().c = tri.c;
+}
 
+void Geometry::FinishSection(Polygon3 &temp, const Vector3 &n_unit) {
 #ifndef NDEBUG
 	// Correctness has to be checked before joining the vertices.
 	int edge_correct = 0;
@@ -2562,7 +2724,6 @@ Polygon3 Geometry::IntersectPlane(const Vector3 &n_, double d) const {
 #endif
 	temp.Join();
 	temp.SortLoop();
-	return temp;
 }
 
 /*
@@ -2662,26 +2823,57 @@ Polygon3 Geometry::IntersectPlane(const Vector3 &n_, double d) const {
  */
 
 Vector3 Geometry::IntersectArrow(const Vector3 &p0, const Vector3 &dir) const {
-
-	// TODO Change to ranged loop.
-	for (size_t i = 0; i < t.size(); i++) {
-		const Vertex a = GetTriangleVertex(i, 0);
-		const Vertex b = GetTriangleVertex(i, 1);
-		const Vertex c = GetTriangleVertex(i, 2);
-		// Check if point of (p0 + x*dir) lies inside the triangle
-		if (((b - a) * (p0 - a)).Dot(dir) < 0)
-			continue;
-		if (((c - b) * (p0 - b)).Dot(dir) < 0)
-			continue;
-		if (((a - c) * (p0 - c)).Dot(dir) < 0)
-			continue;
-		// Find intersection point
-		// solve((p0x+x*dirx)*nx + (p0y+x*diry)*ny + (p0z+x*dirz)*nz = ax*nx + ay*ny + az*nz, x);
-		const double den = (t[i].n).Dot(dir);
-		const double x = (t[i].n).Dot(a - p0) / den;
-		return p0 + dir * x;
-	}
-	return Vector3();
+	// Search forward and backward along the line. Only the surface facing in
+	// the direction of dir is considered.
+	const std::shared_ptr<const BVH> tree = GetBVH();
+	const BVH::Hit forward = tree->IntersectRay(v, t, p0, dir, 1);
+	const BVH::Hit backward = tree->IntersectRay(v, t, p0, -dir, -1);
+	if (forward.triangle == nothing && backward.triangle == nothing)
+		return Vector3();
+	if (backward.triangle == nothing
+			|| (forward.triangle != nothing && forward.t <= backward.t))
+		return forward.p;
+	return backward.p;
+}
+
+Vector3 Geometry::ClosestPointOnSurface(const Vector3 &p) const {
+	const BVH::Hit hit = GetBVH()->ClosestPoint(v, t, p);
+	if (hit.triangle == nothing)
+		return Vector3();
+	return hit.p;
+}
+
+std::shared_ptr<const BVH> Geometry::GetBVH() const {
+	// Several threads may query the same geometry. If they build the tree at
+	// the same time, one of the trees is kept.
+	std::shared_ptr<const BVH> tree = std::atomic_load(&bvh);
+	if (tree && tree->CountTriangles() == t.size())
+		return tree;
+	tree = std::make_shared<const BVH>(v, t);
+	std::atomic_store(&bvh, tree);
+	return tree;
+}
+
+std::shared_ptr<const MeshView> Geometry::GetMeshView() const {
+	// The counts catch vertices and triangles, that derived classes append
+	// without calling InvalidateCache().
+	std::shared_ptr<const MeshView> view = std::atomic_load(&meshView);
+	if (view && view->CountVertices() == v.size()
+			&& view->CountTriangles() == t.size())
+		return view;
+	view = std::make_shared<const MeshView>(*this);
+	std::atomic_store(&meshView, view);
+	return view;
+}
+
+void Geometry::InvalidateCache() {
+	// Called by the functions modifying the positions or the triangles.
+	// Modifying the geometry excludes concurrent queries, so the pointers can
+	// be checked without locking.
+	if (bvh)
+		bvh.reset();
+	if (meshView)
+		meshView.reset();
 }
 
 size_t Geometry::Select(const std::set<size_t> &select) {
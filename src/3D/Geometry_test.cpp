@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Geometry_test.cpp
+// Purpose            : Joining of vertices in the Geometry
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "Geometry.h"
+#include "Polygon3.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+class GeometryTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( GeometryTest );
+	CPPUNIT_TEST(testJoin);
+	CPPUNIT_TEST(testJoinBoundary);
+	CPPUNIT_TEST(testJoinSpeed);
+	CPPUNIT_TEST(testIntersectPlanes);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief Triangle soup of a wavy surface, like in an STL file
+	 *
+	 * Every triangle has its own vertices. The vertices are moved by up to
+	 * 'jitter' in every direction.
+	 */
+	static void AddSurface(Geometry &geo, size_t N, size_t M, double jitter) {
+		std::mt19937 gen { 1234321 };
+		std::uniform_real_distribution<double> dist { -jitter, jitter };
+		auto P = [&](size_t i, size_t j) {
+			return Geometry::Vertex((double) i * 1e-3 + dist(gen),
+					(double) j * 1e-3 + dist(gen),
+					0.1 * std::sin((double) i * 0.01) + dist(gen));
+		};
+		for (size_t i = 0; i < N; i++)
+			for (size_t j = 0; j < M; j++) {
+				geo.AddTriangle(P(i, j), P(i + 1, j), P(i + 1, j + 1));
+				geo.AddTriangle(P(i, j), P(i + 1, j + 1), P(i, j + 1));
+			}
+	}
+
+	void testJoin() {
+		for (auto method : { Geometry::WeldMethod::Sort,
+				Geometry::WeldMethod::Grid }) {
+			Geometry geo;
+			geo.SetEpsilon(1e-6);
+			geo.SetWeldMethod(method);
+			AddSurface(geo, 50, 40, 2e-7);
+			geo.Join();
+			CPPUNIT_ASSERT_EQUAL((size_t) 51 * 41, geo.CountVertices());
+			CPPUNIT_ASSERT_EQUAL((size_t) 2 * 50 * 40, geo.CountTriangles());
+			CPPUNIT_ASSERT_EQUAL(true, geo.PassedSelfCheck());
+		}
+	}
+
+	void testJoinBoundary() {
+		const double eps = 1e-3;
+		{
+			// Close vertices on both sides of a cell border.
+			Geometry geo;
+			geo.SetEpsilon(eps);
+			geo.SetWeldMethod(Geometry::WeldMethod::Grid);
+			geo.AddVertex(Geometry::Vertex(1.7e-3, 0.0, 0.0));
+			geo.AddVertex(Geometry::Vertex(2.3e-3, -0.1e-3, 0.9e-3));
+			geo.AddVertex(Geometry::Vertex(3.5e-3, 0.0, 0.0));
+			geo.Join();
+			CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountVertices());
+		}
+		{
+			// A vertex sorted between two vertices in range. The epsilon
+			// comparison of the sorting is not a strict weak ordering here.
+			Geometry geo;
+			geo.SetEpsilon(eps);
+			geo.SetWeldMethod(Geometry::WeldMethod::Grid);
+			geo.AddVertex(Geometry::Vertex(0.0, 0.0, 0.0));
+			geo.AddVertex(Geometry::Vertex(1.2e-3, -10e-3, 0.0));
+			geo.AddVertex(Geometry::Vertex(0.5e-3, 0.0, 0.0));
+			geo.Join();
+			CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountVertices());
+		}
+	}
+
+	void testJoinSpeed() {
+		// 1M triangles, like a scanned foot.
+		double seconds[2];
+		size_t count[2];
+		for (int n = 0; n < 2; n++) {
+			Geometry geo;
+			geo.SetEpsilon(1e-6);
+			geo.SetWeldMethod(
+					(n == 0) ?
+							Geometry::WeldMethod::Sort :
+							Geometry::WeldMethod::Grid);
+			AddSurface(geo, 500, 1000, 2e-7);
+			StopWatch sw;
+			sw.Start();
+			geo.Join();
+			sw.Stop();
+			seconds[n] = sw.GetSecondsCPU();
+			count[n] = geo.CountVertices();
+		}
+		CPPUNIT_ASSERT_EQUAL((size_t) 501 * 1001, count[0]);
+		CPPUNIT_ASSERT_EQUAL((size_t) 501 * 1001, count[1]);
+		std::cout << "\nJoin() of 1M triangles: Sort " << seconds[0]
+				<< " s, Grid " << seconds[1] << " s.\n";
+	}
+
+	void testIntersectPlanes() {
+		// Closed tube along the x axis
+		Geometry geo;
+		geo.SetEpsilon(1e-9);
+		const size_t N = 60;
+		auto P = [](size_t i, size_t j) {
+			const double a = 2.0 * M_PI * (double) j / (double) N;
+			const double r = 0.5 + 0.1 * std::sin((double) i);
+			return Geometry::Vertex((double) i * 0.1, r * std::cos(a),
+					r * std::sin(a));
+		};
+		for (size_t i = 0; i < N; i++)
+			for (size_t j = 0; j < N; j++) {
+				geo.AddTriangle(P(i, j), P(i + 1, j), P(i + 1, j + 1));
+				geo.AddTriangle(P(i, j), P(i + 1, j + 1), P(i, j + 1));
+			}
+		geo.Join();
+		geo.CalculateNormals();
+
+		const Vector3 n(1.0, 0.0, 0.0);
+		const std::vector<double> d = { 3.05, 0.72, 5.55, 0.72, 1.3333, 4.02 };
+		for (bool parallel : { false, true }) {
+			const std::vector<Polygon3> sections = geo.IntersectPlanes(n, d,
+					parallel);
+			CPPUNIT_ASSERT_EQUAL(d.size(), sections.size());
+			for (size_t k = 0; k < d.size(); k++) {
+				const Polygon3 single = geo.IntersectPlane(n, d[k]);
+				CPPUNIT_ASSERT_EQUAL(single.CountVertices(),
+						sections[k].CountVertices());
+				CPPUNIT_ASSERT_EQUAL(single.CountEdges(),
+						sections[k].CountEdges());
+				CPPUNIT_ASSERT_EQUAL(true, sections[k].CountEdges() > 0);
+				for (size_t i = 0; i < single.CountVertices(); i++)
+					CPPUNIT_ASSERT_EQUAL(true,
+							(single.GetVertex(i) - sections[k].GetVertex(i)).Abs()
+									< 1e-12);
+			}
+		}
+	}
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GeometryTest);
+#endif
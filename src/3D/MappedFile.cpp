@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : MappedFile.cpp
+// Purpose            : Read-only memory mapping of a file
+// Thread Safe        : No
+// Platform dependent : Yes
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "MappedFile.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__)
+#define __WIN
+#endif
+
+#ifdef __WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+MappedFile::MappedFile(const std::string &filename) {
+	Open(filename);
+}
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+void MappedFile::Open(const std::string &filename) {
+	Close();
+#ifdef __WIN
+	HANDLE hFile = CreateFileA(filename.c_str(), GENERIC_READ,
+	FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		throw std::runtime_error(
+				std::string(__FUNCTION__) + " : File " + filename
+						+ " won't open.");
+	file = hFile;
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(hFile, &length)) {
+		Close();
+		throw std::runtime_error(
+				std::string(__FUNCTION__) + " : File " + filename
+						+ ": Size unknown.");
+	}
+	if (length.QuadPart == 0)
+		return;
+	mapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping != nullptr)
+		data = (const char*) MapViewOfFile((HANDLE) mapping, FILE_MAP_READ, 0,
+				0, 0);
+	if (data == nullptr) {
+		Close();
+		throw std::runtime_error(
+				std::string(__FUNCTION__) + " : File " + filename
+						+ " can't be mapped into memory.");
+	}
+	size = (size_t) length.QuadPart;
+#else
+	const int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error(
+				std::string(__FUNCTION__) + " : File " + filename
+						+ " won't open: " + std::string(strerror(errno)));
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		const int error = errno;
+		close(fd);
+		throw std::runtime_error(
+				std::string(__FUNCTION__) + " : File " + filename + ": "
+						+ std::string(strerror(error)));
+	}
+	if (st.st_size == 0) {
+		close(fd);
+		return;
+	}
+	void *address = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE,
+			fd, 0);
+	const int error = errno;
+	// The mapping does not need the file descriptor.
+	close(fd);
+	if (address == MAP_FAILED)
+		throw std::runtime_error(
+				std::string(__FUNCTION__) + " : File " + filename
+						+ " can't be mapped into memory: "
+						+ std::string(strerror(error)));
+	// The parsers read the file from start to end.
+	madvise(address, (size_t) st.st_size, MADV_SEQUENTIAL);
+	data = (const char*) address;
+	size = (size_t) st.st_size;
+#endif
+	mapped = true;
+}
+
+void MappedFile::Load(std::istream &stream) {
+	Close();
+	const size_t block = 1 << 20;
+	size_t n = 0;
+	while (stream.good()) {
+		buffer.resize(n + block);
+		stream.read(buffer.data() + n, block);
+		n += (size_t) stream.gcount();
+	}
+	buffer.resize(n);
+	buffer.shrink_to_fit();
+	size = n;
+	data = buffer.empty() ? nullptr : buffer.data();
+}
+
+void MappedFile::Close() {
+#ifdef __WIN
+	if (mapped && data != nullptr)
+		UnmapViewOfFile(data);
+	if (mapping != nullptr)
+		CloseHandle((HANDLE) mapping);
+	if (file != nullptr)
+		CloseHandle((HANDLE) file);
+#else
+	if (mapped && data != nullptr)
+		munmap((void*) data, size);
+#endif
+	file = nullptr;
+	mapping = nullptr;
+	std::vector<char>().swap(buffer);
+	data = nullptr;
+	size = 0;
+	mapped = false;
+}
+
+const char* MappedFile::Data() const {
+	return data;
+}
+
+size_t MappedFile::Size() const {
+	return size;
+}
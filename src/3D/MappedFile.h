@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : MappedFile.h
+// Purpose            : Read-only memory mapping of a file
+// Thread Safe        : No
+// Platform dependent : Yes
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_MAPPEDFILE_H
+#define L3D_MAPPEDFILE_H
+
+/** \class MappedFile
+ * 	\code #include "MappedFile.h"\endcode
+ * 	\ingroup File3D
+ *  \brief Read-only memory mapping of a file
+ *
+ * The file is mapped into the address space instead of being read through a
+ * stream. The operating system loads the pages on access and nothing is
+ * copied. This is used to parse large binary files, e.g. STL scans.
+ *
+ * Input, that is not a file (e.g. a std::stringstream), is copied into
+ * memory by Load(). The parsers work on Data() in both cases.
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class MappedFile {
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::string &filename);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	virtual ~MappedFile();
+
+	/**\brief Map a file read-only
+	 *
+	 * \throw std::runtime_error if the file cannot be opened or mapped.
+	 */
+	void Open(const std::string &filename);
+
+	/**\brief Copy the rest of a stream into memory
+	 */
+	void Load(std::istream &stream);
+
+	void Close(); ///< Unmap the file or release the copy.
+
+	const char* Data() const; ///< Start of the data, nullptr if empty
+	size_t Size() const; ///< Number of bytes
+
+private:
+	const char *data = nullptr;
+	size_t size = 0;
+	bool mapped = false;
+	std::vector<char> buffer; ///< Copy of a stream
+	void *file = nullptr; ///< Handles of the file and the mapping on Windows
+	void *mapping = nullptr;
+};
+
+#endif /* L3D_MAPPEDFILE_H */
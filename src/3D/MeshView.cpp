@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : MeshView.cpp
+// Purpose            : Compact structure-of-arrays copy of a Geometry
+// Thread Safe        : Yes (after construction)
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshView.h"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+MeshView::MeshView(const Geometry &geometry, unsigned int channels) {
+	Assign(geometry, channels);
+}
+
+void MeshView::Assign(const Geometry &geometry, unsigned int channels) {
+	const size_t V = geometry.CountVertices();
+	const size_t T = geometry.CountTriangles();
+	if (V > UINT32_MAX) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The geometry has more than 2^32 vertices.";
+		throw std::runtime_error(err.str());
+	}
+
+	x.resize(V);
+	y.resize(V);
+	z.resize(V);
+	for (size_t i = 0; i < V; i++) {
+		const Geometry::Vertex &vert = geometry.GetVertex(i);
+		x[i] = vert.x;
+		y[i] = vert.y;
+		z[i] = vert.z;
+	}
+
+	idx.resize(3 * T);
+	for (size_t i = 0; i < T; i++) {
+		const Geometry::Triangle &tri = geometry.GetTriangle(i);
+		idx[3 * i] = (uint32_t) tri.GetVertexIndex(0);
+		idx[3 * i + 1] = (uint32_t) tri.GetVertexIndex(1);
+		idx[3 * i + 2] = (uint32_t) tri.GetVertexIndex(2);
+	}
+
+	nx.clear();
+	ny.clear();
+	nz.clear();
+	if (channels & Normals) {
+		nx.resize(V);
+		ny.resize(V);
+		nz.resize(V);
+		for (size_t i = 0; i < V; i++) {
+			const Vector3 &n = geometry.GetVertex(i).n;
+			nx[i] = (float) n.x;
+			ny[i] = (float) n.y;
+			nz[i] = (float) n.z;
+		}
+	}
+	c.clear();
+	if (channels & Colors) {
+		c.resize(V);
+		for (size_t i = 0; i < V; i++)
+			c[i] = geometry.GetVertex(i).c;
+	}
+}
+
+size_t MeshView::CountVertices() const {
+	return x.size();
+}
+
+size_t MeshView::CountTriangles() const {
+	return idx.size() / 3;
+}
+
+bool MeshView::HasNormals() const {
+	return !nx.empty();
+}
+
+bool MeshView::HasColors() const {
+	return !c.empty();
+}
+
+size_t MeshView::GetMemoryUsage() const {
+	return sizeof(MeshView)
+			+ (x.capacity() + y.capacity() + z.capacity()) * sizeof(double)
+			+ idx.capacity() * sizeof(uint32_t)
+			+ (nx.capacity() + ny.capacity() + nz.capacity()) * sizeof(float)
+			+ c.capacity() * sizeof(Geometry::Color);
+}
+
+Vector3 MeshView::GetVertex(size_t index) const {
+	return Vector3(x[index], y[index], z[index]);
+}
+
+double MeshView::GetArea() const {
+	double A = 0.0;
+	const size_t T = CountTriangles();
+	for (size_t i = 0; i < T; i++) {
+		const uint32_t ia = idx[3 * i];
+		const uint32_t ib = idx[3 * i + 1];
+		const uint32_t ic = idx[3 * i + 2];
+		const double x1 = x[ib] - x[ia];
+		const double y1 = y[ib] - y[ia];
+		const double z1 = z[ib] - z[ia];
+		const double x2 = x[ic] - x[ia];
+		const double y2 = y[ic] - y[ia];
+		const double z2 = z[ic] - z[ia];
+		const double cx = y1 * z2 - z1 * y2;
+		const double cy = z1 * x2 - x1 * z2;
+		const double cz = x1 * y2 - y1 * x2;
+		A += std::sqrt(cx * cx + cy * cy + cz * cz);
+	}
+	return A / 2.0;
+}
+
+double MeshView::GetVolume() const {
+	// Fricas code:
+	// )set fortran optlevel 2
+	// )set output fortran on
+	//	v321 := v2x*v1y*v0z
+	//	v231 := v1x*v2y*v0z
+	//	v312 := v2x*v0y*v1z
+	//	v132 := v0x*v2y*v1z
+	//	v213 := v1x*v0y*v2z
+	//	v123 := v0x*v1y*v2z
+	//	(-v321 + v231 + v312 - v132 - v213 + v123)
+	double V = 0.0;
+	const size_t T = CountTriangles();
+	for (size_t i = 0; i < T; i++) {
+		const uint32_t ia = idx[3 * i];
+		const uint32_t ib = idx[3 * i + 1];
+		const uint32_t ic = idx[3 * i + 2];
+		V += (x[ia] * y[ib] - y[ia] * x[ib]) * z[ic]
+				+ (-x[ia] * z[ib] + z[ia] * x[ib]) * y[ic]
+				+ (y[ia] * z[ib] - z[ia] * y[ib]) * x[ic];
+	}
+	return V / 6.0;
+}
+
+void MeshView::Project(const Vector3 &n, std::vector<double> &d) const {
+	const size_t V = CountVertices();
+	d.resize(V);
+	for (size_t i = 0; i < V; i++)
+		d[i] = x[i] * n.x + y[i] * n.y + z[i] * n.z;
+}
+
+void MeshView::CalculateTriangleNormals(std::vector<double> &tnx,
+		std::vector<double> &tny, std::vector<double> &tnz) const {
+	const size_t T = CountTriangles();
+	tnx.resize(T);
+	tny.resize(T);
+	tnz.resize(T);
+	for (size_t i = 0; i < T; i++) {
+		const uint32_t ia = idx[3 * i];
+		const uint32_t ib = idx[3 * i + 1];
+		const uint32_t ic = idx[3 * i + 2];
+		const double x1 = x[ib] - x[ia];
+		const double y1 = y[ib] - y[ia];
+		const double z1 = z[ib] - z[ia];
+		const double x2 = x[ic] - x[ia];
+		const double y2 = y[ic] - y[ia];
+		const double z2 = z[ic] - z[ia];
+		double cx = y1 * z2 - z1 * y2;
+		double cy = z1 * x2 - x1 * z2;
+		double cz = x1 * y2 - y1 * x2;
+		const double L = std::sqrt(cx * cx + cy * cy + cz * cz);
+		if (L > 0.0) {
+			cx /= L;
+			cy /= L;
+			cz /= L;
+		}
+		tnx[i] = cx;
+		tny[i] = cy;
+		tnz[i] = cz;
+	}
+}
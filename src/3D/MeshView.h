@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : MeshView.h
+// Purpose            : Compact structure-of-arrays copy of a Geometry
+// Thread Safe        : Yes (after construction)
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_MESHVIEW_H
+#define L3D_MESHVIEW_H
+
+/** \class MeshView
+ * 	\code #include "MeshView.h"\endcode
+ * 	\ingroup Base3D
+ *  \brief Compact structure-of-arrays copy of a Geometry
+ *
+ * A Geometry::Vertex is about 100 bytes and a Geometry::Triangle about 200
+ * bytes. Loops, that only need the positions and the corner indices, read
+ * mostly unused memory. The MeshView stores the coordinates in three
+ * separate arrays and the corners of the triangles as 32 bit indices.
+ *
+ * The indices are stored in painting order, i.e. Triangle::flip is already
+ * applied and the normal of a triangle is (b - a) x (c - a).
+ *
+ * The normals and colors of the vertices are only copied, if requested by
+ * the channels passed to the constructor.
+ *
+ * Geometry::GetMeshView() returns a cached view of the positions and
+ * triangles.
+ */
+
+#include "Geometry.h"
+#include "Vector3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MeshView {
+public:
+	/// Optional channels copied from the vertices
+	enum Channel : unsigned int {
+		Positions = 0, Normals = 1, Colors = 2
+	};
+
+	MeshView() = default;
+	explicit MeshView(const Geometry &geometry, unsigned int channels =
+			Positions);
+
+	void Assign(const Geometry &geometry, unsigned int channels = Positions);
+
+	size_t CountVertices() const;
+	size_t CountTriangles() const;
+	bool HasNormals() const;
+	bool HasColors() const;
+	size_t GetMemoryUsage() const; ///< Number of bytes used by the arrays.
+
+	Vector3 GetVertex(size_t index) const;
+
+	double GetArea() const; ///< Same as Geometry::GetArea()
+	double GetVolume() const; ///< Same as Geometry::GetVolume()
+
+	/**\brief Distance of every vertex along n
+	 *
+	 * \param n Direction to project onto, should have unit-length.
+	 * \param d Result, resized to CountVertices()
+	 */
+	void Project(const Vector3 &n, std::vector<double> &d) const;
+
+	/**\brief Unit normal vectors of all triangles
+	 *
+	 * The results are written into separate arrays for x, y and z, resized to
+	 * CountTriangles().
+	 */
+	void CalculateTriangleNormals(std::vector<double> &tnx,
+			std::vector<double> &tny, std::vector<double> &tnz) const;
+
+	std::vector<double> x; ///< X coordinates of the vertices
+	std::vector<double> y; ///< Y coordinates of the vertices
+	std::vector<double> z; ///< Z coordinates of the vertices
+	std::vector<uint32_t> idx; ///< Three vertex indices per triangle
+
+	std::vector<float> nx; ///< Optional: X component of the vertex normals
+	std::vector<float> ny; ///< Optional: Y component of the vertex normals
+	std::vector<float> nz; ///< Optional: Z component of the vertex normals
+	std::vector<Geometry::Color> c; ///< Optional: Vertex colors
+};
+
+#endif /* L3D_MESHVIEW_H */
@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : MeshView_test.cpp
+// Purpose            : Structure-of-arrays view against the Geometry loops
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "MeshView.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Geometry.h"
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <iostream>
+
+class MeshViewTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( MeshViewTest );
+	CPPUNIT_TEST(testMeasures);
+	CPPUNIT_TEST(testSpeed);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief Closed tube with N x M quads and flat end caps
+	 */
+	static Geometry Tube(size_t N, size_t M) {
+		std::vector<Vector3> p;
+		for (size_t i = 0; i <= N; i++)
+			for (size_t j = 0; j < M; j++) {
+				const double a = 2.0 * M_PI * (double) j / (double) M;
+				p.emplace_back(0.3 * (double) i / (double) N,
+						0.05 * std::cos(a), 0.05 * std::sin(a));
+			}
+		Geometry geo;
+		for (const Vector3 &q : p)
+			geo.AddVertex(q);
+		for (size_t i = 0; i < N; i++)
+			for (size_t j = 0; j < M; j++) {
+				const size_t a = i * M + j;
+				const size_t b = i * M + (j + 1) % M;
+				geo.AddTriangle(a, b + M, a + M);
+				geo.AddTriangle(a, b, b + M);
+			}
+		for (size_t j = 1; j + 1 < M; j++) {
+			geo.AddTriangle(0, j + 1, j);
+			geo.AddTriangle(N * M, N * M + j, N * M + j + 1);
+		}
+		return geo;
+	}
+
+	void testMeasures() {
+		const Geometry geo = Tube(20, 64);
+		const MeshView view(geo, MeshView::Normals | MeshView::Colors);
+		CPPUNIT_ASSERT_EQUAL(geo.CountVertices(), view.CountVertices());
+		CPPUNIT_ASSERT_EQUAL(geo.CountTriangles(), view.CountTriangles());
+		CPPUNIT_ASSERT_EQUAL(true, view.HasNormals() && view.HasColors());
+
+		// Polygon with 64 corners instead of a circle
+		const double A = 64.0 / 2.0 * 0.05 * 0.05 * std::sin(2.0 * M_PI / 64.0);
+		const double L = 2.0 * 64.0 * 0.05 * std::sin(M_PI / 64.0);
+		CPPUNIT_ASSERT_EQUAL(true,
+				std::fabs(view.GetVolume() - A * 0.3) < 1e-12);
+		CPPUNIT_ASSERT_EQUAL(true,
+				std::fabs(view.GetArea() - (2.0 * A + L * 0.3)) < 1e-12);
+		CPPUNIT_ASSERT_EQUAL(true,
+				std::fabs(view.GetVolume() - geo.GetVolume()) < 1e-15);
+
+		// The normals of the mantle point outwards.
+		std::vector<double> tnx, tny, tnz;
+		view.CalculateTriangleNormals(tnx, tny, tnz);
+		const Vector3 n(tnx[0], tny[0], tnz[0]);
+		const Vector3 c = (view.GetVertex(view.idx[0])
+				+ view.GetVertex(view.idx[1]) + view.GetVertex(view.idx[2]))
+				/ 3.0;
+		CPPUNIT_ASSERT_EQUAL(true, n.Dot(Vector3(0, c.y, c.z)) > 0.0);
+	}
+
+	void testSpeed() {
+		// About 1M triangles, like a scanned last.
+		const Geometry geo = Tube(1000, 500);
+		const MeshView view(geo);
+
+		// The same loop as before on the Geometry
+		StopWatch swGeometry;
+		swGeometry.Start();
+		double Vg = 0.0;
+		for (size_t rep = 0; rep < 10; rep++) {
+			for (size_t i = 0; i < geo.CountTriangles(); i++) {
+				const Geometry::Triangle &tri = geo.GetTriangle(i);
+				const Vector3 &v0 = geo.GetVertex(tri.GetVertexIndex(0));
+				const Vector3 &v1 = geo.GetVertex(tri.GetVertexIndex(1));
+				const Vector3 &v2 = geo.GetVertex(tri.GetVertexIndex(2));
+				Vg += (v0.x * v1.y - v0.y * v1.x) * v2.z
+						+ (-v0.x * v1.z + v0.z * v1.x) * v2.y
+						+ (v0.y * v1.z - v0.z * v1.y) * v2.x;
+			}
+		}
+		swGeometry.Stop();
+		const double tGeometry = swGeometry.GetSecondsCPU();
+
+		StopWatch swView;
+		swView.Start();
+		double Vv = 0.0;
+		for (size_t rep = 0; rep < 10; rep++)
+			Vv += view.GetVolume();
+		swView.Stop();
+		const double tView = swView.GetSecondsCPU();
+		CPPUNIT_ASSERT_EQUAL(true, std::fabs(Vg / 6.0 - Vv) < 1e-9);
+
+		std::cout << "\nGetVolume() of " << geo.CountTriangles()
+				<< " triangles: Geometry " << tGeometry / 10.0
+				<< " s, MeshView " << tView / 10.0 << " s.\n";
+		std::cout << "Memory: Geometry " << geo.GetMemoryUsage() / 1048576
+				<< " MiB, MeshView " << view.GetMemoryUsage() / 1048576
+				<< " MiB.\n";
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MeshViewTest);
+#endif
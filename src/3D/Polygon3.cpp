@@ -379,6 +379,7 @@ double Polygon3::MapU(bool fixFirstVertexToZero) {
 void Polygon3::Shift(double distance) {
 	for (auto &vert : v)
 		vert += vert.n * distance;
+	InvalidateCache();
 }
 
 void Polygon3::RemoveZeroLength() {
@@ -55,6 +55,9 @@
 #include <vector>
 
 class Polygon3: public Geometry {
+	friend class ArchiveReader;
+	friend class ArchiveWriter;
+
 public:
 	enum class CalculateNormalMethod {
 		ByCenter, ///< Calculate normals with respect to the center of the polygon
@@ -0,0 +1,377 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : SparseVolume.cpp
+// Purpose            : Narrow-band volume stored in bricks of 8x8x8 voxels
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SparseVolume.h"
+
+#include "Volume.h"
+#include "../system/Cancellation.h"
+
+#include <cfloat>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+SparseVolume::SparseVolume(const SparseVolume &other) :
+		color(other.color), surface(other.surface), geometry(other.geometry), origin(
+				other.origin), resolution(other.resolution) {
+	for (const auto &b : other.bricks)
+		bricks.emplace(b.first,
+				b.second ? std::make_unique<Brick>(*b.second) : nullptr);
+}
+
+SparseVolume& SparseVolume::operator =(const SparseVolume &other) {
+	if (&other == this)
+		return *this;
+	color = other.color;
+	surface = other.surface;
+	geometry = other.geometry;
+	origin = other.origin;
+	resolution = other.resolution;
+	bricks.clear();
+	for (const auto &b : other.bricks)
+		bricks.emplace(b.first,
+				b.second ? std::make_unique<Brick>(*b.second) : nullptr);
+	update = true;
+	return *this;
+}
+
+SparseVolume::~SparseVolume() {
+	if (m_gllist != 0)
+		glDeleteLists(m_gllist, 1);
+}
+
+void SparseVolume::SetGrid(const Vector3 &origin, double resolution) {
+	if (resolution <= 0.0) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The resolution has to be positive.";
+		throw std::runtime_error(err.str());
+	}
+	this->origin = origin;
+	this->resolution = resolution;
+	Clear();
+}
+
+void SparseVolume::Clear() {
+	bricks.clear();
+}
+
+void SparseVolume::AddSphere(const Vector3 &p1, double r1, double k1) {
+	const double kh = -log(2 * M_E - 1) / k1;
+	Add(p1, p1, r1 - 2.0 / kh, [&](const Vector3 &p) {
+		const double d = ((p - p1).Abs() - r1) * kh;
+		if (d <= -2)
+			return 0.0;
+		if (d > 2)
+			return 1.0;
+		return d * 0.25 + 0.5;
+	});
+}
+
+void SparseVolume::AddCylinder(const Vector3 &p1, const Vector3 &p2, double r1,
+		double r2, double k1) {
+	// Same shape and ramp as the corresponding Volume::AddCylinder.
+	Vector3 n = p2 - p1;
+	const double nd = n.Abs();
+	if (fabs(nd) < FLT_EPSILON) {
+		AddSphere(p1, fmax(r1, r2), k1);
+		return;
+	}
+	if (nd + r2 <= r1) {
+		AddSphere(p1, r1, k1);
+		return;
+	}
+	if (nd + r1 <= r2) {
+		AddSphere(p2, r2, k1);
+		return;
+	}
+	n.Normalize();
+
+	const double s0 = (r1 * r1 - r1 * r2) / nd;
+	const double h0 = r1 * sqrt(2 * r1 * r2 + nd * nd - r1 * r1 - r2 * r2) / nd;
+	const double a11 = 1 / nd;
+	const double a12 = -s0 / (h0 * nd);
+	const double a22 = r1 / h0;
+	const double kh = -log(2 * M_E - 1) / k1;
+
+	// The distance y2 is at least the distance to the axis (a22 >= 1), thus
+	// nothing is added farther than the largest radius plus the band.
+	Add(p1, p2, fmax(r1, r2) - 2.0 / kh, [&](const Vector3 &p) {
+		const double x = n.Dot(p - p1);
+		const double y = (p - (n * x + p1)).Abs();
+		const double x2 = fma(x, a11, y * a12);
+		double d;
+		double r;
+		if (x2 < 0) {
+			d = (p - p1).Abs();
+			r = r1;
+		} else if (x2 > 1) {
+			d = (p - p2).Abs();
+			r = r2;
+		} else {
+			d = y * a22;
+			r = fma(x2, r2 - r1, r1);
+		}
+		d = (d - r) * kh;
+		if (d <= -2)
+			return 0.0;
+		if (d > 2)
+			return 1.0;
+		return d * 0.25 + 0.5;
+	});
+}
+
+template<class Ramp>
+void SparseVolume::Add(const Vector3 &p1, const Vector3 &p2, double reach,
+		const Ramp &ramp) {
+	const int64_t S = brickSize;
+	const int64_t bi0 = FloorDiv(
+			(int64_t) floor((fmin(p1.x, p2.x) - reach - origin.x) / resolution));
+	const int64_t bj0 = FloorDiv(
+			(int64_t) floor((fmin(p1.y, p2.y) - reach - origin.y) / resolution));
+	const int64_t bk0 = FloorDiv(
+			(int64_t) floor((fmin(p1.z, p2.z) - reach - origin.z) / resolution));
+	const int64_t bi1 = FloorDiv(
+			(int64_t) ceil((fmax(p1.x, p2.x) + reach - origin.x) / resolution));
+	const int64_t bj1 = FloorDiv(
+			(int64_t) ceil((fmax(p1.y, p2.y) + reach - origin.y) / resolution));
+	const int64_t bk1 = FloorDiv(
+			(int64_t) ceil((fmax(p1.z, p2.z) + reach - origin.z) / resolution));
+
+	const Vector3 a = p2 - p1;
+	const double a2 = a.Abs2();
+	const double halfDiagonal = sqrt(3.0) * (S - 1) * resolution / 2.0;
+
+	for (int64_t bk = bk0; bk <= bk1; bk++) {
+		Cancellation::Check();
+		for (int64_t bj = bj0; bj <= bj1; bj++) {
+			for (int64_t bi = bi0; bi <= bi1; bi++) {
+				// Skip bricks out of reach by the distance of the center to
+				// the segment.
+				const Vector3 c = origin
+						+ Vector3(bi * S, bj * S, bk * S) * resolution
+						+ Vector3(1, 1, 1) * (halfDiagonal / sqrt(3.0));
+				double s = (a2 > 0.0) ? (c - p1).Dot(a) / a2 : 0.0;
+				s = fmin(fmax(s, 0.0), 1.0);
+				if ((c - p1 - a * s).Abs() - halfDiagonal >= reach)
+					continue;
+
+				const uint64_t key = Key(bi, bj, bk);
+				auto it = bricks.find(key);
+				if (it != bricks.end() && !it->second)
+					continue; // Full bricks stay full.
+				const bool created = (it == bricks.end());
+				if (created) {
+					it = bricks.emplace(key, std::make_unique<Brick>()).first;
+					it->second->fill(0.0f);
+				}
+				Brick &b = *(it->second);
+				bool touched = false;
+				bool full = true;
+				size_t idx = 0;
+				Vector3 p;
+				for (int64_t k = 0; k < S; k++) {
+					p.z = origin.z + (bk * S + k) * resolution;
+					for (int64_t j = 0; j < S; j++) {
+						p.y = origin.y + (bj * S + j) * resolution;
+						for (int64_t i = 0; i < S; i++) {
+							p.x = origin.x + (bi * S + i) * resolution;
+							const double d = ramp(p);
+							if (d > 0.0) {
+								b[idx] += d;
+								touched = true;
+							}
+							if (b[idx] < 1.0f)
+								full = false;
+							idx++;
+						}
+					}
+				}
+				if (full) {
+					it->second.reset();
+				} else if (created && !touched) {
+					bricks.erase(it);
+				}
+			}
+		}
+	}
+}
+
+double SparseVolume::GetVoxel(int64_t i, int64_t j, int64_t k) const {
+	const int64_t bi = FloorDiv(i);
+	const int64_t bj = FloorDiv(j);
+	const int64_t bk = FloorDiv(k);
+	auto it = bricks.find(Key(bi, bj, bk));
+	if (it == bricks.end())
+		return 0.0;
+	if (!it->second)
+		return 1.0;
+	const int64_t S = brickSize;
+	return (*(it->second))[((k - bk * S) * S + (j - bj * S)) * S
+			+ (i - bi * S)];
+}
+
+size_t SparseVolume::CountBricks() const {
+	return bricks.size();
+}
+
+size_t SparseVolume::CountStoredBricks() const {
+	size_t count = 0;
+	for (const auto &b : bricks)
+		if (b.second)
+			count++;
+	return count;
+}
+
+size_t SparseVolume::GetMemoryUsage() const {
+	return sizeof(SparseVolume) + CountStoredBricks() * sizeof(Brick)
+			+ bricks.size()
+					* (sizeof(uint64_t) + sizeof(std::unique_ptr<Brick>)
+							+ 2 * sizeof(void*))
+			+ bricks.bucket_count() * sizeof(void*);
+}
+
+void SparseVolume::CalcSurface() {
+	const int64_t S = brickSize;
+	geometry.Clear();
+
+	// A cell is processed with the brick of its corner 0. The other corners
+	// can be in the bricks at +1 in every direction, so the cells of the
+	// neighbors at -1 have to be processed as well. The set keeps the output
+	// in a reproducible order.
+	std::set<std::array<int64_t, 3>> toVisit;
+	for (const auto &b : bricks) {
+		const std::array<int64_t, 3> q = Position(b.first);
+		for (int64_t dk = -1; dk <= 0; dk++)
+			for (int64_t dj = -1; dj <= 0; dj++)
+				for (int64_t di = -1; di <= 0; di++)
+					toVisit.insert( { q[0] + di, q[1] + dj, q[2] + dk });
+	}
+
+	// Values of one brick plus one layer of the neighbors at +1
+	const int64_t N = S + 1;
+	std::vector<float> buffer(N * N * N);
+	double v[8];
+	for (const std::array<int64_t, 3> &q : toVisit) {
+		Cancellation::Check();
+		bool allFull = true;
+		for (int64_t dk = 0; dk <= 1; dk++) {
+			for (int64_t dj = 0; dj <= 1; dj++) {
+				for (int64_t di = 0; di <= 1; di++) {
+					auto it = bricks.find(Key(q[0] + di, q[1] + dj, q[2] + dk));
+					const bool missing = (it == bricks.end());
+					const Brick *b = missing ? nullptr : it->second.get();
+					if (missing || b != nullptr)
+						allFull = false;
+					for (int64_t k = dk * S; k < (dk ? N : S); k++) {
+						for (int64_t j = dj * S; j < (dj ? N : S); j++) {
+							for (int64_t i = di * S; i < (di ? N : S); i++) {
+								float value;
+								if (missing) {
+									value = 0.0f;
+								} else if (b == nullptr) {
+									value = 1.0f;
+								} else {
+									value = (*b)[((k - dk * S) * S
+											+ (j - dj * S)) * S + (i - di * S)];
+								}
+								buffer[(k * N + j) * N + i] = value;
+							}
+						}
+					}
+				}
+			}
+		}
+		if (allFull)
+			continue;
+
+		for (int64_t k = 0; k < S; k++) {
+			for (int64_t j = 0; j < S; j++) {
+				for (int64_t i = 0; i < S; i++) {
+					const size_t c = (k * N + j) * N + i;
+					v[0] = buffer[c];
+					v[1] = buffer[c + 1];
+					v[2] = buffer[c + N];
+					v[3] = buffer[c + 1 + N];
+					v[4] = buffer[c + N * N];
+					v[5] = buffer[c + 1 + N * N];
+					v[6] = buffer[c + N * (1 + N)];
+					v[7] = buffer[c + 1 + N * (1 + N)];
+					const Vector3 p = origin
+							+ Vector3(q[0] * S + i, q[1] * S + j, q[2] * S + k)
+									* resolution;
+					Volume::MarchCube(v, surface, p, resolution, resolution,
+							resolution, geometry);
+				}
+			}
+		}
+	}
+	update = true;
+}
+
+void SparseVolume::PaintSurface() const {
+	if (m_gllist == 0) {
+		m_gllist = glGenLists(1);
+		update = true;
+	}
+	if (update) {
+		glNewList(m_gllist, GL_COMPILE_AND_EXECUTE);
+		geometry.Paint();
+		glEndList();
+		update = false;
+	} else {
+		glCallList(m_gllist);
+	}
+}
+
+uint64_t SparseVolume::Key(int64_t bi, int64_t bj, int64_t bk) {
+	// 21 bits per axis, stored with an offset
+	const int64_t offset = (int64_t) 1 << 20;
+	if (bi < -offset || bi >= offset || bj < -offset || bj >= offset
+			|| bk < -offset || bk >= offset) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << " - ";
+		err << "The brick (" << bi << ", " << bj << ", " << bk
+				<< ") is too far away from the origin.";
+		throw std::runtime_error(err.str());
+	}
+	return ((uint64_t) (bk + offset) << 42) | ((uint64_t) (bj + offset) << 21)
+			| (uint64_t) (bi + offset);
+}
+
+std::array<int64_t, 3> SparseVolume::Position(uint64_t key) {
+	const int64_t offset = (int64_t) 1 << 20;
+	const uint64_t mask = ((uint64_t) 1 << 21) - 1;
+	return { (int64_t) (key & mask) - offset, (int64_t) ((key >> 21) & mask)
+			- offset, (int64_t) ((key >> 42) & mask) - offset };
+}
+
+int64_t SparseVolume::FloorDiv(int64_t a) {
+	const int64_t S = brickSize;
+	return (a >= 0) ? (a / S) : -((-a + S - 1) / S);
+}
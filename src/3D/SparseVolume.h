@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : SparseVolume.h
+// Purpose            : Narrow-band volume stored in bricks of 8x8x8 voxels
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_SPARSEVOLUME_H
+#define L3D_SPARSEVOLUME_H
+
+/** \class SparseVolume
+ * 	\code #include "SparseVolume.h"\endcode
+ * 	\ingroup Base3D
+ *  \brief Narrow-band volume stored in bricks of 8x8x8 voxels
+ *
+ * Same morph-objects as the Volume, but only the voxels near the surface are
+ * stored. The grid is unbounded: voxel (i, j, k) is at
+ * origin + (i, j, k) * resolution.
+ *
+ * The primitives use the clamped linear ramp of
+ * Volume::AddCylinder(p1, p2, r1, r2, k1): a primitive adds 0 outside
+ * of its transition band and 1 inside of it. Every brick is in one of three
+ * states:
+ *  - not stored: all voxels are 0 (outside of all primitives),
+ *  - full: all voxels are at least 1 (inside of a primitive), no memory used,
+ *  - stored: 512 float values.
+ *
+ * Primitives only evaluate the bricks within reach of their band and skip
+ * full bricks. Stored bricks, that are saturated afterwards, are turned into
+ * full bricks. Thus the memory and time grow with the area of the surface
+ * and not with the volume of the bounding box.
+ *
+ * The surface level has to be in the range [0, 1).
+ *
+ * The generated Geometry is in global coordinates.
+ */
+
+#include "Geometry.h"
+#include "Vector3.h"
+
+#include "OpenGL.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+class SparseVolume {
+public:
+	SparseVolume() = default;
+	SparseVolume(const SparseVolume &other);
+	SparseVolume& operator=(const SparseVolume &other);
+	virtual ~SparseVolume();
+
+	/** \brief Set origin and size of the voxels
+	 *
+	 * Clears the volume.
+	 */
+	void SetGrid(const Vector3 &origin, double resolution);
+
+	void Clear();
+	void AddSphere(const Vector3 &p1, double r1, double k1);
+	void AddCylinder(const Vector3 &p1, const Vector3 &p2, double r1,
+			double r2, double k1);
+
+	/** \brief Value of a voxel
+	 *
+	 * Voxels in full bricks return 1.
+	 */
+	double GetVoxel(int64_t i, int64_t j, int64_t k) const;
+
+	size_t CountBricks() const; ///< Number of stored and full bricks
+	size_t CountStoredBricks() const; ///< Number of bricks with values
+	size_t GetMemoryUsage() const; ///< Number of bytes used by the bricks.
+
+	/** \brief Marching cubes algorithm
+	 *
+	 * Same as Volume::CalcSurface(), but only the cells touching a stored or
+	 * full brick are visited.
+	 */
+	void CalcSurface();
+	void PaintSurface() const;
+
+public:
+	static constexpr int64_t brickSize = 8; ///< Voxels along an edge of a brick
+
+	Vector3 color = { 0.5, 0.5, 0.5 }; ///< Color of the volume
+	double surface = 0.0; ///< Values greater than surface are inside.
+	Geometry geometry; ///< Generated geometry
+
+private:
+	typedef std::array<float, brickSize * brickSize * brickSize> Brick;
+
+	static uint64_t Key(int64_t bi, int64_t bj, int64_t bk);
+	static std::array<int64_t, 3> Position(uint64_t key); ///< Inverse of Key()
+	static int64_t FloorDiv(int64_t a); ///< Brick of a voxel index
+
+	/** \brief Add a primitive to all bricks within reach
+	 *
+	 * \param p1, p2 Segment the primitive is built around
+	 * \param reach Distance from the segment, beyond that the primitive adds 0
+	 * \param ramp Functor returning the value to add at a point
+	 */
+	template<class Ramp>
+	void Add(const Vector3 &p1, const Vector3 &p2, double reach,
+			const Ramp &ramp);
+
+	Vector3 origin;
+	double resolution = 1.0;
+
+	/// Bricks by their position; a nullptr marks a full brick.
+	std::unordered_map<uint64_t, std::unique_ptr<Brick>> bricks;
+
+	mutable GLuint m_gllist = 0;
+	mutable bool update = true;
+};
+
+#endif /* L3D_SPARSEVOLUME_H */
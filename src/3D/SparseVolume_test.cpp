@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : SparseVolume_test.cpp
+// Purpose            : Narrow-band volume against the dense Volume
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "SparseVolume.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Volume.h"
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <iostream>
+
+class SparseVolumeTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( SparseVolumeTest );
+	CPPUNIT_TEST(testDense);
+	CPPUNIT_TEST(testResolution);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief Chain of cylinders, roughly the size of a foot
+	 */
+	template<class V>
+	static void AddChain(V &volume) {
+		const Vector3 p[5] = { { 0.0, 0.0, 0.02 }, { 0.07, 0.01, 0.04 }, {
+				0.14, 0.02, 0.05 }, { 0.2, 0.0, 0.03 }, { 0.24, -0.01, 0.02 } };
+		const double r[5] = { 0.02, 0.012, 0.015, 0.008, 0.01 };
+		for (size_t n = 0; n + 1 < 5; n++)
+			volume.AddCylinder(p[n], p[n + 1], r[n] + 0.005, r[n + 1] + 0.005,
+					0.005);
+		volume.AddCylinder(p[2], p[2] + Vector3(0.01, 0.04, 0.0), 0.01, 0.006,
+				0.005);
+	}
+
+	void testDense() {
+		const Vector3 origin(-0.04, -0.04, -0.02);
+		const double res = 0.003;
+		Volume dense;
+		dense.SetExtent(0.32, 0.14, 0.11, res);
+		dense.SetOrigin(origin);
+		dense.Clear();
+		AddChain(dense);
+		dense.CalcSurface();
+
+		SparseVolume sparse;
+		sparse.SetGrid(origin, res);
+		AddChain(sparse);
+		sparse.CalcSurface();
+
+		const size_t Nx = dense.Size(0);
+		const size_t Ny = dense.Size(1);
+		const size_t Nz = dense.Size(2);
+		size_t c = 0;
+		for (size_t k = 0; k < Nz; k++)
+			for (size_t j = 0; j < Ny; j++)
+				for (size_t i = 0; i < Nx; i++) {
+					const double vd = dense[c++];
+					const double vs = sparse.GetVoxel(i, j, k);
+					if (vs == 1.0)
+						CPPUNIT_ASSERT(vd > 1.0 - 1e-5);
+					else
+						CPPUNIT_ASSERT_DOUBLES_EQUAL(vd, vs, 1e-5);
+				}
+
+		// With the surface at 0 the vertices sit on the grid points, so both
+		// surfaces are the same.
+		CPPUNIT_ASSERT_EQUAL(dense.geometry.CountTriangles(),
+				sparse.geometry.CountTriangles());
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(dense.geometry.GetArea(),
+				sparse.geometry.GetArea(), 1e-6 * sparse.geometry.GetArea());
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(dense.geometry.GetVolume(),
+				sparse.geometry.GetVolume(), 1e-4 * sparse.geometry.GetVolume());
+	}
+
+	void testResolution() {
+		// Ten times the resolution of the dense volume
+		const double res = 0.0005;
+		StopWatch watch;
+		watch.Start();
+		SparseVolume sparse;
+		sparse.SetGrid(Vector3(-0.04, -0.04, -0.02), res);
+		AddChain(sparse);
+		sparse.CalcSurface();
+		watch.Stop();
+		const double cells = (0.32 / res) * (0.14 / res) * (0.11 / res);
+		std::cout << "\nSparseVolume at " << res * 1000 << " mm: "
+				<< sparse.CountStoredBricks() << " stored and "
+				<< sparse.CountBricks() - sparse.CountStoredBricks()
+				<< " full bricks, "
+				<< sparse.GetMemoryUsage() / (1024 * 1024)
+				<< " MiB (dense: "
+				<< (size_t) (cells * sizeof(double)) / (1024 * 1024)
+				<< " MiB), " << sparse.geometry.CountTriangles()
+				<< " triangles, " << watch.GetSecondsCPU() << " s\n";
+		CPPUNIT_ASSERT(sparse.GetMemoryUsage() < cells * sizeof(double) / 10);
+		CPPUNIT_ASSERT(sparse.CountStoredBricks() < sparse.CountBricks());
+		CPPUNIT_ASSERT(sparse.geometry.CountTriangles() > 0);
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SparseVolumeTest);
+
+#endif
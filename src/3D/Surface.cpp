@@ -30,66 +30,225 @@
 #include "../math/Exporter.h"
 #include "../math/MatlabFile.h"
 #include "../math/Matrix.h"
+#include "../system/Cancellation.h"
+#include "../system/ThreadPool.h"
 
 #include <stdexcept>
 //#include "../system/StopWatch.h"
 #ifdef USE_EIGEN
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #else
 #include "../math/SVD.h"
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <sstream>
 
 #include "OpenGL.h"
 
-Geometry::Vertex Surface::Patch::operator ()(double u, double v) const {
-	const size_t N = Nu * Nv;
-	// Fill the UV matrix with the 2D polynomial factors for UV.
-
-	std::vector<double> x(N);
-	Fill(x, u, v);
+#ifdef USE_EIGEN
+static Eigen::SparseMatrix<double> ToSparse(size_t rows, size_t N,
+		const std::vector<size_t> &index, const std::vector<double> &value) {
+	std::vector<Eigen::Triplet<double>> triplets;
+	triplets.reserve(index.size());
+	for (size_t n = 0; n < index.size(); n++)
+		triplets.emplace_back(index[n] / N, index[n] % N, value[n]);
+	Eigen::SparseMatrix<double> A(rows, N);
+	A.setFromTriplets(triplets.begin(), triplets.end());
+	return A;
+}
 
-	Geometry::Vertex ret;
-	ret.u = u;
-	ret.v = v;
+static Eigen::MatrixXd ToDense(const std::vector<Vector3> &b) {
+	Eigen::MatrixXd B(b.size(), 3);
+	for (size_t n = 0; n < b.size(); n++) {
+		B(n, 0) = b[n].x;
+		B(n, 1) = b[n].y;
+		B(n, 2) = b[n].z;
+	}
+	return B;
+}
 
-	for (uint_fast8_t i = 0; i < N; i++)
-		ret.x += x[i] * cx[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		ret.y += x[i] * cy[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		ret.z += x[i] * cz[i];
+typedef Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower,
+		Eigen::NaturalOrdering<int>> SparseLDLT;
+typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> Permutation;
+
+/**\brief Regularization for the augmented system
+ *
+ * A larger lambda reduces the rounding errors of the decomposition, but needs
+ * more iterations in SolveAugmented() for badly conditioned A matrices.
+ */
+static double Regularization(const Eigen::SparseMatrix<double> &A0,
+		const Eigen::SparseMatrix<double> &A1) {
+	double scale = 1.0;
+	for (int k = 0; k < A0.outerSize(); k++)
+		for (Eigen::SparseMatrix<double>::InnerIterator it(A0, k); it; ++it)
+			scale = std::fmax(scale, fabs(it.value()));
+	for (int k = 0; k < A1.outerSize(); k++)
+		for (Eigen::SparseMatrix<double>::InnerIterator it(A1, k); it; ++it)
+			scale = std::fmax(scale, fabs(it.value()));
+	return 1e-6 * scale * scale;
+}
 
-	Vector3 du;
-	Vector3 dv;
-	for (uint_fast8_t i = 0; i < N; i++)
-		du.x += x[i] * cdxdu[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		du.y += x[i] * cdydu[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		du.z += x[i] * cdzdu[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		dv.x += x[i] * cdxdv[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		dv.y += x[i] * cdydv[i];
-	for (uint_fast8_t i = 0; i < N; i++)
-		dv.z += x[i] * cdzdv[i];
+/**\brief Lower triangle of the augmented system
+ *
+ * The system (see Surface::Calculate()) with the unknowns r, c and y is
+ * regularized by -lambda on the diagonal for c and +lambda for y. This makes
+ * it quasi-definite, i.e. it has a LDL^T decomposition for every symmetric
+ * ordering.
+ */
+static Eigen::SparseMatrix<double> Augmented(
+		const Eigen::SparseMatrix<double> &A0,
+		const Eigen::SparseMatrix<double> &A1, double lambda) {
+	const size_t N = A0.cols();
+	const size_t M0 = A0.rows();
+	const size_t M1 = A1.rows();
+	const size_t S = M1 + N + M0;
+	std::vector<Eigen::Triplet<double>> triplets;
+	triplets.reserve(S + A1.nonZeros() + A0.nonZeros());
+	for (size_t n = 0; n < M1; n++)
+		triplets.emplace_back(n, n, 1.0);
+	for (int k = 0; k < A1.outerSize(); k++)
+		for (Eigen::SparseMatrix<double>::InnerIterator it(A1, k); it; ++it)
+			triplets.emplace_back(M1 + it.col(), it.row(), it.value());
+	for (int k = 0; k < A0.outerSize(); k++)
+		for (Eigen::SparseMatrix<double>::InnerIterator it(A0, k); it; ++it)
+			triplets.emplace_back(M1 + N + it.row(), M1 + it.col(), it.value());
+	if (lambda != 0.0) {
+		for (size_t n = 0; n < N; n++)
+			triplets.emplace_back(M1 + n, M1 + n, -lambda);
+		for (size_t n = 0; n < M0; n++)
+			triplets.emplace_back(M1 + N + n, M1 + N + n, lambda);
+	}
+	Eigen::SparseMatrix<double> K(S, S);
+	K.setFromTriplets(triplets.begin(), triplets.end());
+	return K;
+}
 
-	ret.n = du * dv;
+/**\brief Solution of min |A1 c - b1| subject to A0 c = b0
+ *
+ * The regularization of the decomposed system is removed by iterative
+ * refinement against the exact system (a proximal point iteration).
+ *
+ * Starting from 0 the iteration converges to the minimum norm solution. The
+ * rounding errors of the decomposition add a small part in the directions not
+ * determined by A0 and A1.
+ *
+ * \param ldlt Decomposition of the regularized system, permuted by P
+ * \param P Ordering of the decomposition
+ */
+static Eigen::MatrixXd SolveAugmented(const Eigen::SparseMatrix<double> &A0,
+		const Eigen::MatrixXd &b0, const Eigen::SparseMatrix<double> &A1,
+		const Eigen::MatrixXd &b1, const SparseLDLT &ldlt,
+		const Permutation &P) {
+	const size_t N = A0.cols();
+	const size_t M0 = A0.rows();
+	const size_t M1 = A1.rows();
+	const size_t S = M1 + N + M0;
+	const Eigen::SparseMatrix<double> K = Augmented(A0, A1, 0.0);
+
+	Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(S, 3);
+	rhs.topRows(M1) = b1;
+	rhs.bottomRows(M0) = b0;
+	Eigen::MatrixXd x = Eigen::MatrixXd::Zero(S, 3);
+	for (uint_fast8_t iteration = 0; iteration < 100; iteration++) {
+		Cancellation::Check();
+		const Eigen::MatrixXd residual = rhs
+				- K.selfadjointView<Eigen::Lower>() * x;
+		const Eigen::MatrixXd dx = P.transpose() * ldlt.solve(P * residual);
+		x += dx;
+		if (dx.middleRows(M1, N).norm()
+				<= 1e-12 * x.middleRows(M1, N).norm())
+			break;
+	}
+	return x.middleRows(M1, N);
+}
+#endif
 
-	//Debugging:
-//	ret.nx = cx[5] * u + cx[4];
-//	ret.ny = cy[5] * u + cy[4];
-//	ret.nz = cz[5] * u + cz[4];
+/**\brief Decompositions kept from the last Surface::Calculate()
+ *
+ * A cache is not modified after it has been set up, so copies of a Surface
+ * can share it.
+ */
+struct Surface::Cache {
+	Solver solver = Solver::Dense; ///< Solver, that set up this cache
+#ifdef USE_EIGEN
+	// Solver::Dense
+	Eigen::MatrixXd A0; ///< Hard boundaries
+	Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> dec0; ///< Decomposition of A0
+	Eigen::MatrixXd Z; ///< Orthonormal basis of the null space of A0
+
+	// Solver::Sparse
+	size_t N = 0;
+	size_t hardRows = 0;
+	size_t softRows = 0;
+	std::vector<size_t> hardIndex;
+	std::vector<double> hardValue;
+	std::vector<size_t> softIndex;
+	std::vector<double> softValue;
+	Permutation P; ///< Fill reducing ordering of the augmented system
+	SparseLDLT ldlt; ///< Decomposition of the permuted, regularized system
+#else
+	Matrix Ahard; ///< Hard boundaries
+	SVD svd; ///< Decomposition of Ahard
+	Matrix H; ///< Variation of the solution in the null space of Ahard
+#endif
+};
 
-	ret.n.Normalize();
+Geometry::Vertex Surface::Patch::operator ()(double u, double v) const {
+	Geometry::Vertex ret;
+	Evaluate(u, v, ret, ret.n);
+	ret.u = u;
+	ret.v = v;
 	return ret;
 }
 
+void Surface::Patch::Evaluate(double u, double v, Vector3 &position,
+		Vector3 &normal) const {
+	const double u_ = mapu(u);
+	const double v_ = mapv(v);
+
+	// Horner scheme: first along U for every row, then along V.
+	double x = 0.0, y = 0.0, z = 0.0;
+	double dxdu = 0.0, dydu = 0.0, dzdu = 0.0;
+	double dxdv = 0.0, dydv = 0.0, dzdv = 0.0;
+	for (size_t j = Nv; j-- > 0;) {
+		double rx = 0.0, ry = 0.0, rz = 0.0;
+		double rxdu = 0.0, rydu = 0.0, rzdu = 0.0;
+		double rxdv = 0.0, rydv = 0.0, rzdv = 0.0;
+		const size_t offs = j * Nu;
+		for (size_t i = Nu; i-- > 0;) {
+			const size_t k = offs + i;
+			rx = rx * u_ + cx[k];
+			ry = ry * u_ + cy[k];
+			rz = rz * u_ + cz[k];
+			rxdu = rxdu * u_ + cdxdu[k];
+			rydu = rydu * u_ + cdydu[k];
+			rzdu = rzdu * u_ + cdzdu[k];
+			rxdv = rxdv * u_ + cdxdv[k];
+			rydv = rydv * u_ + cdydv[k];
+			rzdv = rzdv * u_ + cdzdv[k];
+		}
+		x = x * v_ + rx;
+		y = y * v_ + ry;
+		z = z * v_ + rz;
+		dxdu = dxdu * v_ + rxdu;
+		dydu = dydu * v_ + rydu;
+		dzdu = dzdu * v_ + rzdu;
+		dxdv = dxdv * v_ + rxdv;
+		dydv = dydv * v_ + rydv;
+		dzdv = dzdv * v_ + rzdv;
+	}
+	position.Set(x, y, z);
+	normal = Vector3(dxdu, dydu, dzdu) * Vector3(dxdv, dydv, dzdv);
+	normal.Normalize();
+}
+
 AffineTransformMatrix Surface::Patch::GetMatrix(double u, double v,
 		bool originAtPos) const {
 	const size_t N = Nu * Nv;
@@ -328,6 +487,8 @@ void Surface::Clear() {
 	Asoft.Reset();
 	bhard.Reset();
 	bsoft.Reset();
+	sparseHard.Clear();
+	sparseSoft.Clear();
 	boundariedFixed = false;
 	debug.clear();
 }
@@ -796,8 +957,30 @@ void Surface::AddPolynomial(double u0, double u1, double v0, double v1,
 //void Surface::AddSurface(const Surface &other) {
 //}
 
+void Surface::SparseAB::Clear() {
+	rows = 0;
+	index.clear();
+	value.clear();
+	b.clear();
+}
+
+bool Surface::IsSparse() const {
+#ifdef USE_EIGEN
+	return solver == Solver::Sparse;
+#else
+	return false;
+#endif
+}
+
 size_t Surface::IncreaseAB(size_t additional) {
 	size_t n = (size_t) -1;
+	if (IsSparse()) {
+		SparseAB &ab = softBoundaries ? sparseSoft : sparseHard;
+		n = ab.rows;
+		ab.rows += additional;
+		ab.b.resize(ab.rows);
+		return n;
+	}
 	if (softBoundaries) {
 		size_t N = Asoft.Size(0);
 		if (N == 0) {
@@ -829,6 +1012,19 @@ void Surface::SetA(const std::vector<double> &values, size_t posFrom,
 	size_t i = posFrom;
 	size_t j = posTo;
 
+	if (IsSparse()) {
+		SparseAB &ab = softBoundaries ? sparseSoft : sparseHard;
+		for (size_t n = 0; n < count; n++) {
+			const double a = values[i] * factor;
+			if (a != 0.0) {
+				ab.index.push_back(j);
+				ab.value.push_back(a);
+			}
+			i += strideFrom;
+			j += strideTo;
+		}
+		return;
+	}
 	if (softBoundaries) {
 		for (size_t n = 0; n < count; n++) {
 
@@ -850,6 +1046,11 @@ void Surface::SetA(const std::vector<double> &values, size_t posFrom,
 }
 
 void Surface::SetB(const Vector3 value, size_t posTo) {
+	if (IsSparse()) {
+		SparseAB &ab = softBoundaries ? sparseSoft : sparseHard;
+		ab.b[posTo / 3] = value;
+		return;
+	}
 	if (softBoundaries) {
 		bsoft[posTo + 0] = value.x;
 		bsoft[posTo + 1] = value.y;
@@ -872,12 +1073,15 @@ void Surface::Calculate() {
 	bhard.SetSize(3, 0);
 	Asoft.SetSize(N, 0);
 	bsoft.SetSize(3, 0);
+	sparseHard.Clear();
+	sparseSoft.Clear();
 
 	//TODO Shovel the code below into separate functions to reduce the cyclomatic-complexity. (Only _after_ it is tested.)
 
 	for (int level = 0; level <= 1; level++) {
 		softBoundaries = (level == 1);
 		for (const Boundary &b : boundaries) {
+			Cancellation::Check();
 			if (!b.active || b.level != level)
 				continue;
 			size_t idx = (size_t) -1;
@@ -1059,6 +1263,81 @@ void Surface::Calculate() {
 //	Asoft.ReorderDimensions(Matrix::Order::TWO_REVERSED);
 //	bsoft.ReorderDimensions(Matrix::Order::TWO_REVERSED);
 
+	// Note that the classes Matrix and Eigen::MatrixXd have the same interface
+	// In both cases c is of a different type but can be accessed the same way.
+	auto SetCoefficients = [this](const auto &c) {
+		// Map the solution into the patches.
+		size_t offs = 0;
+		for (auto &p : patches) {
+			const size_t Np = p.Nu * p.Nv;
+			for (size_t m = 0; m < Np; m++)
+				p.cx[m] = c(offs + m, 0);
+			for (size_t m = 0; m < Np; m++)
+				p.cy[m] = c(offs + m, 1);
+			for (size_t m = 0; m < Np; m++)
+				p.cz[m] = c(offs + m, 2);
+			offs += Np;
+		}
+	};
+
+#ifdef USE_EIGEN
+	if (IsSparse()) {
+		Cancellation::Check();
+		const Eigen::SparseMatrix<double> A0 = ToSparse(sparseHard.rows, N,
+				sparseHard.index, sparseHard.value);
+		const Eigen::SparseMatrix<double> A1 = ToSparse(sparseSoft.rows, N,
+				sparseSoft.index, sparseSoft.value);
+
+		// The ordering is kept, as long as the pattern of the system does not
+		// change, the decomposition, as long as the A matrices do not change.
+		const bool samePattern = cache && cache->solver == Solver::Sparse
+				&& cache->N == N && cache->hardRows == sparseHard.rows
+				&& cache->softRows == sparseSoft.rows
+				&& cache->hardIndex == sparseHard.index
+				&& cache->softIndex == sparseSoft.index;
+		if (!samePattern || cache->hardValue != sparseHard.value
+				|| cache->softValue != sparseSoft.value) {
+			auto temp = std::make_shared<Cache>();
+			temp->solver = Solver::Sparse;
+			temp->N = N;
+			temp->hardRows = sparseHard.rows;
+			temp->softRows = sparseSoft.rows;
+			temp->hardIndex = sparseHard.index;
+			temp->hardValue = sparseHard.value;
+			temp->softIndex = sparseSoft.index;
+			temp->softValue = sparseSoft.value;
+			const Eigen::SparseMatrix<double> R = Augmented(A0, A1,
+					Regularization(A0, A1));
+			if (samePattern) {
+				temp->P = cache->P;
+			} else {
+				const Eigen::SparseMatrix<double> full = R.selfadjointView<
+						Eigen::Lower>();
+				Permutation Pinv;
+				Eigen::AMDOrdering<int>()(full, Pinv);
+				temp->P = Pinv.inverse();
+			}
+			Eigen::SparseMatrix<double> Rp(R.rows(), R.cols());
+			Rp.selfadjointView<Eigen::Lower>() =
+					R.selfadjointView<Eigen::Lower>().twistedBy(temp->P);
+			Cancellation::Check();
+			temp->ldlt.compute(Rp);
+			if (temp->ldlt.info() != Eigen::Success) {
+				std::ostringstream err;
+				err << __FILE__ << ":" << __FUNCTION__ << "(" << __LINE__
+						<< ") : ";
+				err << "The decomposition of the boundary conditions failed.";
+				throw std::runtime_error(err.str());
+			}
+			cache = temp;
+		}
+		SetCoefficients(
+				SolveAugmented(A0, ToDense(sparseHard.b), A1,
+						ToDense(sparseSoft.b), cache->ldlt, cache->P));
+		return;
+	}
+#endif
+
 #ifndef USE_EIGEN
 	size_t n1 = Ahard.Size(1);
 	if (n1 < N)
@@ -1073,6 +1352,7 @@ void Surface::Calculate() {
 #endif
 
 #ifdef USE_EIGEN
+#ifdef DEBUG
 	{
 		Exporter exp("/tmp/surf.mat");
 		exp.Add(Ahard, "Ahard");
@@ -1080,6 +1360,7 @@ void Surface::Calculate() {
 		exp.Add(Asoft, "Asoft");
 		exp.Add(bsoft, "bsoft");
 	}
+#endif
 
 	Eigen::MatrixXd A0;
 	Eigen::MatrixXd b0;
@@ -1132,18 +1413,40 @@ void Surface::Calculate() {
 //
 //	Eigen::MatrixXd c = J + H * w;
 
-	Eigen::CompleteOrthogonalDecomposition Dec0 =
-			A0.completeOrthogonalDecomposition();
-	Eigen::MatrixXd J = Dec0.solve(b0); // @suppress("Invalid arguments")
-	Eigen::MatrixXd H = Eigen::MatrixXd::Identity(A0.cols(), A0.cols())
-			- Dec0.solve(A0);
-	Eigen::MatrixXd K = A1 * H; // @suppress("Invalid arguments")
+	// The hard boundaries depend mostly on the layout of the patches. Their
+	// decomposition is kept, as long as A0 does not change.
+	Cancellation::Check();
+	if (!cache || cache->solver != Solver::Dense
+			|| cache->A0.rows() != A0.rows() || cache->A0.cols() != A0.cols()
+			|| cache->A0 != A0) {
+		auto temp = std::make_shared<Cache>();
+		temp->solver = Solver::Dense;
+		temp->A0 = A0;
+		temp->dec0.compute(A0);
+		if (A0.rows() == 0) {
+			temp->Z = Eigen::MatrixXd::Identity(N, N);
+		} else {
+			// The columns of Q behind the rank of A0^T span the null space
+			// of A0.
+			Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(A0.transpose());
+			const Eigen::MatrixXd Q = qr.householderQ();
+			temp->Z = Q.rightCols(N - qr.rank());
+		}
+		cache = temp;
+	}
+	const Eigen::MatrixXd &Z = cache->Z;
+
+	// Instead of H = I - pinv(A0) * A0 the basis Z of its range is used. As Z
+	// is orthonormal, the minimum norm w gives the minimum norm c.
+	Eigen::MatrixXd J = cache->dec0.solve(b0); // @suppress("Invalid arguments")
+	Eigen::MatrixXd K = A1 * Z; // @suppress("Invalid arguments")
+	Cancellation::Check();
 	Eigen::CompleteOrthogonalDecomposition Dec1 =
 			K.completeOrthogonalDecomposition();
 	Eigen::MatrixXd w = Dec1.solve(b1 - A1 * J); // @suppress("Invalid arguments")
-	Eigen::MatrixXd c = J + H * w;
+	Eigen::MatrixXd c = J + Z * w;
 
-	const size_t N1 = N - Dec0.rank();
+	const size_t N1 = Z.cols();
 	const size_t N2 = N1 - Dec1.rank();
 #ifdef DEBUG
 	std::cout << "Exact solution: DOF " << N << " -> " << N1 << '\n';
@@ -1164,11 +1467,20 @@ void Surface::Calculate() {
 //		debug.emplace_back(bsoft(n, 0), bsoft(n, 1), bsoft(n, 2));
 #endif
 
-	SVD svdhard;
+	// The decomposition of the hard boundaries is kept, as long as they do not
+	// change.
+	Cancellation::Check();
+	if (!cache || cache->Ahard.Size() != Ahard.Size()
+			|| !std::equal(Ahard.begin(), Ahard.end(), cache->Ahard.begin())) {
+		auto temp = std::make_shared<Cache>();
+		temp->Ahard = Ahard;
+		temp->svd.Decompose(Ahard);
+		temp->H = temp->svd.Variation(100);
+		cache = temp;
+	}
+	const SVD &svdhard = cache->svd;
 	SVD svdsoft;
 
-	svdhard.Decompose(Ahard);
-
 #ifdef DEBUG
 	{
 		Exporter exp("/tmp/surf.mat");
@@ -1187,13 +1499,13 @@ void Surface::Calculate() {
 	Matrix c;
 	if (combinedSolution) {
 		Matrix J = svdhard.Solve(bhard, 100);
-		Matrix H = svdhard.Variation(100);
+		const Matrix &H = cache->H;
 		svdsoft.Decompose(Asoft * H);
 		Matrix w = svdsoft.Solve(bsoft - Asoft * J, 100);
 		c = J + H * w;
 	} else {
 		Matrix J = svdhard.Solve(bhard, 100);
-		Matrix H = svdhard.Variation(100);
+		const Matrix &H = cache->H;
 
 		Matrix w;
 		w.SetSize(H.Size(1), J.Size(1));
@@ -1209,28 +1521,21 @@ void Surface::Calculate() {
 
 #endif
 
-	// Note that the classes Matrix and Eigen::MatrixXd have the same interface
-	// In both cases c is of a different type but can be accessed the same way.
-
-	// Map the solution into the patches.
-	size_t offs = 0;
-	for (auto &p : patches) {
-		const size_t Np = p.Nu * p.Nv;
-		for (size_t m = 0; m < Np; m++)
-			p.cx[m] = c(offs + m, 0);
-		for (size_t m = 0; m < Np; m++)
-			p.cy[m] = c(offs + m, 1);
-		for (size_t m = 0; m < Np; m++)
-			p.cz[m] = c(offs + m, 2);
-		offs += Np;
-	}
-
+	SetCoefficients(c);
 }
 
 Geometry::Vertex Surface::operator ()(double u, double v) const {
+	lastSearchedPatch = FindPatch(u, v, lastSearchedPatch);
+	Geometry::Vertex ret = patches[lastSearchedPatch](u, v);
+	ret.u = u;
+	ret.v = v;
+	return ret;
+}
+
+size_t Surface::FindPatch(double &u, double &v, size_t start) const {
 	size_t check = patches.size();
-	if (lastSearchedPatch >= patches.size())
-		lastSearchedPatch = 0;
+	if (start >= patches.size())
+		start = 0;
 	while (u <= -M_PI)
 		u += 2.0 * M_PI;
 	while (u > M_PI)
@@ -1241,9 +1546,9 @@ Geometry::Vertex Surface::operator ()(double u, double v) const {
 		v = gv0;
 
 	while (check > 0) {
-		if (patches[lastSearchedPatch].IsInside(u, v))
+		if (patches[start].IsInside(u, v))
 			break;
-		lastSearchedPatch = (lastSearchedPatch + 1) % patches.size();
+		start = (start + 1) % patches.size();
 		check--;
 	}
 	if (check == 0) {
@@ -1253,22 +1558,61 @@ Geometry::Vertex Surface::operator ()(double u, double v) const {
 				<< " is outside of what is covered by the coordinate system.";
 		throw std::logic_error(err.str());
 	}
-	Geometry::Vertex ret = patches[lastSearchedPatch](u, v);
-	ret.u = u;
-	ret.v = v;
-	return ret;
+	return start;
 }
 
-void Surface::Apply(Geometry &geo) {
-	const size_t vc = geo.CountVertices();
-	for (size_t n = 0; n < vc; n++) {
-		Geometry::Vertex &vert = geo[n];
-		Geometry::Vertex addi = this->operator ()(vert.u, vert.v);
-		vert.x = addi.x;
-		vert.y = addi.y;
-		vert.z = addi.z;
-		vert.n = addi.n;
+/**\brief Call a function for blocks of indices, distributed over threads
+ *
+ * \param f Function called with the first and behind the last index of a block
+ */
+static void ForEachBlock(size_t count, size_t blockSize, unsigned int threads,
+		const std::function<void(size_t, size_t)> &f) {
+	const size_t blocks = (count + blockSize - 1) / blockSize;
+	ThreadPool::ForEach(blocks, [&](size_t b) {
+		f(b * blockSize, std::min(count, (b + 1) * blockSize));
+	}, threads);
+}
+
+void Surface::Evaluate(const std::vector<double> &u,
+		const std::vector<double> &v, std::vector<Vector3> &position,
+		std::vector<Vector3> &normal, unsigned int threads) const {
+	if (u.size() != v.size()) {
+		std::ostringstream err;
+		err << __FILE__ << ":" << __FUNCTION__ << "(" << __LINE__ << ") : ";
+		err << " u has " << u.size() << " and v has " << v.size()
+				<< " values. This should be the same.";
+		throw std::logic_error(err.str());
 	}
+	position.resize(u.size());
+	normal.resize(u.size());
+	ForEachBlock(u.size(), 4096, threads, [&](size_t begin, size_t end) {
+		size_t idx = 0;
+		for (size_t n = begin; n < end; n++) {
+			double u_ = u[n];
+			double v_ = v[n];
+			idx = FindPatch(u_, v_, idx);
+			patches[idx].Evaluate(u_, v_, position[n], normal[n]);
+		}
+	});
+}
+
+void Surface::Apply(Geometry &geo, unsigned int threads) {
+	const size_t vc = geo.CountVertices();
+	if (vc == 0)
+		return;
+	// The vertices are stored in one vector.
+	geo.InvalidateCache();
+	Geometry::Vertex *vertices = &geo[0];
+	ForEachBlock(vc, 4096, threads, [&](size_t begin, size_t end) {
+		size_t idx = 0;
+		for (size_t n = begin; n < end; n++) {
+			Geometry::Vertex &vert = vertices[n];
+			double u = vert.u;
+			double v = vert.v;
+			idx = FindPatch(u, v, idx);
+			patches[idx].Evaluate(u, v, vert, vert.n);
+		}
+	});
 	geo.FlagNormals(true, false, false);
 	geo.CalculateUVCoordinateSystems();
 }
@@ -53,6 +53,7 @@
 #include <cfloat>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 class Surface: protected Geometry {
@@ -84,6 +85,14 @@ private:
 		 */
 		Geometry::Vertex operator()(double u, double v) const;
 
+		/**\brief Calculate position and normal without allocating memory
+		 *
+		 * The polynomials are evaluated by the Horner scheme directly on
+		 * the coefficients. The normal has a length of 1.
+		 */
+		void Evaluate(double u, double v, Vector3 &position,
+				Vector3 &normal) const;
+
 		/**\brief Return a full local coordinate system at a position
 		 *
 		 * Calculates a full coordinate system at the position u, v. The
@@ -377,23 +386,82 @@ public:
 	/**\}
 	 */
 
+	/**\brief Solver used by Calculate()
+	 */
+	enum class Solver {
+		Dense, ///< Dense matrices, decomposed by COD (Eigen) or SVD
+		Sparse ///< Sparse matrices, augmented system decomposed by LDL^T
+	};
+
 	/**\brief Calculate the coefficients of the patches
 	 *
 	 * Solve the boundary conditions and update the coefficients in the
 	 * patches.
+	 *
+	 * The hard boundaries are met exactly (in the least-squares sense, if
+	 * they contradict each other). The soft boundaries are approximated in
+	 * the remaining degrees of freedom. Of all solutions the one with the
+	 * smallest coefficients is returned.
+	 *
+	 * The Solver::Dense decomposes the hard and the soft matrix one after
+	 * another. The Solver::Sparse solves both levels at once in the augmented
+	 * system
+	 *
+	 * \code
+	 * | I       Asoft  0       | | r |   | bsoft |
+	 * | Asoft^T 0      Ahard^T | | c | = | 0     |
+	 * | 0       Ahard  0       | | y |   | bhard |
+	 * \endcode
+	 *
+	 * Each row of the A matrices only touches the coefficients of one or two
+	 * patches, so the system stays sparse. It is regularized to be
+	 * quasi-definite, factorized by a sparse LDL^T and the regularization is
+	 * removed by iterative refinement. If the boundaries do not determine all
+	 * coefficients, the undetermined part can differ by about 1e-6 relative
+	 * from the one of the Solver::Dense. The Solver::Sparse needs Eigen,
+	 * without it the dense SVD is used.
+	 *
+	 * The decompositions are kept for the next call, also over Clear().
+	 * Typically only the soft boundaries change between two calls (e.g. the
+	 * points of an outline), while the hard ones (stitching of the patches)
+	 * stay the same:
+	 *  * The Solver::Dense reuses the decomposition and the null space of the
+	 *    hard boundaries. Only the soft ones within that null space are
+	 *    decomposed again.
+	 *  * The Solver::Sparse reuses the fill reducing ordering, as long as
+	 *    the same coefficients are touched by the same rows, and the whole
+	 *    decomposition, if only the values to interpolate changed.
 	 */
 	void Calculate();
 
 	Geometry::Vertex operator()(double u, double v) const;
 
+	/**\brief Evaluate the surface at many positions at once
+	 *
+	 * Gives the same positions and normals as operator() for every pair
+	 * u[n], v[n]. The search for the patch starts at the patch of the
+	 * previous position, the polynomials are evaluated without allocating
+	 * memory and blocks of positions are distributed over threads.
+	 *
+	 * \param u U coordinates
+	 * \param v V coordinates, same size as u
+	 * \param position Resized to the size of u, filled with the positions
+	 * \param normal Resized to the size of u, filled with the normals
+	 * \param threads Number of threads, 0 for one per core
+	 */
+	void Evaluate(const std::vector<double> &u, const std::vector<double> &v,
+			std::vector<Vector3> &position, std::vector<Vector3> &normal,
+			unsigned int threads = 0) const;
+
 	/**\brief Apply the surface to a geometry
 	 *
 	 * Reads the UV values of all vertices and maps the XYZ and normals onto
-	 * the surface.
+	 * the surface. The vertices are evaluated in blocks on threads, like in
+	 * Evaluate(), and written directly into the geometry.
 	 *
 	 * Additionally the triangle and edge-normals are updated.
 	 */
-	void Apply(Geometry &geo);
+	void Apply(Geometry &geo, unsigned int threads = 0);
 
 	/**\brief Update the patches to the base-Geometry object
 	 *
@@ -442,13 +510,38 @@ private:
 	 */
 	size_t Pos(size_t nPatch, uint8_t idxU = 0, uint8_t idxV = 0) const;
 
+	/**\brief Find the patch containing a position
+	 *
+	 * U is wrapped into -pi..pi and V is limited to the surface. The search
+	 * starts at the patch given and throws, if no patch contains the position.
+	 */
+	size_t FindPatch(double &u, double &v, size_t start) const;
+
 	void PrintProblem(const Matrix &A, const Matrix &b) const;
 
+	/**\brief Rows of the A and B matrices for the Solver::Sparse
+	 *
+	 * Only the non-zero values of A are stored. The index is the position
+	 * in the dense A matrix, i.e. row * N + column.
+	 */
+	struct SparseAB {
+		void Clear();
+		size_t rows = 0;
+		std::vector<size_t> index;
+		std::vector<double> value;
+		std::vector<Vector3> b;
+	};
+
+	bool IsSparse() const;
+
+	struct Cache;
+
 public:
 	std::vector<Patch> patches;
 	std::vector<Boundary> boundaries;
 
 	double eps = 1e-9;
+	Solver solver = Solver::Sparse; ///< Solver used by Calculate()
 
 	//TODO Remove variables below after changing boundary handling strategy.
 	int softBoundaries = true;
@@ -466,6 +559,11 @@ private:
 	double gv0 = DBL_MAX; ///< Global start in V
 	double gv1 = -DBL_MAX; ///< Global end in V
 
+	SparseAB sparseHard; ///< Hard boundaries for the Solver::Sparse
+	SparseAB sparseSoft; ///< Soft boundaries for the Solver::Sparse
+
+	std::shared_ptr<const Cache> cache; ///< Decompositions of the last Calculate()
+
 	/** \brief Speedup variable for patch-search
 	 *
 	 * It is assumed, that subsequent searches are most likely in the same
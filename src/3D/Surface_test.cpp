@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Surface_test.cpp
+// Purpose            : Dense and sparse solver of the Surface
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "Surface.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <iostream>
+
+class SurfaceTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( SurfaceTest );
+	CPPUNIT_TEST(testSolver);
+	CPPUNIT_TEST(testSolverUnderdetermined);
+	CPPUNIT_TEST(testCache);
+	CPPUNIT_TEST(testApply);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief Tube of P x P/2 stitched patches, fitted to points
+	 *
+	 * Similar to the CoordinateSystem, but with more patches.
+	 */
+	static double Tube(Surface &surface, size_t P, double step,
+			Surface::Solver solver, double scale = 1.0) {
+		surface.Clear();
+		surface.solver = solver;
+		for (size_t r = 0; r < P / 2; r++)
+			surface.Setup(P, 1, -M_PI, M_PI, r, r + 1);
+		surface.ClearBoundaries();
+		surface.HardBoundaries();
+		surface.AddStitching(-M_PI, M_PI, -DBL_MAX, DBL_MAX, 1, true, false,
+				true);
+		surface.SoftBoundaries();
+		for (double v = 0.0; v <= P / 2; v += step)
+			for (double u = -M_PI; u < M_PI; u += step)
+				surface.AddPoint(u, v, Shape(u, v) * scale);
+		StopWatch sw;
+		sw.Start();
+		surface.Calculate();
+		sw.Stop();
+		surface.Update();
+		return sw.GetSecondsWall();
+	}
+
+	static Vector3 Shape(double u, double v) {
+		const double r = 1.0 + 0.2 * sin(v) + 0.1 * cos(3.0 * u);
+		return Vector3(r * cos(u), r * sin(u), v);
+	}
+
+	static double MaxDifference(const Surface &a, const Surface &b, size_t P) {
+		double d = 0.0;
+		for (double v = 0.01; v < P / 2; v += 0.13)
+			for (double u = -3.1; u < 3.1; u += 0.11) {
+				const Geometry::Vertex va = a(u, v);
+				const Geometry::Vertex vb = b(u, v);
+				d = std::fmax(d,
+						(Vector3(va.x, va.y, va.z) - Vector3(vb.x, vb.y, vb.z)).Abs());
+			}
+		return d;
+	}
+
+	void testSolver() {
+		for (size_t P : { 4, 8 }) {
+			Surface dense;
+			Surface sparse;
+			const double t0 = Tube(dense, P, 0.05, Surface::Solver::Dense);
+			const double t1 = Tube(sparse, P, 0.05, Surface::Solver::Sparse);
+			CPPUNIT_ASSERT(MaxDifference(dense, sparse, P) < 1e-9);
+			if (P == 8) {
+				const Geometry::Vertex v = sparse(0.5, 0.5);
+				CPPUNIT_ASSERT(
+						(Vector3(v.x, v.y, v.z) - Shape(0.5, 0.5)).Abs() < 2e-3);
+			}
+			std::cout << "\n" << P * P / 2 << " patches: dense " << t0
+					<< " s, sparse " << t1 << " s";
+		}
+		std::cout << "\n";
+	}
+
+	void testSolverUnderdetermined() {
+		// Too few points for the coefficients: both return (nearly) the
+		// solution with the smallest coefficients.
+		Surface dense;
+		Surface sparse;
+		Tube(dense, 8, 0.7, Surface::Solver::Dense);
+		Tube(sparse, 8, 0.7, Surface::Solver::Sparse);
+		CPPUNIT_ASSERT(MaxDifference(dense, sparse, 8) < 1e-4);
+	}
+
+	void testCache() {
+		// Only the values of the soft boundaries change: the decompositions of
+		// the first run are reused.
+		for (Surface::Solver solver : { Surface::Solver::Dense,
+				Surface::Solver::Sparse }) {
+			Surface cached;
+			Surface fresh;
+			Tube(cached, 8, 0.05, solver);
+			const double t0 = Tube(cached, 8, 0.05, solver, 1.1);
+			const double t1 = Tube(fresh, 8, 0.05, solver, 1.1);
+			CPPUNIT_ASSERT(MaxDifference(cached, fresh, 8) < 1e-9);
+			std::cout << "\n"
+					<< ((solver == Surface::Solver::Dense) ? "Dense" : "Sparse")
+					<< ": " << t1 << " s, with cache " << t0 << " s";
+		}
+		std::cout << "\n";
+	}
+
+	void testApply() {
+		Surface surface;
+		Tube(surface, 8, 0.05, Surface::Solver::Sparse);
+		Geometry geo;
+		const size_t N = 500;
+		for (size_t j = 0; j < N; j++)
+			for (size_t i = 0; i < N; i++) {
+				Geometry::Vertex v;
+				v.u = -M_PI + 2.0 * M_PI * i / N;
+				v.v = 4.0 * j / N;
+				geo.AddVertex(v);
+			}
+		StopWatch sw0;
+		sw0.Start();
+		std::vector<Geometry::Vertex> ref;
+		for (size_t n = 0; n < geo.CountVertices(); n++) {
+			const Geometry::Vertex &v = geo.GetVertex(n);
+			ref.push_back(surface(v.u, v.v));
+		}
+		sw0.Stop();
+		StopWatch sw1;
+		sw1.Start();
+		surface.Apply(geo);
+		sw1.Stop();
+		for (size_t n = 0; n < geo.CountVertices(); n++) {
+			const Geometry::Vertex &v = geo.GetVertex(n);
+			CPPUNIT_ASSERT((Vector3(v.x, v.y, v.z) - ref[n]).Abs() < 1e-12);
+			CPPUNIT_ASSERT((v.n - ref[n].n).Abs() < 1e-12);
+		}
+		std::cout << "\n" << geo.CountVertices() << " vertices: operator() "
+				<< sw0.GetSecondsWall() << " s, Apply " << sw1.GetSecondsWall()
+				<< " s\n";
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SurfaceTest);
+
+#endif
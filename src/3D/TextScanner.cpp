@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : TextScanner.cpp
+// Purpose            : Tokenizer for text files in memory
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "TextScanner.h"
+
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+
+static inline bool IsWhitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v'
+			|| c == '\f';
+}
+
+TextScanner::TextScanner(const char *data, size_t size,
+		const std::string &name_) :
+		name(name_), begin(data), end(data + size), pos(data) {
+}
+
+bool TextScanner::AtEnd() {
+	SkipWhitespace();
+	return pos == end;
+}
+
+std::string_view TextScanner::Word() {
+	SkipWhitespace();
+	const char *start = pos;
+	while (pos != end && !IsWhitespace(*pos))
+		pos++;
+	return std::string_view(start, (size_t) (pos - start));
+}
+
+std::string_view TextScanner::Line() {
+	const char *start = pos;
+	while (pos != end && *pos != '\n')
+		pos++;
+	const char *stop = pos;
+	if (pos != end)
+		pos++;
+	if (stop != start && *(stop - 1) == '\r')
+		stop--;
+	return std::string_view(start, (size_t) (stop - start));
+}
+
+void TextScanner::SkipLine() {
+	while (pos != end && *pos != '\n')
+		pos++;
+	if (pos != end)
+		pos++;
+}
+
+bool TextScanner::Read(float &value) {
+	SkipWhitespace();
+	const char *start = (pos != end && *pos == '+') ? pos + 1 : pos;
+	std::from_chars_result r = std::from_chars(start, end, value);
+	if (r.ec == std::errc::result_out_of_range) {
+		// Denormalized numbers and overflows
+		double temp;
+		r = std::from_chars(start, end, temp);
+		value = (float) temp;
+	}
+	if (r.ec != std::errc())
+		return false;
+	pos = r.ptr;
+	return true;
+}
+
+bool TextScanner::Read(double &value) {
+	SkipWhitespace();
+	const char *start = (pos != end && *pos == '+') ? pos + 1 : pos;
+	const std::from_chars_result r = std::from_chars(start, end, value);
+	if (r.ec != std::errc())
+		return false;
+	pos = r.ptr;
+	return true;
+}
+
+bool TextScanner::Read(int64_t &value) {
+	SkipWhitespace();
+	const char *start = (pos != end && *pos == '+') ? pos + 1 : pos;
+	const std::from_chars_result r = std::from_chars(start, end, value);
+	if (r.ec != std::errc())
+		return false;
+	pos = r.ptr;
+	return true;
+}
+
+void TextScanner::ThrowExpected(const std::string &what) const {
+	std::ostringstream err;
+	err << "Expected " << what;
+	const char *stop = std::find(pos, end, '\n');
+	if (pos != end)
+		err << " at \"" << std::string(pos, std::min<size_t>(stop - pos, 40))
+				<< "\"";
+	err << ".";
+	Throw(err.str());
+}
+
+void TextScanner::Throw(const std::string &message) const {
+	Throw(message, Offset());
+}
+
+void TextScanner::Throw(const std::string &message, size_t offset) const {
+	const size_t line = (size_t) std::count(begin,
+			begin + std::min<size_t>(offset, end - begin), '\n') + 1;
+	std::ostringstream err;
+	if (name.empty())
+		err << "Line " << line << ": " << message;
+	else
+		err << name << ", line " << line << ": " << message;
+	throw std::runtime_error(err.str());
+}
+
+size_t TextScanner::LineNumber() const {
+	return (size_t) std::count(begin, pos, '\n') + 1;
+}
+
+size_t TextScanner::Offset() const {
+	return (size_t) (pos - begin);
+}
+
+void TextScanner::SkipWhitespace() {
+	while (pos != end && IsWhitespace(*pos))
+		pos++;
+}
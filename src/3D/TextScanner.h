@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : TextScanner.h
+// Purpose            : Tokenizer for text files in memory
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef L3D_TEXTSCANNER_H
+#define L3D_TEXTSCANNER_H
+
+/** \class TextScanner
+ * 	\code #include "TextScanner.h"\endcode
+ * 	\ingroup File3D
+ *  \brief Tokenizer for text files in memory
+ *
+ * Reads words and numbers from a buffer, e.g. the Data() of a MappedFile.
+ * Words are returned as std::string_view into the buffer, so no strings
+ * are allocated. Numbers are converted by std::from_chars, which does not
+ * depend on the locale (a dot is always the decimal separator).
+ *
+ * Whitespace is space, tab, carriage return, newline, vertical tab and form
+ * feed, the same characters as std::isspace() in the "C" locale.
+ *
+ * Errors are thrown as std::runtime_error starting with the name of the
+ * file and the line number, e.g. "foot.stl, line 12: ...".
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class TextScanner {
+public:
+	/**\brief Scanner over a buffer
+	 *
+	 * \param data Start of the text
+	 * \param size Bytes in the buffer
+	 * \param name Filename for the error messages, may be empty
+	 */
+	TextScanner(const char *data, size_t size, const std::string &name =
+			std::string());
+
+	bool AtEnd(); ///< Skip whitespace and test for the end of the buffer.
+
+	/**\brief Next word separated by whitespace, empty at the end
+	 */
+	std::string_view Word();
+
+	/**\brief Rest of the current line and move to the next line
+	 *
+	 * The newline (and a carriage return before it) is not included.
+	 */
+	std::string_view Line();
+	void SkipLine();
+
+	/**\brief Read a floating point number
+	 *
+	 * A leading '+' is accepted like by the stream operators.
+	 *
+	 * \return false, if there is no number. The position is not changed.
+	 */
+	bool Read(float &value);
+	bool Read(double &value);
+	bool Read(int64_t &value);
+
+	/**\brief Read a number and throw std::runtime_error if there is none
+	 */
+	template<typename T> T Get() {
+		T value;
+		if (!Read(value))
+			ThrowExpected("a number");
+		return value;
+	}
+
+	/**\brief Throw "Expected <what> at "<text>"." with Throw()
+	 */
+	[[noreturn]] void ThrowExpected(const std::string &what) const;
+
+	/**\brief Throw a std::runtime_error with the name and the line number
+	 *
+	 * The line is the one of the current position or of an Offset() taken
+	 * before, e.g. at the start of a line, that was already read.
+	 */
+	[[noreturn]] void Throw(const std::string &message) const;
+	[[noreturn]] void Throw(const std::string &message, size_t offset) const;
+
+	size_t LineNumber() const; ///< Line of the current position, starting at 1.
+	size_t Offset() const; ///< Bytes from the start of the buffer, e.g. to binary data.
+
+private:
+	void SkipWhitespace();
+
+	const std::string name;
+	const char *const begin;
+	const char *const end;
+	const char *pos;
+};
+
+#endif /* L3D_TEXTSCANNER_H */
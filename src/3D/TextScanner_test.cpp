@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : TextScanner_test.cpp
+// Purpose            : Test the TextScanner and the ASCII mesh readers
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef USE_CPPUNIT
+
+#include "TextScanner.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FileOBJ.h"
+#include "FilePLY.h"
+#include "FileSTL.h"
+#include "Geometry.h"
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class TextScannerTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( TextScannerTest );
+	CPPUNIT_TEST(testScanner);
+	CPPUNIT_TEST(testReaders);
+	CPPUNIT_TEST(testErrors);
+	CPPUNIT_TEST(testSpeed);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	void testScanner() {
+		const std::string text = "  word 1.5e-3\r\n+2 -7 rest of line\r\nx";
+		TextScanner scan(text.data(), text.size());
+		CPPUNIT_ASSERT(scan.Word() == "word");
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5e-3, scan.Get<float>(), 1e-9);
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, scan.LineNumber());
+		CPPUNIT_ASSERT_EQUAL(2.0, scan.Get<double>());
+		CPPUNIT_ASSERT_EQUAL((int64_t) -7, scan.Get<int64_t>());
+		CPPUNIT_ASSERT(scan.Line() == " rest of line");
+		CPPUNIT_ASSERT_EQUAL((size_t) 3, scan.LineNumber());
+		CPPUNIT_ASSERT_THROW(scan.Get<float>(), std::runtime_error);
+		CPPUNIT_ASSERT(scan.Word() == "x");
+		CPPUNIT_ASSERT(scan.AtEnd());
+		CPPUNIT_ASSERT(scan.Word().empty());
+	}
+
+	void testReaders() {
+		// The same quad in the three ASCII formats
+		{
+			std::istringstream in("solid quad\n"
+					" facet normal 0 0 1\n  outer loop\n"
+					"   vertex 0 0 0\n   vertex 1 0 0\n   vertex 1 1 0\n"
+					"  endloop\n endfacet\n"
+					" facet normal 0 0 1\n  outer loop\n"
+					"   vertex 0 0 0\n   vertex 1 1 0\n   vertex 0 1 0\n"
+					"  endloop\n endfacet\n"
+					"endsolid quad\n");
+			Geometry geo;
+			FileSTL stl(&in);
+			stl.Read(geo);
+			CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountTriangles());
+			CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountVertices());
+		}
+		{
+			std::istringstream in("# quad\no quad\n"
+					"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvn 0 0 1\n"
+					"f 1//1 2//1 3//1 4//1\n");
+			Geometry geo;
+			FileOBJ obj(&in);
+			obj.Read(geo);
+			CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountTriangles());
+			CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountVertices());
+		}
+		{
+			std::istringstream in("ply\nformat ascii 1.0\n"
+					"element vertex 4\n"
+					"property float x\nproperty float y\nproperty float z\n"
+					"element face 1\n"
+					"property list uchar int vertex_indices\n"
+					"end_header\n"
+					"0 0 0\n1 0 0\n1 1 0\n0 1 0\n4 0 1 2 3\n");
+			Geometry geo;
+			FilePLY ply(&in);
+			ply.Read(geo);
+			CPPUNIT_ASSERT_EQUAL((size_t) 2, geo.CountTriangles());
+			CPPUNIT_ASSERT_EQUAL((size_t) 4, geo.CountVertices());
+		}
+	}
+
+	void testErrors() {
+		// Vertical tab and form feed are whitespace
+		{
+			const std::string text = "a\v\fb";
+			TextScanner scan(text.data(), text.size());
+			CPPUNIT_ASSERT(scan.Word() == "a");
+			CPPUNIT_ASSERT(scan.Word() == "b");
+		}
+		auto Message = [](FileGeometry &file) {
+			Geometry geo;
+			try {
+				file.Read(geo);
+			} catch (const std::runtime_error &e) {
+				return std::string(e.what());
+			}
+			return std::string();
+		};
+		const std::filesystem::path dir =
+				std::filesystem::temp_directory_path();
+		const std::string fnSTL = (dir / "TextScanner_error.stl").string();
+		const std::string fnOBJ = (dir / "TextScanner_error.obj").string();
+		const std::string fnPLY = (dir / "TextScanner_error.ply").string();
+		{
+			std::ofstream out(fnSTL);
+			out << "solid bad\n facet normal 0 0 1\n  outer loop\n"
+					"   vertex 0 0 0\n   vertex 1 0 x\n";
+		}
+		{
+			std::ofstream out(fnOBJ);
+			out << "v 0 0 0\nv 1 0 0\nv 1 1\n";
+		}
+		{
+			std::ofstream out(fnPLY);
+			out << "ply\nformat ascii 1.0\nelement vertex 1\n";
+		}
+		FileSTL stl(fnSTL);
+		const std::string errSTL = Message(stl);
+		CPPUNIT_ASSERT(errSTL.find(fnSTL + ", line 5: ") == 0);
+		FileOBJ obj(fnOBJ);
+		const std::string errOBJ = Message(obj);
+		CPPUNIT_ASSERT(errOBJ.find(fnOBJ + ", line 3: ") == 0);
+		FilePLY ply(fnPLY);
+		const std::string errPLY = Message(ply);
+		CPPUNIT_ASSERT(errPLY.find(fnPLY + ", line 4: ") == 0);
+
+		std::remove(fnSTL.c_str());
+		std::remove(fnOBJ.c_str());
+		std::remove(fnPLY.c_str());
+	}
+
+	void testSpeed() {
+		// Closed foot-sized ellipsoid with 250000 triangles, about the size
+		// of a foot scan
+		const size_t nu = 500;
+		const size_t nv = 251;
+		std::vector<Vector3> v;
+		std::vector<Vector3> n;
+		for (size_t j = 0; j < nv; j++) {
+			const double theta = M_PI * (double) (j + 1) / (double) (nv + 1);
+			for (size_t i = 0; i < nu; i++) {
+				const double phi = 2.0 * M_PI * (double) i / (double) nu;
+				const Vector3 d(sin(theta) * cos(phi), sin(theta) * sin(phi),
+						cos(theta));
+				v.emplace_back(0.13 * d.x, 0.05 * d.y, 0.04 * d.z);
+				n.push_back(d);
+			}
+		}
+		std::vector<size_t> tri;
+		for (size_t j = 0; j + 1 < nv; j++) {
+			for (size_t i = 0; i < nu; i++) {
+				const size_t a = j * nu + i;
+				const size_t b = j * nu + (i + 1) % nu;
+				tri.insert(tri.end(), { a, b, b + nu });
+				tri.insert(tri.end(), { a, b + nu, a + nu });
+			}
+		}
+		const size_t T = tri.size() / 3;
+
+		const std::filesystem::path dir =
+				std::filesystem::temp_directory_path();
+		const std::string fnSTL = (dir / "TextScanner_test.stl").string();
+		const std::string fnOBJ = (dir / "TextScanner_test.obj").string();
+		const std::string fnPLY = (dir / "TextScanner_test.ply").string();
+		{
+			std::ofstream out(fnSTL);
+			out << "solid scan\n";
+			for (size_t t = 0; t < T; t++) {
+				const Vector3 &a = v[tri[3 * t]];
+				const Vector3 &b = v[tri[3 * t + 1]];
+				const Vector3 &c = v[tri[3 * t + 2]];
+				const Vector3 nt = ((b - a) * (c - a)).Normal();
+				out << " facet normal " << nt.x << ' ' << nt.y << ' ' << nt.z
+						<< "\n  outer loop\n";
+				for (const Vector3 *p : { &a, &b, &c })
+					out << "   vertex " << p->x << ' ' << p->y << ' ' << p->z
+							<< '\n';
+				out << "  endloop\n endfacet\n";
+			}
+			out << "endsolid scan\n";
+		}
+		{
+			std::ofstream out(fnOBJ);
+			out << "o scan\n";
+			for (const Vector3 &p : v)
+				out << "v " << p.x << ' ' << p.y << ' ' << p.z << '\n';
+			for (const Vector3 &p : n)
+				out << "vn " << p.x << ' ' << p.y << ' ' << p.z << '\n';
+			for (size_t t = 0; t < T; t++) {
+				out << 'f';
+				for (size_t k = 0; k < 3; k++)
+					out << ' ' << tri[3 * t + k] + 1 << "//"
+							<< tri[3 * t + k] + 1;
+				out << '\n';
+			}
+		}
+		{
+			std::ofstream out(fnPLY);
+			out << "ply\nformat ascii 1.0\nelement vertex " << v.size()
+					<< "\nproperty float x\nproperty float y\n"
+							"property float z\nelement face " << T
+					<< "\nproperty list uchar int vertex_indices\n"
+							"end_header\n";
+			for (const Vector3 &p : v)
+				out << p.x << ' ' << p.y << ' ' << p.z << '\n';
+			for (size_t t = 0; t < T; t++)
+				out << "3 " << tri[3 * t] << ' ' << tri[3 * t + 1] << ' '
+						<< tri[3 * t + 2] << '\n';
+		}
+
+		auto Time = [T](const std::string &name, const std::string &filename,
+				FileGeometry &file) {
+			Geometry geo;
+			StopWatch watch;
+			watch.Start();
+			file.Read(geo);
+			watch.Stop();
+			std::cout << "\nASCII " << name << ": "
+					<< std::filesystem::file_size(filename) / (1024 * 1024)
+					<< " MiB, " << geo.CountTriangles() << " triangles, "
+					<< watch.GetSecondsCPU() << " s\n";
+			CPPUNIT_ASSERT_EQUAL(T, geo.CountTriangles());
+			return geo.CountVertices();
+		};
+		FileSTL stl(fnSTL);
+		Time("STL", fnSTL, stl);
+		FileOBJ obj(fnOBJ);
+		CPPUNIT_ASSERT_EQUAL(v.size(), Time("OBJ", fnOBJ, obj));
+		FilePLY ply(fnPLY);
+		CPPUNIT_ASSERT_EQUAL(v.size(), Time("PLY", fnPLY, ply));
+
+		std::remove(fnSTL.c_str());
+		std::remove(fnOBJ.c_str());
+		std::remove(fnPLY.c_str());
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TextScannerTest);
+#endif
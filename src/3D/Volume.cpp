@@ -27,9 +27,10 @@
 #include "Volume.h"
 
 #include "../StdInclude.h"
+#include "../system/Cancellation.h"
+#include "../system/ThreadPool.h"
 
-#include "Triangle.h"
-
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
@@ -516,505 +517,285 @@ const static uint16_t edge[256] = { 0, 265, 515, 778, 2060, 2309, 2575, 2822,
 		3840, 3593, 3331, 3082, 1804, 1541, 1295, 1030, 2822, 2575, 2309, 2060,
 		778, 515, 265, 0 };
 
-const static int8_t cap[144] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, 7, 1, 0,
-		-1, -1, -1, -1, -1, -1, 3, 2, 1, -1, -1, -1, -1, -1, -1, 3, 2, 0, 7, 3,
-		0, -1, -1, -1, 5, 4, 3, -1, -1, -1, -1, -1, -1, 7, 1, 0, 5, 4, 3, -1,
-		-1, -1, 5, 2, 1, 5, 4, 2, -1, -1, -1, 0, 7, 2, 5, 4, 2, 7, 5, 2, 6, 5,
-		7, -1, -1, -1, -1, -1, -1, 6, 1, 0, 6, 5, 1, -1, -1, -1, 3, 2, 1, 7, 6,
-		5, -1, -1, -1, 3, 2, 0, 5, 3, 0, 6, 5, 0, 4, 3, 7, 6, 4, 7, -1, -1, -1,
-		1, 0, 6, 3, 1, 6, 4, 3, 6, 2, 1, 4, 1, 7, 4, 7, 6, 4, 4, 2, 0, 6, 4, 0,
-		-1, -1, -1 };
+// Start and end corner of the 12 edges of a cell
+const static uint8_t edgeStart[12] = { 0, 1, 2, 0, 4, 5, 6, 4, 0, 1, 3, 2 };
+const static uint8_t edgeEnd[12] = { 1, 3, 3, 2, 5, 7, 7, 6, 4, 5, 7, 6 };
+
+/*!\brief Result of the marching cubes for the cells between two Z-layers
+ *
+ * The vertices are indexed locally. For joining the slabs the indices of the
+ * vertices on the X- and Y-edges and on the nodes of the first and the last
+ * layer are kept.
+ */
+struct MarchingSlab {
+	std::vector<Vector3> v;
+	std::vector<uint32_t> t; ///< Three vertex indices per triangle
+	std::vector<uint32_t> firstX;
+	std::vector<uint32_t> firstY;
+	std::vector<uint32_t> firstN;
+	std::vector<uint32_t> lastX;
+	std::vector<uint32_t> lastY;
+	std::vector<uint32_t> lastN;
+};
+
+/*!\brief Marching cubes for the cells k0 <= k < k1
+ *
+ * Every vertex sits on an edge of the grid. The index of the vertex is
+ * cached for the edge, so that neighboring cells reuse it. Two layers of X-
+ * and Y-edges and one layer of Z-edges are kept.
+ *
+ * If a node of the grid has exactly the value of the surface, all edges
+ * ending there would put a vertex onto the node. These vertices are cached
+ * per node (two layers), so that there is only one vertex on each node.
+ */
+static void MarchSlab(const double *f, size_t Nx, size_t Ny, size_t k0,
+		size_t k1, double surface, double dx, double dy, double dz,
+		MarchingSlab &s) {
+	const uint32_t none = UINT32_MAX;
+	const size_t L = Nx * Ny;
+	std::vector<uint32_t> bx(L, none);
+	std::vector<uint32_t> by(L, none);
+	std::vector<uint32_t> tx(L, none);
+	std::vector<uint32_t> ty(L, none);
+	std::vector<uint32_t> ez(L, none);
+	std::vector<uint32_t> bn(L, none);
+	std::vector<uint32_t> tn(L, none);
+
+	// Offset in the layer of the 12 edges of a cell
+	const size_t offset[12] = { 0, 1, Nx, 0, 0, 1, Nx, 0, 0, 1, Nx + 1, Nx };
+
+	double v[8];
+	uint32_t q[12];
+	for (size_t k = k0; k < k1; k++) {
+		Cancellation::Check();
+		uint32_t *cache[12] = { bx.data(), by.data(), bx.data(), by.data(),
+				tx.data(), ty.data(), tx.data(), ty.data(), ez.data(), ez.data(),
+				ez.data(), ez.data() };
+		for (size_t j = 0; j + 1 < Ny; j++) {
+			for (size_t i = 0; i + 1 < Nx; i++) {
+				const size_t c = i + Nx * (j + Ny * k);
+				v[0] = f[c];
+				v[1] = f[c + 1];
+				v[2] = f[c + Nx];
+				v[3] = f[c + 1 + Nx];
+				v[4] = f[c + L];
+				v[5] = f[c + 1 + L];
+				v[6] = f[c + Nx + L];
+				v[7] = f[c + 1 + Nx + L];
+				uint8_t m = 0;
+				for (uint_fast8_t n = 0; n < 8; n++)
+					if (v[n] > surface)
+						m |= (uint8_t) 1 << n;
+				if (m == 0 || m == 255)
+					continue;
+
+				const uint16_t h = edge[m];
+				for (uint_fast8_t e = 0; e < 12; e++) {
+					if (!(h & ((uint16_t) 1 << e)))
+						continue;
+					uint32_t &idx = cache[e][i + Nx * j + offset[e]];
+					if (idx == none) {
+						const uint8_t a = edgeStart[e];
+						const uint8_t b = edgeEnd[e];
+						const float x = (surface - v[a]) / (v[b] - v[a]);
+						if (x <= 0.0f || x >= 1.0f) {
+							const uint8_t p = (x <= 0.0f) ? a : b;
+							const size_t ni = i + (p & 1);
+							const size_t nj = j + ((p >> 1) & 1);
+							uint32_t &node = ((p >> 2) ? tn : bn)[ni + Nx * nj];
+							if (node == none) {
+								node = (uint32_t) s.v.size();
+								s.v.emplace_back(ni * dx, nj * dy,
+										(k + (p >> 2)) * dz);
+							}
+							idx = node;
+						} else {
+							const Vector3 pa((i + (a & 1)) * dx,
+									(j + ((a >> 1) & 1)) * dy,
+									(k + (a >> 2)) * dz);
+							const Vector3 pb((i + (b & 1)) * dx,
+									(j + ((b >> 1) & 1)) * dy,
+									(k + (b >> 2)) * dz);
+							idx = (uint32_t) s.v.size();
+							s.v.push_back(pa + (pb - pa) * x);
+						}
+					}
+					q[e] = idx;
+				}
 
-void Volume::CalcSurface() {
-//	setlocale(LC_ALL, "C"); // To get a 3.1415 instead 3,1415 or else on every computer.
+				const int8_t *tr = tri + 12 * m;
+				for (uint_fast8_t n = 0; n < 12 && tr[n] != -1; n += 3) {
+					s.t.push_back(q[tr[n + 2]]);
+					s.t.push_back(q[tr[n + 1]]);
+					s.t.push_back(q[tr[n]]);
+				}
+			}
+		}
+		if (k == k0) {
+			s.firstX = bx;
+			s.firstY = by;
+			s.firstN = bn;
+		}
+		// The top layer becomes the bottom layer of the next cells.
+		std::swap(bx, tx);
+		std::swap(by, ty);
+		std::swap(bn, tn);
+		std::fill(tx.begin(), tx.end(), none);
+		std::fill(ty.begin(), ty.end(), none);
+		std::fill(tn.begin(), tn.end(), none);
+		std::fill(ez.begin(), ez.end(), none);
+	}
+	s.lastX = bx;
+	s.lastY = by;
+	s.lastN = bn;
+}
 
+void Volume::CalcSurface(unsigned int threads) {
 	const size_t Nx = Size(0);
 	const size_t Ny = Size(1);
 	const size_t Nz = Size(2);
 
 	geometry.Clear();
-	Vector3 p(0, 0, 0);
-	Vector3 p0;
-	Vector3 p1;
-	Vector3 p2;
-	Vector3 p3;
-	Vector3 p4;
-	Vector3 p5;
-	Vector3 p6;
-	Vector3 p7;
-	Vector3 p8;
-	Vector3 p9;
-	Vector3 p10;
-	Vector3 p11;
-	Triangle t;
-	unsigned int c = 0;
-	for (size_t k = 0; k < Nz - 1; k++) {
-		for (size_t j = 0; j < Ny - 1; j++) {
-			for (size_t i = 0; i < Nx - 1; i++) {
-
-				const double v0 = operator[](c);
-				const double v1 = operator[](c + 1);
-				const double v2 = operator[](c + Nx);
-				const double v3 = operator[](c + 1 + Nx);
-				const double v4 = operator[](c + Nx * Ny);
-				const double v5 = operator[](c + 1 + Nx * Ny);
-				const double v6 = operator[](c + Nx * (1 + Ny));
-				const double v7 = operator[](c + 1 + Nx * (1 + Ny));
-				uint8_t v = 0;
-				if (v0 > surface)
-					v |= 1;
-				if (v1 > surface)
-					v |= 2;
-				if (v2 > surface)
-					v |= 4;
-				if (v3 > surface)
-					v |= 8;
-				if (v4 > surface)
-					v |= 16;
-				if (v5 > surface)
-					v |= 32;
-				if (v6 > surface)
-					v |= 64;
-				if (v7 > surface)
-					v |= 128;
-				if (v != 0 && v != 255) {
-
-					uint16_t h = edge[v];
-					if (h & ((uint16_t) 1 << 0)) {
-						const float x = (surface - v0) / (v1 - v0);
-						p0.x = p.x;
-						p0.y = p.y;
-						p0.z = p.z;
-						p0.x += dx * x;
-					}
-					if (h & ((uint16_t) 1 << 1)) {
-						const float x = (surface - v1) / (v3 - v1);
-						p1.x = p.x + dx;
-						p1.y = p.y;
-						p1.z = p.z;
-						p1.y += dy * x;
-					}
-					if (h & ((uint16_t) 1 << 2)) {
-						const float x = (surface - v2) / (v3 - v2);
-						p2.x = p.x;
-						p2.y = p.y + dy;
-						p2.z = p.z;
-						p2.x += dx * x;
-					}
-					if (h & ((uint16_t) 1 << 3)) {
-						const float x = (surface - v0) / (v2 - v0);
-						p3.x = p.x;
-						p3.y = p.y;
-						p3.z = p.z;
-						p3.y += dy * x;
-					}
-					if (h & ((uint16_t) 1 << 4)) {
-						const float x = (surface - v4) / (v5 - v4);
-						p4.x = p.x;
-						p4.y = p.y;
-						p4.z = p.z + dz;
-						p4.x += dx * x;
-					}
-					if (h & ((uint16_t) 1 << 5)) {
-						const float x = (surface - v5) / (v7 - v5);
-						p5.x = p.x + dx;
-						p5.y = p.y;
-						p5.z = p.z + dz;
-						p5.y += dy * x;
-					}
-					if (h & ((uint16_t) 1 << 6)) {
-						const float x = (surface - v6) / (v7 - v6);
-						p6.x = p.x;
-						p6.y = p.y + dy;
-						p6.z = p.z + dz;
-						p6.x += dx * x;
-					}
-					if (h & ((uint16_t) 1 << 7)) {
-						const float x = (surface - v4) / (v6 - v4);
-						p7.x = p.x;
-						p7.y = p.y;
-						p7.z = p.z + dz;
-						p7.y += dy * x;
-					}
-					if (h & ((uint16_t) 1 << 8)) {
-						const float x = (surface - v0) / (v4 - v0);
-						p8.x = p.x;
-						p8.y = p.y;
-						p8.z = p.z;
-						p8.z += dz * x;
-					}
-					if (h & ((uint16_t) 1 << 9)) {
-						const float x = (surface - v1) / (v5 - v1);
-						p9.x = p.x + dx;
-						p9.y = p.y;
-						p9.z = p.z;
-						p9.z += dz * x;
-					}
-					if (h & ((uint16_t) 1 << 10)) {
-						const float x = (surface - v3) / (v7 - v3);
-						p10.x = p.x + dx;
-						p10.y = p.y + dy;
-						p10.z = p.z;
-						p10.z += dz * x;
-					}
-					if (h & ((uint16_t) 1 << 11)) {
-						const float x = (surface - v2) / (v6 - v2);
-						p11.x = p.x;
-						p11.y = p.y + dy;
-						p11.z = p.z;
-						p11.z += dz * x;
-					}
-
-					uint16_t h2 = v * 12;
-					for (uint_fast8_t n = 0; n < 12; n++) {
-						if (tri[h2] == -1)
-							break;
-						switch (tri[h2]) {
-						case 0:
-							t.p[2 - (n % 3)] = p0;
-							break;
-						case 1:
-							t.p[2 - (n % 3)] = p1;
-							break;
-						case 2:
-							t.p[2 - (n % 3)] = p2;
-							break;
-						case 3:
-							t.p[2 - (n % 3)] = p3;
-							break;
-						case 4:
-							t.p[2 - (n % 3)] = p4;
-							break;
-						case 5:
-							t.p[2 - (n % 3)] = p5;
-							break;
-						case 6:
-							t.p[2 - (n % 3)] = p6;
-							break;
-						case 7:
-							t.p[2 - (n % 3)] = p7;
-							break;
-						case 8:
-							t.p[2 - (n % 3)] = p8;
-							break;
-						case 9:
-							t.p[2 - (n % 3)] = p9;
-							break;
-						case 10:
-							t.p[2 - (n % 3)] = p10;
-							break;
-						case 11:
-							t.p[2 - (n % 3)] = p11;
-							break;
-						default:
-							break;
-						}
-
-//					if(t.p[2 - (n % 3)].Abs() < 0.001){
-//						break;
-//					}
-
-						if (n % 3 == 2) {
-							const size_t idx0 = geometry.CountVertices();
-							geometry.AddVertex(t.p[0]);
-							const size_t idx1 = geometry.CountVertices();
-							geometry.AddVertex(t.p[1]);
-							const size_t idx2 = geometry.CountVertices();
-							geometry.AddVertex(t.p[2]);
-							geometry.AddTriangle(idx0, idx1, idx2);
-						}
-						h2++;
-					}
-				}
-				/*
-				 if(i == 0){
-				 uint8_t v = 0;
-				 if(v0 > surface) v |= 1;
-				 if(v2 > surface) v |= 2;
-				 if(v6 > surface) v |= 4;
-				 if(v4 > surface) v |= 8;
-				 if(v > 0){
-				 uint8_t h = v * 9;
-				 for(uint_fast8_t n = 0; n < 9; n++){
-				 if(cap[h] == -1) break;
-				 switch(cap[h]){
-				 case 0:
-				 t.p[n % 3] = p;
-				 break;
-				 case 1:
-				 t.p[n % 3] = p3;
-				 break;
-				 case 2:
-				 t.p[n % 3].Set(p.x, p.y + dy, p.z);
-				 break;
-				 case 3:
-				 t.p[n % 3] = p11;
-				 break;
-				 case 4:
-				 t.p[n % 3].Set(p.x, p.y + dy, p.z + dz);
-				 break;
-				 case 5:
-				 t.p[n % 3] = p7;
-				 break;
-				 case 6:
-				 t.p[n % 3].Set(p.x, p.y, p.z + dz);
-				 break;
-				 case 7:
-				 t.p[n % 3] = p8;
-				 break;
-				 }
-				 if(n % 3 == 2) geometry.AddTriangle(t, false);
-				 h++;
-				 }
-
-				 }
-
-				 }
-
-				 if(i + 2 == Nx){
-				 uint8_t v = 0;
-				 if(v1 > surface) v |= 1;
-				 if(v5 > surface) v |= 2;
-				 if(v7 > surface) v |= 4;
-				 if(v3 > surface) v |= 8;
-				 if(v > 0){
-				 uint8_t h = v * 9;
-				 for(uint_fast8_t n = 0; n < 9; n++){
-				 if(cap[h] == -1) break;
-				 switch(cap[h]){
-				 case 0:
-				 t.p[n % 3].Set(p.x + dx, p.y, p.z);
-				 break;
-				 case 1:
-				 t.p[n % 3] = p9;
-				 break;
-				 case 2:
-				 t.p[n % 3].Set(p.x + dx, p.y, p.z + dz);
-				 break;
-				 case 3:
-				 t.p[n % 3] = p5;
-				 break;
-				 case 4:
-				 t.p[n % 3].Set(p.x + dx, p.y + dy, p.z + dz);
-				 break;
-				 case 5:
-				 t.p[n % 3] = p10;
-				 break;
-				 case 6:
-				 t.p[n % 3].Set(p.x + dx, p.y + dy, p.z);
-				 break;
-				 case 7:
-				 t.p[n % 3] = p1;
-				 break;
-				 }
-				 if(n % 3 == 2) geometry.AddTriangle(t, false);
-				 h++;
-				 }
-
-				 }
-
-				 }
-
-				 if(j == 0){
-				 uint8_t v = 0;
-				 if(v0 > surface) v |= 1;
-				 if(v4 > surface) v |= 2;
-				 if(v5 > surface) v |= 4;
-				 if(v1 > surface) v |= 8;
-				 if(v > 0){
-				 uint8_t h = v * 9;
-				 for(uint_fast8_t n = 0; n < 9; n++){
-				 if(cap[h] == -1) break;
-				 switch(cap[h]){
-				 case 0:
-				 t.p[n % 3] = p;
-				 break;
-				 case 1:
-				 t.p[n % 3] = p8;
-				 break;
-				 case 2:
-				 t.p[n % 3].Set(p.x, p.y, p.z + dz);
-				 break;
-				 case 3:
-				 t.p[n % 3] = p4;
-				 break;
-				 case 4:
-				 t.p[n % 3].Set(p.x + dx, p.y, p.z + dz);
-				 break;
-				 case 5:
-				 t.p[n % 3] = p9;
-				 break;
-				 case 6:
-				 t.p[n % 3].Set(p.x + dx, p.y, p.z);
-				 break;
-				 case 7:
-				 t.p[n % 3] = p0;
-				 break;
-				 }
-				 if(n % 3 == 2) geometry.AddTriangle(t, false);
-				 h++;
-				 }
-
-				 }
-
-				 }
-
-				 if(j + 2 == Ny){
-				 uint8_t v = 0;
-				 if(v2 > surface) v |= 1;
-				 if(v3 > surface) v |= 2;
-				 if(v7 > surface) v |= 4;
-				 if(v6 > surface) v |= 8;
-				 if(v > 0){
-				 uint8_t h = v * 9;
-				 for(uint_fast8_t n = 0; n < 9; n++){
-				 if(cap[h] == -1) break;
-				 switch(cap[h]){
-				 case 0:
-				 t.p[n % 3].Set(p.x, p.y + dy, p.z);
-				 break;
-				 case 1:
-				 t.p[n % 3] = p2;
-				 break;
-				 case 2:
-				 t.p[n % 3].Set(p.x + dx, p.y + dy, p.z);
-				 break;
-				 case 3:
-				 t.p[n % 3] = p10;
-				 break;
-				 case 4:
-				 t.p[n % 3].Set(p.x + dx, p.y + dy, p.z + dz);
-				 break;
-				 case 5:
-				 t.p[n % 3] = p6;
-				 break;
-				 case 6:
-				 t.p[n % 3].Set(p.x, p.y + dy, p.z + dz);
-				 break;
-				 case 7:
-				 t.p[n % 3] = p11;
-				 break;
-				 }
-				 if(n % 3 == 2) geometry.AddTriangle(t, false);
-				 h++;
-				 }
-
-				 }
-
-				 }
-
-				 if(k == 0){
-				 uint8_t v = 0;
-				 if(v0 > surface) v |= 1;
-				 if(v1 > surface) v |= 2;
-				 if(v3 > surface) v |= 4;
-				 if(v2 > surface) v |= 8;
-				 if(v > 0){
-				 uint8_t h = v * 9;
-				 for(uint_fast8_t n = 0; n < 9; n++){
-				 if(cap[h] == -1) break;
-				 switch(cap[h]){
-				 case 0:
-				 t.p[n % 3] = p;
-				 break;
-				 case 1:
-				 t.p[n % 3] = p0;
-				 break;
-				 case 2:
-				 t.p[n % 3].Set(p.x + dx, p.y, p.z);
-				 break;
-				 case 3:
-				 t.p[n % 3] = p1;
-				 break;
-				 case 4:
-				 t.p[n % 3].Set(p.x + dx, p.y + dy, p.z);
-				 break;
-				 case 5:
-				 t.p[n % 3] = p2;
-				 break;
-				 case 6:
-				 t.p[n % 3].Set(p.x, p.y + dy, p.z);
-				 break;
-				 case 7:
-				 t.p[n % 3] = p3;
-				 break;
-				 }
-				 if(n % 3 == 2) geometry.AddTriangle(t, false);
-				 h++;
-				 }
-
-				 }
+	if (Nx < 2 || Ny < 2 || Nz < 2)
+		return;
 
-				 }
+	// Split the cells into slabs along Z.
+	if (threads == 0)
+		threads = ThreadPool::GetThreads();
+	const size_t S = std::min<size_t>(threads, Nz - 1);
+	std::vector<MarchingSlab> slabs(S);
+	auto Run = [&](size_t n) {
+		MarchSlab(data(), Nx, Ny, (Nz - 1) * n / S, (Nz - 1) * (n + 1) / S,
+				surface, dx, dy, dz, slabs[n]);
+	};
+	ThreadPool::ForEach(S, Run, threads);
+
+	// Append the slabs to the geometry. The vertices on the first layer of a
+	// slab were already added by the previous slab. Every edge of the mesh is
+	// added once, found by a linked list of the edges starting at a vertex.
+	// Triangles collapsed or doubled by the vertices on the nodes are skipped,
+	// as Geometry::Join() would do.
+	const size_t none = (size_t) -1;
+	std::vector<size_t> prevX;
+	std::vector<size_t> prevY;
+	std::vector<size_t> prevN;
+	std::vector<size_t> vmap;
+	std::vector<size_t> edgeHead;
+	std::vector<size_t> edgeNext;
+	std::vector<size_t> edgeOther;
+	auto AddEdge = [&](size_t a, size_t b) {
+		if (a > b)
+			std::swap(a, b);
+		for (size_t ed = edgeHead[a]; ed != none; ed = edgeNext[ed])
+			if (edgeOther[ed] == b)
+				return ed;
+		const size_t ed = edgeNext.size();
+		edgeNext.push_back(edgeHead[a]);
+		edgeOther.push_back(b);
+		edgeHead[a] = ed;
+		geometry.AddEdge(a, b);
+		return ed;
+	};
+	// Is there a triangle with the same vertices at the edge a-b already?
+	const Geometry &g = geometry;
+	auto IsDoubled = [&g](size_t ed, size_t a, size_t b, size_t c) {
+		const Geometry::Edge &edge = g.GetEdge(ed);
+		for (size_t n = 0; n < std::min<size_t>(edge.trianglecount, 2); n++) {
+			const Geometry::Triangle &tri = g.GetTriangle(
+					(n == 0) ? edge.ta : edge.tb);
+			if ((tri.va == a || tri.vb == a || tri.vc == a)
+					&& (tri.va == b || tri.vb == b || tri.vc == b)
+					&& (tri.va == c || tri.vb == c || tri.vc == c))
+				return true;
+		}
+		return false;
+	};
+	for (size_t n = 0; n < S; n++) {
+		Cancellation::Check();
+		const MarchingSlab &s = slabs[n];
+		vmap.assign(s.v.size(), none);
+		if (n > 0) {
+			for (size_t c = 0; c < Nx * Ny; c++) {
+				if (s.firstX[c] != UINT32_MAX && prevX[c] != none)
+					vmap[s.firstX[c]] = prevX[c];
+				if (s.firstY[c] != UINT32_MAX && prevY[c] != none)
+					vmap[s.firstY[c]] = prevY[c];
+				if (s.firstN[c] != UINT32_MAX && prevN[c] != none)
+					vmap[s.firstN[c]] = prevN[c];
+			}
+		}
+		for (size_t i = 0; i < s.v.size(); i++) {
+			if (vmap[i] != none)
+				continue;
+			vmap[i] = geometry.CountVertices();
+			geometry.AddVertex(s.v[i]);
+		}
+		edgeHead.resize(geometry.CountVertices(), none);
+		for (size_t i = 0; i < s.t.size(); i += 3) {
+			const size_t a = vmap[s.t[i]];
+			const size_t b = vmap[s.t[i + 1]];
+			const size_t c = vmap[s.t[i + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+			const size_t eab = AddEdge(a, b);
+			const size_t ebc = AddEdge(b, c);
+			const size_t eca = AddEdge(c, a);
+			if (IsDoubled(eab, a, b, c))
+				continue;
+			geometry.AddTriangleFromEdges(eab, ebc, eca);
+			geometry.GetTriangle(geometry.CountTriangles() - 1).Fix();
+		}
+		prevX.assign(Nx * Ny, none);
+		prevY.assign(Nx * Ny, none);
+		prevN.assign(Nx * Ny, none);
+		for (size_t c = 0; c < Nx * Ny; c++) {
+			if (s.lastX[c] != UINT32_MAX)
+				prevX[c] = vmap[s.lastX[c]];
+			if (s.lastY[c] != UINT32_MAX)
+				prevY[c] = vmap[s.lastY[c]];
+			if (s.lastN[c] != UINT32_MAX)
+				prevN[c] = vmap[s.lastN[c]];
+		}
+	}
+	update = true;
+}
 
-				 if(k + 2 == Nz){
-				 uint8_t v = 0;
-				 if(v4 > surface) v |= 1;
-				 if(v6 > surface) v |= 2;
-				 if(v7 > surface) v |= 4;
-				 if(v5 > surface) v |= 8;
-				 if(v > 0){
-				 uint8_t h = v * 9;
-				 for(uint_fast8_t n = 0; n < 9; n++){
-				 if(cap[h] == -1) break;
-				 switch(cap[h]){
-				 case 0:
-				 t.p[n % 3].Set(p.x, p.y, p.z + dz);
-				 break;
-				 case 1:
-				 t.p[n % 3] = p7;
-				 break;
-				 case 2:
-				 t.p[n % 3].Set(p.x, p.y + dy, p.z + dz);
-				 break;
-				 case 3:
-				 t.p[n % 3] = p6;
-				 break;
-				 case 4:
-				 t.p[n % 3].Set(p.x + dx, p.y + dy, p.z + dz);
-				 break;
-				 case 5:
-				 t.p[n % 3] = p5;
-				 break;
-				 case 6:
-				 t.p[n % 3].Set(p.x + dx, p.y, p.z + dz);
-				 break;
-				 case 7:
-				 t.p[n % 3] = p4;
-				 break;
-				 }
-				 if(n % 3 == 2) geometry.AddTriangle(t, false);
-				 h++;
-				 }
+void Volume::MarchCube(const double v[8], double surface, const Vector3 &p,
+		double dx, double dy, double dz, Geometry &geometry) {
+	uint8_t m = 0;
+	for (uint_fast8_t n = 0; n < 8; n++)
+		if (v[n] > surface)
+			m |= (uint8_t) 1 << n;
+	if (m == 0 || m == 255)
+		return;
 
-				 }
+	Vector3 q[12];
+	const uint16_t h = edge[m];
+	for (uint_fast8_t e = 0; e < 12; e++) {
+		if (!(h & ((uint16_t) 1 << e)))
+			continue;
+		const uint8_t a = edgeStart[e];
+		const uint8_t b = edgeEnd[e];
+		const float x = (surface - v[a]) / (v[b] - v[a]);
+		const Vector3 pa(dx * (a & 1), dy * ((a >> 1) & 1), dz * (a >> 2));
+		const Vector3 pb(dx * (b & 1), dy * ((b >> 1) & 1), dz * (b >> 2));
+		q[e] = p + pa + (pb - pa) * x;
+	}
 
-				 }
-				 */
-				p.x += dx;
-				c++; // Advance c to next cell
-			}
-			c++; // Add the missing cell at then end of a Nx column
-			p.x = 0;
-			p.y += dy;
+	Vector3 t[3];
+	const int8_t *tr = tri + 12 * m;
+	for (uint_fast8_t n = 0; n < 12; n++) {
+		if (tr[n] == -1)
+			break;
+		t[2 - (n % 3)] = q[tr[n]];
+		if (n % 3 == 2) {
+			const size_t idx0 = geometry.CountVertices();
+			geometry.AddVertex(t[0]);
+			geometry.AddVertex(t[1]);
+			geometry.AddVertex(t[2]);
+			geometry.AddTriangle(idx0, idx0 + 1, idx0 + 2);
 		}
-		c += Nx; // Add the missing cells at the end of a Ny row
-		p.y = 0;
-		p.z += dz;
 	}
-//	for(n = 0; n < triangles.GetCount(); n++)
-//		triangles[n].CalculateNormal();
-//	temp.AddLine(_T("];"));
-//	temp.AddLine(_T("M=reshape(M,149,[]);"));
-//	temp.AddLine(_T("%M=M-min(min(M));"));
-//	temp.AddLine(_T("%M=M/max(max(M));"));
-//	temp.AddLine(
-//			_T(
-//					"[X,Y] = ndgrid(linspace(0,0.3,149)-0.075,linspace(0,0.2,99)-0.075);"));
-//	temp.Write();
-//	setlocale(LC_ALL, "");
-
-	update = true;
 }
 
 void Volume::PaintSurface() const {
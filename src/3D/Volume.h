@@ -90,8 +90,28 @@ public:
 	 * Run the Marching-Cubes algorithm to generate a geometry of the surface
 	 * of the data in the volume. The surface is assumed at the level of the
 	 * internal variable "surface".
+	 *
+	 * The cells are processed in slabs along Z in parallel. Every vertex on
+	 * an edge of the grid is created only once, and so is every edge of the
+	 * mesh. The geometry is connected without a call to Geometry::Join().
+	 *
+	 * \param threads Number of threads, 0 for one per core
+	 */
+	void CalcSurface(unsigned int threads = 0);
+
+	/*! \brief Marching cubes for a single cell
+	 *
+	 * Appends the triangles of one cell to a Geometry. The corners of the cell
+	 * are numbered with X as the first axis: v[0] is at p, v[1] at p + (dx,0,0),
+	 * v[2] at p + (0,dy,0), v[3] at p + (dx,dy,0), v[4] at p + (0,0,dz), ...
+	 *
+	 * \param v Values at the 8 corners of the cell
+	 * \param surface Level of the surface
+	 * \param p Position of corner 0
+	 * \param geometry Geometry to append the triangles to
 	 */
-	void CalcSurface();
+	static void MarchCube(const double v[8], double surface, const Vector3 &p,
+			double dx, double dy, double dz, Geometry &geometry);
 
 	/*! \brief Render the data
 	 *
@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Volume_test.cpp
+// Purpose            : Marching cubes of the Volume
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "Volume.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "../system/StopWatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+class VolumeTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( VolumeTest );
+	CPPUNIT_TEST(testCalcSurface);
+	CPPUNIT_TEST(testNodes);
+	CPPUNIT_TEST(testSpeed);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	/**\brief 26 bones scattered in a foot-sized box
+	 */
+	struct Bone {
+		Vector3 p1;
+		Vector3 p2;
+		double r1;
+		double r2;
+		double s;
+	};
+	static std::vector<Bone> Bones() {
+		std::mt19937 gen(42);
+		std::uniform_real_distribution<double> ux(0.0, 0.25);
+		std::uniform_real_distribution<double> uy(-0.04, 0.04);
+		std::uniform_real_distribution<double> uz(0.0, 0.08);
+		std::uniform_real_distribution<double> ur(0.005, 0.015);
+		std::vector<Bone> bones;
+		for (size_t n = 0; n < 26; n++) {
+			const Vector3 p1(ux(gen), uy(gen), uz(gen));
+			const Vector3 p2 = p1
+					+ Vector3(ux(gen) / 5.0, uy(gen) / 2.0, uz(gen) / 4.0);
+			bones.push_back( { p1, p2, ur(gen), ur(gen), 0.005 });
+		}
+		return bones;
+	}
+
+	static void Setup(Volume &vol, double cells) {
+		const double res = cbrt(0.33 * 0.14 * 0.14 / cells);
+		vol.SetExtent(0.33, 0.14, 0.14, res);
+		vol.SetOrigin(Vector3(-0.03, -0.07, -0.03));
+		vol.Clear();
+	}
+
+	void testCalcSurface() {
+		const std::vector<Bone> bones = Bones();
+		Volume vol;
+		Setup(vol, 200000);
+		for (const Bone &b : bones)
+			vol.AddCylinder(b.p1, b.p2, b.r1 + b.s, b.r2 + b.s, b.s);
+		vol.surface = 0.3;
+
+		// Reference: every cell on its own with duplicated vertices
+		Geometry ref;
+		const size_t Nx = vol.Size(0);
+		const size_t Ny = vol.Size(1);
+		const size_t Nz = vol.Size(2);
+		double v[8];
+		for (size_t k = 0; k + 1 < Nz; k++)
+			for (size_t j = 0; j + 1 < Ny; j++)
+				for (size_t i = 0; i + 1 < Nx; i++) {
+					for (size_t n = 0; n < 8; n++)
+						v[n] = vol[i + (n & 1)
+								+ Nx * (j + ((n >> 1) & 1) + Ny * (k + (n >> 2)))];
+					Volume::MarchCube(v, vol.surface,
+							Vector3(i * vol.dx, j * vol.dy, k * vol.dz), vol.dx,
+							vol.dy, vol.dz, ref);
+				}
+
+		for (unsigned int threads : { 1, 3 }) {
+			vol.CalcSurface(threads);
+			const Geometry &geo = vol.geometry;
+			CPPUNIT_ASSERT_EQUAL(ref.CountTriangles(), geo.CountTriangles());
+			CPPUNIT_ASSERT_EQUAL(ref.CountVertices(), 3 * geo.CountTriangles());
+			CPPUNIT_ASSERT(geo.CountVertices() < geo.CountTriangles());
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.GetArea(), geo.GetArea(), 1e-9);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.GetVolume(), geo.GetVolume(), 1e-9);
+			CPPUNIT_ASSERT(geo.PassedSelfCheck(false));
+			// Every edge of the mesh is shared by at most two triangles.
+			// (The table has holes for ambiguous faces, so some have one.)
+			for (size_t n = 0; n < geo.CountEdges(); n++)
+				CPPUNIT_ASSERT(geo.GetEdge(n).trianglecount <= 2);
+		}
+	}
+
+	void testNodes() {
+		// The surface passes exactly through nodes of the grid, that are
+		// shared by several edges crossing the surface: An octahedron and a
+		// plane with the inside on both sides.
+		const size_t N = 7;
+		for (size_t shape = 0; shape < 2; shape++) {
+			Volume vol;
+			vol.SetSize(N, N, N);
+			vol.dx = vol.dy = vol.dz = 1.0;
+			for (size_t k = 0; k < N; k++)
+				for (size_t j = 0; j < N; j++)
+					for (size_t i = 0; i < N; i++) {
+						const int d = std::abs((int) i - 3) + std::abs((int) j - 3)
+								+ std::abs((int) k - 3);
+						vol[i + N * (j + N * k)] =
+								(shape == 0) ? 3 - d : std::abs((int) k - 3);
+					}
+			vol.surface = (shape == 0) ? 1.0 : 0.0;
+
+			Geometry ref;
+			double v[8];
+			for (size_t k = 0; k + 1 < N; k++)
+				for (size_t j = 0; j + 1 < N; j++)
+					for (size_t i = 0; i + 1 < N; i++) {
+						for (size_t n = 0; n < 8; n++)
+							v[n] = vol[i + (n & 1)
+									+ N * (j + ((n >> 1) & 1) + N * (k + (n >> 2)))];
+						Volume::MarchCube(v, vol.surface, Vector3(i, j, k), 1.0,
+								1.0, 1.0, ref);
+					}
+			ref.Join();
+			CPPUNIT_ASSERT(ref.CountTriangles() > 0);
+
+			for (unsigned int threads : { 1, 3 }) {
+				vol.CalcSurface(threads);
+				const Geometry &geo = vol.geometry;
+				CPPUNIT_ASSERT_EQUAL(ref.CountVertices(), geo.CountVertices());
+				CPPUNIT_ASSERT_EQUAL(ref.CountEdges(), geo.CountEdges());
+				CPPUNIT_ASSERT_EQUAL(ref.CountTriangles(), geo.CountTriangles());
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.GetArea(), geo.GetArea(), 1e-9);
+				// Which side of the plane is kept, is arbitrary.
+				if (shape == 0)
+					CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.GetVolume(),
+							geo.GetVolume(), 1e-9);
+				CPPUNIT_ASSERT(geo.PassedSelfCheck(false));
+			}
+		}
+	}
+
+	void testSpeed() {
+		// Grid sizes of the dense skin and of 64 times the cells
+		const std::vector<Bone> bones = Bones();
+		for (double cells : { 50000.0, 3.2e6 }) {
+			Volume vol;
+			Setup(vol, cells);
+			StopWatch add;
+			add.Start();
+			for (const Bone &b : bones)
+				vol.AddCylinder(b.p1, b.p2, b.r1 + b.s, b.r2 + b.s, b.s);
+			for (const Bone &b : bones)
+				vol.AddSphere(b.p1, b.r1, b.s);
+			add.Stop();
+			std::cout << "\n" << vol.Numel() << " voxels, 26 cylinders and 26 "
+					"spheres: " << add.GetSecondsWall() << " s";
+
+			vol.surface = 1.5;
+			StopWatch march;
+			march.Start();
+			vol.CalcSurface();
+			march.Stop();
+			StopWatch join;
+			join.Start();
+			Geometry geo = vol.geometry;
+			geo.Join();
+			join.Stop();
+			std::cout << ", marching cubes " << march.GetSecondsWall()
+					<< " s for " << vol.geometry.CountTriangles()
+					<< " triangles (Join() would take " << join.GetSecondsWall()
+					<< " s)";
+		}
+		std::cout << "\n";
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(VolumeTest);
+
+#endif
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : main.cpp
+// Purpose            : Entry point of the headless batch build
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*!\file
+ * \brief openshoedesigner-batch
+ *
+ * Builds a project without the GUI and writes the results:
+ *
+ *  - the last as STL,
+ *  - the flattened insole as DXF,
+ *  - every patch of the flattened upper as DXF.
+ *
+ * Usage:
+ ~~~~~
+ openshoedesigner-batch [-o outdir] [-t threads] [-s left|right|both] [-p]
+                        [-c cachedir] project.json [...]
+ ~~~~~
+ *
+ * Several projects can be passed at once. They are built one after another.
+ * To build orders in parallel, start several processes with a single thread
+ * each (-t 1).
+ *
+ * With -c the imported lasts and heels are kept in a disk cache. Building the
+ * same project again (or another project with the same last) skips the
+ * import.
+ *
+ * The exit code is 0 on success, 1 for wrong arguments and 2, if a project
+ * could not be loaded or built.
+ */
+
+#include "../3D/FileDXF.h"
+#include "../3D/FileSTL.h"
+#include "../project/ProjectData.h"
+#include "../system/JSON.h"
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static void Usage(const char *name) {
+	std::cerr << "Usage: " << name
+			<< " [-o outdir] [-t threads] [-s left|right|both] [-p] [-c cachedir] project.json [...]\n";
+	std::cerr << "  -o outdir   Directory for the generated files (default: .)\n";
+	std::cerr << "  -t threads  Number of threads, 0 = all (default: 0)\n";
+	std::cerr << "  -s side     Side(s) to build (default: both)\n";
+	std::cerr << "  -p          Write the build profile as JSON next to the results\n";
+	std::cerr << "  -c cachedir Directory for the cache of imported meshes\n";
+}
+
+static void MarkNeeded(ProjectData &project, bool left, bool right) {
+	for (const std::shared_ptr<Object> &obj : std::vector<
+			std::shared_ptr<Object>> { project.lastL, project.insoleFlatL,
+			project.flatteningL }) {
+		if (left && obj)
+			obj->MarkNeeded(true);
+	}
+	for (const std::shared_ptr<Object> &obj : std::vector<
+			std::shared_ptr<Object>> { project.lastR, project.insoleFlatR,
+			project.flatteningR }) {
+		if (right && obj)
+			obj->MarkNeeded(true);
+	}
+}
+
+static size_t WriteSide(const ProjectData &project, const fs::path &prefix,
+		bool left) {
+	const std::string side = left ? "L" : "R";
+	const auto &last = left ? project.lastL : project.lastR;
+	const auto &insole = left ? project.insoleFlatL : project.insoleFlatR;
+	const auto &upper = left ? project.flatteningL : project.flatteningR;
+	size_t count = 0;
+
+	if (last && last->IsValid()) {
+		FileSTL stl(prefix.string() + "_last_" + side + ".stl");
+		stl.Write(*last);
+		count++;
+	}
+	if (insole && insole->IsValid()) {
+		FileDXF dxf(prefix.string() + "_insole_" + side + ".dxf");
+		if (insole->outline.CountEdges() > 0)
+			dxf.Write(insole->outline);
+		else
+			dxf.Write(*insole);
+		count++;
+	}
+	if (upper && upper->IsValid()) {
+		for (size_t n = 0; n < upper->patches.size(); n++) {
+			FileDXF dxf(
+					prefix.string() + "_upper_" + side + "_" + std::to_string(n)
+							+ ".dxf");
+			dxf.Write(upper->patches[n]);
+			count++;
+		}
+	}
+	return count;
+}
+
+int main(int argc, char *argv[]) {
+	fs::path outdir(".");
+	size_t threads = 0;
+	bool left = true;
+	bool right = true;
+	bool writeProfile = false;
+	std::string cachedir;
+	std::vector<std::string> files;
+
+	for (int n = 1; n < argc; n++) {
+		const std::string arg(argv[n]);
+		if (arg == "-h" || arg == "--help") {
+			Usage(argv[0]);
+			return 0;
+		}
+		if (arg == "-p") {
+			writeProfile = true;
+			continue;
+		}
+		if (arg == "-o" || arg == "-t" || arg == "-s" || arg == "-c") {
+			if (n + 1 >= argc) {
+				Usage(argv[0]);
+				return 1;
+			}
+			const std::string value(argv[++n]);
+			if (arg == "-o")
+				outdir = value;
+			if (arg == "-c")
+				cachedir = value;
+			if (arg == "-t")
+				threads = std::strtoul(value.c_str(), nullptr, 10);
+			if (arg == "-s") {
+				left = (value == "left" || value == "both");
+				right = (value == "right" || value == "both");
+				if (!left && !right) {
+					Usage(argv[0]);
+					return 1;
+				}
+			}
+			continue;
+		}
+		files.push_back(arg);
+	}
+	if (files.empty()) {
+		Usage(argv[0]);
+		return 1;
+	}
+
+	std::error_code ec;
+	fs::create_directories(outdir, ec);
+
+	int result = 0;
+	for (const std::string &filename : files) {
+		try {
+			// A new project for every file, so that no setting is left over
+			// from the last file.
+			ProjectData project;
+			project.builder.SetThreads(threads);
+			project.builder.GetCache().SetDirectory(cachedir);
+			JSON js = JSON::Load(filename);
+			project.FromJSON(js);
+			if (!project.Evaluate()) {
+				result = 2;
+				continue;
+			}
+			project.builder.Setup(project);
+			MarkNeeded(project, left, right);
+			project.builder.Update(project);
+			project.ResetModified();
+			if (!project.builder.error.empty()) {
+				std::cerr << filename << ": " << project.builder.error << "\n";
+				result = 2;
+				continue;
+			}
+			const fs::path prefix = outdir / fs::path(filename).stem();
+			size_t count = 0;
+			if (left)
+				count += WriteSide(project, prefix, true);
+			if (right)
+				count += WriteSide(project, prefix, false);
+			if (writeProfile) {
+				std::ofstream out(prefix.string() + "_profile.json");
+				project.builder.GetProfile().ToJSON(out);
+			}
+			std::cout << filename << ": " << count << " file(s) written.\n";
+		} catch (const std::exception &ex) {
+			std::cerr << filename << ": " << ex.what() << "\n";
+			result = 2;
+		}
+	}
+	return result;
+}
@@ -340,7 +340,6 @@ void FrameCalculator::OnThreadUpdate(wxThreadEvent &evt) {
 				std::cout << "Problem.\n";
 			}
 
-			geo.Join();
 			geo.CalculateNormals();
 			geo.smooth = true;
 		}
@@ -207,10 +207,11 @@ bool FrameMain::TransferDataToWindow() {
 	const FootMeasurements *meas = projectview->GetActiveFootMeasurements();
 	const auto &config = project->config;
 
+	const bool building = project->IsBuilding();
 	m_canvasInsole->insoleL =
-			(projectview->showLeft) ? project->insoleFlatL : nullptr;
+			(projectview->showLeft && !building) ? project->insoleFlatL : nullptr;
 	m_canvasInsole->insoleR =
-			(projectview->showRight) ? project->insoleFlatR : nullptr;
+			(projectview->showRight && !building) ? project->insoleFlatR : nullptr;
 	m_canvasInsole->dL = project->footL.ballWidth->ToDouble() * 0.75;
 	m_canvasInsole->dR = project->footR.ballWidth->ToDouble() * 0.75;
 
@@ -730,6 +731,7 @@ void FrameMain::OnTimer(wxTimerEvent &event) {
 
 	FrameParent *parentframe = wxStaticCast(GetParent(), FrameParent);
 	if (parentframe->mididevice && parentframe->mididevice->Poll()) {
+		project->StopBuild();
 		project->config.debugMIDI_48->SetValue(parentframe->mididevice->cc[48]);
 		project->config.debugMIDI_49->SetValue(parentframe->mididevice->cc[49]);
 		project->config.debugMIDI_50->SetValue(parentframe->mididevice->cc[50]);
@@ -30,6 +30,8 @@
 #include "Matrix.h"
 #include "Exporter.h"
 
+#include "../system/Cancellation.h"
+
 #include <iostream>
 
 static const size_t nothing = (size_t) -1;
@@ -67,6 +69,7 @@ void EnergyRelease::InitByUniformDimension(Geometry &geo,
 	std::set<size_t> fixed = { 0 };
 	bool updated = true;
 	while (updated) {
+		Cancellation::Check();
 		updated = false;
 		for (size_t idx = 0; idx < geo.CountEdges(); idx++) {
 			const Geometry::Edge &ed = geo.GetEdge(idx);
@@ -281,6 +281,26 @@ std::string MathParser::VM::Instruction::ToString(bool withParam) const {
 	case OpCode::DIV:
 		buffer << "DIV";
 		break;
+	case OpCode::ADD_C:
+		buffer << "ADD_C";
+		if (withParam)
+			buffer << '(' << value << ')';
+		break;
+	case OpCode::SUB_C:
+		buffer << "SUB_C";
+		if (withParam)
+			buffer << '(' << value << ')';
+		break;
+	case OpCode::MULT_C:
+		buffer << "MULT_C";
+		if (withParam)
+			buffer << '(' << value << ')';
+		break;
+	case OpCode::DIV_C:
+		buffer << "DIV_C";
+		if (withParam)
+			buffer << '(' << value << ')';
+		break;
 	case OpCode::MOD:
 		buffer << "MOD";
 		break;
@@ -519,32 +539,64 @@ void MathParser::VM::StepOpCode() {
 	}
 
 	case OpCode::ADD: {
-		const Value a = stack.back();
+		const Value &a = stack.back();
+		Value &b = *(stack.end() - 2);
+		TestUnits(a, b, instructions[instructionpointer]);
+		b() += a();
 		stack.pop_back();
-		TestUnits(a, stack.back(), instructions[instructionpointer]);
-		stack.back()() += a();
 		break;
 	}
 
 	case OpCode::SUB: {
-		const Value a = stack.back();
+		const Value &a = stack.back();
+		Value &b = *(stack.end() - 2);
+		TestUnits(a, b, instructions[instructionpointer]);
+		b() -= a();
 		stack.pop_back();
-		TestUnits(a, stack.back(), instructions[instructionpointer]);
-		stack.back()() -= a();
 		break;
 	}
 
 	case OpCode::MULT: {
-		const Value a = stack.back();
+		const Value &a = stack.back();
+		Value &b = *(stack.end() - 2);
+		b.MultiplyUnit(a);
+		b() *= a();
 		stack.pop_back();
-		stack.back().MultiplyUnit(a);
-		stack.back()() *= a();
 		break;
 	}
 
 	case OpCode::DIV: {
-		const Value a = stack.back();
+		const Value &a = stack.back();
+		Value &b = *(stack.end() - 2);
+		b.DivideUnit(a);
+		b() /= a();
 		stack.pop_back();
+		break;
+	}
+
+	case OpCode::ADD_C: {
+		const Instruction &instr = instructions[instructionpointer];
+		TestUnits(instr.value, stack.back(), instr);
+		stack.back()() += instr.value();
+		break;
+	}
+
+	case OpCode::SUB_C: {
+		const Instruction &instr = instructions[instructionpointer];
+		TestUnits(instr.value, stack.back(), instr);
+		stack.back()() -= instr.value();
+		break;
+	}
+
+	case OpCode::MULT_C: {
+		const Value &a = instructions[instructionpointer].value;
+		stack.back().MultiplyUnit(a);
+		stack.back()() *= a();
+		break;
+	}
+
+	case OpCode::DIV_C: {
+		const Value &a = instructions[instructionpointer].value;
 		stack.back().DivideUnit(a);
 		stack.back()() /= a();
 		break;
@@ -832,6 +884,161 @@ bool MathParser::VM::ConvertToExternal(size_t idxInternal, size_t idxExternal) {
 	return ret;
 }
 
+/**\brief Number of stack values used by an operation, that can be calculated
+ * in advance
+ *
+ * \return 0, if the operation cannot be calculated in advance.
+ */
+static size_t ConstantOperands(MathParser::VM::OpCode opcode) {
+	using OpCode = MathParser::VM::OpCode;
+	switch (opcode) {
+	case OpCode::NEG:
+	case OpCode::F_ABS:
+	case OpCode::F_EXP:
+	case OpCode::F_EXP2:
+	case OpCode::F_LOG:
+	case OpCode::F_LOG2:
+	case OpCode::F_LOG10:
+	case OpCode::F_SIN:
+	case OpCode::F_COS:
+	case OpCode::F_TAN:
+	case OpCode::F_ASIN:
+	case OpCode::F_ACOS:
+	case OpCode::F_ATAN:
+	case OpCode::F_CBRT:
+	case OpCode::F_SQRT:
+	case OpCode::F_CEIL:
+	case OpCode::F_FLOOR:
+	case OpCode::F_ROUND:
+		return 1;
+	case OpCode::ADD:
+	case OpCode::SUB:
+	case OpCode::MULT:
+	case OpCode::DIV:
+	case OpCode::MOD:
+	case OpCode::POW:
+	case OpCode::AND:
+	case OpCode::OR:
+	case OpCode::F_MAX:
+	case OpCode::F_MIN:
+	case OpCode::F_ATAN2:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+static bool IsForwardJump(MathParser::VM::OpCode opcode) {
+	using OpCode = MathParser::VM::OpCode;
+	return opcode == OpCode::JMP || opcode == OpCode::JMP_Z
+			|| opcode == OpCode::JMP_NZ;
+}
+
+static bool IsBackwardJump(MathParser::VM::OpCode opcode) {
+	using OpCode = MathParser::VM::OpCode;
+	return opcode == OpCode::JMPR || opcode == OpCode::JMPR_Z
+			|| opcode == OpCode::JMPR_NZ;
+}
+
+void MathParser::VM::Optimize() {
+	// The instruction pointer is incremented after a jump, so the target of
+	// a jump at n is n + idx + 1 or n - idx + 1.
+	const size_t N = instructions.size();
+	std::vector<bool> target(N + 1, false);
+	for (size_t n = 0; n < N; n++) {
+		const Instruction &instr = instructions[n];
+		if (IsForwardJump(instr.opcode) && n + instr.idx + 1 <= N)
+			target[n + instr.idx + 1] = true;
+		if (IsBackwardJump(instr.opcode) && instr.idx <= n + 1)
+			target[n + 1 - instr.idx] = true;
+	}
+
+	std::vector<Instruction> code;
+	std::vector<size_t> origin; // Index in instructions of each instruction in code
+	code.reserve(N);
+	origin.reserve(N);
+
+	// Only the first instruction of a merged sequence may be jumped to. The
+	// expression flags are needed by StepExpression().
+	auto IsMergeable = [&](size_t k, bool first) {
+		return !code[k].expression && (first || !target[origin[k]]);
+	};
+
+	for (size_t n = 0; n < N; n++) {
+		code.push_back(instructions[n]);
+		origin.push_back(n);
+
+		bool merged = true;
+		while (merged) {
+			merged = false;
+			const size_t K = code.size();
+			const size_t operands = ConstantOperands(code.back().opcode);
+			if (operands == 0 || K < 2 || !IsMergeable(K - 1, false))
+				break;
+
+			// Calculate constant subexpressions
+			bool constant = (K > operands);
+			for (size_t k = K - 1 - operands; constant && k < K - 1; k++)
+				constant = (code[k].opcode == OpCode::PUSH)
+						&& IsMergeable(k, k == K - 1 - operands);
+			if (constant) {
+				VM temp;
+				temp.epsilon = epsilon;
+				temp.instructions.assign(code.end() - operands - 1,
+						code.end());
+				try {
+					temp.Run();
+				} catch (const std::exception&) {
+					// Keep the instructions to report the error at runtime.
+					constant = false;
+				}
+				if (constant && temp.stack.size() == 1) {
+					code[K - 1 - operands].value = temp.stack.back();
+					code.resize(K - operands);
+					origin.resize(K - operands);
+					merged = true;
+					continue;
+				}
+			}
+
+			// Merge a constant second operand into the operation
+			const Instruction &push = code[K - 2];
+			if (operands != 2 || push.opcode != OpCode::PUSH
+					|| !IsMergeable(K - 2, true))
+				break;
+			Instruction instr = code.back();
+			if (instr.opcode == OpCode::ADD)
+				instr.opcode = OpCode::ADD_C;
+			else if (instr.opcode == OpCode::SUB)
+				instr.opcode = OpCode::SUB_C;
+			else if (instr.opcode == OpCode::MULT)
+				instr.opcode = OpCode::MULT_C;
+			else if (instr.opcode == OpCode::DIV)
+				instr.opcode = OpCode::DIV_C;
+			else
+				break;
+			instr.value = push.value;
+			code.pop_back();
+			origin.pop_back();
+			code.back() = instr;
+		}
+	}
+
+	std::vector<size_t> position(N + 1, 0);
+	for (size_t k = 0; k < code.size(); k++)
+		position[origin[k]] = k;
+	position[N] = code.size();
+	for (size_t k = 0; k < code.size(); k++) {
+		Instruction &instr = code[k];
+		const size_t n = origin[k];
+		if (IsForwardJump(instr.opcode) && n + instr.idx + 1 <= N)
+			instr.idx = position[n + instr.idx + 1] - k - 1;
+		if (IsBackwardJump(instr.opcode) && instr.idx <= n + 1)
+			instr.idx = k + 1 - position[n + 1 - instr.idx];
+	}
+	instructions.swap(code);
+}
+
 void MathParser::VM::TestUnits(const Value &lval, const Value &rval,
 		const Instruction &instr) {
 // If the units are compatible everything is ok.
@@ -882,6 +1089,8 @@ void MathParser::ParseCode(const std::string &code) {
 	lexer.NextToken();
 	while (lexer.token != Lexer::TokenType::EndOfInput)
 		ParseStatement();
+	if (optimize)
+		vm.Optimize();
 }
 
 void MathParser::ParseExpression(const std::string &expression) {
@@ -895,6 +1104,8 @@ void MathParser::ParseExpression(const std::string &expression) {
 	if (lexer.token != Lexer::TokenType::EndOfInput)
 		ErrorBefore("Expression",
 				"The simple expression does not evaluate completely.");
+	if (optimize)
+		vm.Optimize();
 }
 
 void MathParser::ParseStatement() {
@@ -1936,8 +2147,6 @@ void MathParser::AddInstruction(VM::OpCode opcode, const Value &value,
 	instr.row = lexer.row;
 	instr.col = lexer.col;
 	vm.instructions.push_back(instr);
-
-//TODO Add Expression optimizer here.
 }
 
 bool MathParser::IdentifierExists(const std::string &name) const {
@@ -161,6 +161,12 @@ public:
 	 */
 	bool implicitAddition = false;
 
+	/** \brief Flag: Optimize the instructions after parsing.
+	 *
+	 * See VM::Optimize().
+	 */
+	bool optimize = true;
+
 	class Value {
 	public:
 		Value() = default;
@@ -237,6 +243,9 @@ public:
 		 * The results are stored as 0 and 1. And thus can be used with the
 		 * conditional jumps.
 		 *
+		 * The operations ADD_C, SUB_C, MULT_C and DIV_C are generated by
+		 * Optimize(). They take the second operand from the value of the
+		 * instruction instead of the stack.
 		 */
 		enum class OpCode {
 			NOP, ///< No operation, do nothing for one cycle.
@@ -259,6 +268,10 @@ public:
 			SUB, ///< Subtract the top two values. The units of the values have to be of the same type (for example meter 'm' and inch 'in').
 			MULT, ///< Multiply the top two values. The units of the values do not have to be of the same type (e.g. 5V * 3A = 15W).
 			DIV, ///< Divide the two to values. The units of the values do not have to be of the same type (e.g. 60V / 3A = 2Ohm).
+			ADD_C, ///< Add the value of the instruction to the top value. The units of the values have to be of the same type.
+			SUB_C, ///< Subtract the value of the instruction from the top value. The units of the values have to be of the same type.
+			MULT_C, ///< Multiply the top value by the value of the instruction.
+			DIV_C, ///< Divide the top value by the value of the instruction.
 			MOD, ///< Calculate the modulo of the first top value with the second. The units of the values have to be of the same type.
 			POW, ///< Take the power of the first top value by the second. The second values has to be unitless.
 			AND, ///< AND operation on the top two values. Both values have to be unitless.
@@ -403,6 +416,29 @@ public:
 		 */
 		bool ConvertToExternal(size_t idxInternal, size_t idxExternal);
 
+		/**\brief Optimize the instructions
+		 *
+		 * Called after parsing, if MathParser::optimize is set.
+		 *
+		 * Constant subexpressions are calculated once, e.g.
+		 * "(39/3*2-1.5) cm" becomes a single PUSH. The units of these
+		 * subexpressions are checked here. If the calculation fails, the
+		 * instructions are kept, so that the error is reported when running
+		 * the code.
+		 *
+		 * A PUSH followed by an ADD, SUB, MULT or DIV is merged into an
+		 * ADD_C, SUB_C, MULT_C or DIV_C, e.g. "footLength*2.1" becomes
+		 * FETCH, MULT_C(2.1).
+		 *
+		 * The units of variables are only known, when the code runs. They
+		 * can change without the code being parsed again. Therefore all
+		 * operations on variables check their units at runtime.
+		 *
+		 * Comparisons are not calculated, because they depend on epsilon.
+		 * The jumps are corrected for the removed instructions.
+		 */
+		void Optimize();
+
 	private:
 		void TestUnits(const Value &lval, const Value &rval,
 				const Instruction &instr);
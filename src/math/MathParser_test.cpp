@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : MathParser_test.cpp
+// Purpose            : Optimizer of the MathParser
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "MathParser.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+class MathParserTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( MathParserTest );
+	CPPUNIT_TEST(testConstantFolding);
+	CPPUNIT_TEST(testConstantOperand);
+	CPPUNIT_TEST(testExternal);
+	CPPUNIT_TEST(testUnitError);
+	CPPUNIT_TEST(testJumps);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	double Evaluate(MathParser &parser) {
+		parser.vm.Reset();
+		parser.vm.Run();
+		CPPUNIT_ASSERT(parser.vm.stack.size() == 1);
+		return parser.vm.stack.front().ToDouble();
+	}
+
+	void testConstantFolding() {
+		MathParser parser;
+		parser.ParseExpression("(39/3*2-1.5) cm");
+		CPPUNIT_ASSERT(parser.vm.instructions.size() == 1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.245, Evaluate(parser), 1e-12);
+		CPPUNIT_ASSERT(parser.vm.stack.front().GetUnit() == Unit("m"));
+
+		// Comparisons depend on the epsilon of the VM.
+		parser.ParseExpression("3 cm < 2 cm");
+		CPPUNIT_ASSERT(parser.vm.instructions.size() == 3);
+	}
+
+	void testConstantOperand() {
+		MathParser parser;
+		parser.vm.heap.Set("x", MathParser::Value(0.2, Unit("m")));
+		parser.ParseExpression("x*3/4 - 1 cm");
+		CPPUNIT_ASSERT(parser.vm.instructions.size() == 4);
+		CPPUNIT_ASSERT(
+				parser.vm.instructions[1].opcode
+						== MathParser::VM::OpCode::MULT_C);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.14, Evaluate(parser), 1e-12);
+
+		MathParser plain;
+		plain.optimize = false;
+		plain.vm.heap.Set("x", MathParser::Value(0.2, Unit("m")));
+		plain.ParseExpression("x*3/4 - 1 cm");
+		CPPUNIT_ASSERT(plain.vm.instructions.size() == 7);
+		CPPUNIT_ASSERT(Evaluate(plain) == Evaluate(parser));
+	}
+
+	void testExternal() {
+		MathParser parser;
+		parser.ParseExpression("x*2 + x");
+		const size_t idx = parser.vm.heap.GetIndex("x");
+		CPPUNIT_ASSERT(parser.vm.heap[idx].isinput);
+		auto x = std::make_shared<MathParser::VM::Variable>("x");
+		(*x)() = 0.5;
+		x->GetUnit() = Unit("m");
+		parser.vm.externalvariables.resize(parser.vm.heap.size());
+		parser.vm.externalvariables[idx] = x;
+		CPPUNIT_ASSERT(parser.vm.ConvertToExternal(idx, idx));
+		CPPUNIT_ASSERT(
+				parser.vm.instructions[0].opcode
+						== MathParser::VM::OpCode::FETCH_EXT);
+		CPPUNIT_ASSERT(
+				parser.vm.instructions[1].opcode
+						== MathParser::VM::OpCode::MULT_C);
+		CPPUNIT_ASSERT(
+				parser.vm.instructions[2].opcode
+						== MathParser::VM::OpCode::FETCH_EXT);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, Evaluate(parser), 1e-12);
+		CPPUNIT_ASSERT(parser.vm.stack.front().GetUnit() == Unit("m"));
+
+		// The unit of an external variable is checked when running.
+		x->GetUnit() = Unit("s");
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, Evaluate(parser), 1e-12);
+		CPPUNIT_ASSERT(parser.vm.stack.front().GetUnit() == Unit("s"));
+		parser.ParseExpression("x*2 + 1 m");
+		parser.vm.externalvariables.resize(parser.vm.heap.size());
+		parser.vm.externalvariables[idx] = x;
+		parser.vm.ConvertToExternal(idx, idx);
+		parser.vm.Reset();
+		CPPUNIT_ASSERT_THROW(parser.vm.Run(), std::runtime_error);
+	}
+
+	void testUnitError() {
+		// The error is reported when running, not while optimizing.
+		MathParser parser;
+		parser.ParseExpression("1 m + 2 s");
+		parser.vm.Reset();
+		CPPUNIT_ASSERT_THROW(parser.vm.Run(), std::runtime_error);
+	}
+
+	void testJumps() {
+		const std::string code =
+				"s = 0; for (i = 0; i < 3 + 1; i++) { if (i == 2 * 1) continue;"
+						" s = s + i * (2 + 1); } s;";
+		MathParser parser;
+		parser.ParseCode(code);
+		MathParser plain;
+		plain.optimize = false;
+		plain.ParseCode(code);
+		CPPUNIT_ASSERT(
+				parser.vm.instructions.size() < plain.vm.instructions.size());
+		parser.vm.Run();
+		plain.vm.Run();
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0,
+				parser.vm.heap.Get("s").ToDouble(), 1e-12);
+		CPPUNIT_ASSERT(
+				parser.vm.heap.Get("s").ToDouble()
+						== plain.vm.heap.Get("s").ToDouble());
+	}
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MathParserTest);
+#endif
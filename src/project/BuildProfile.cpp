@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : BuildProfile.cpp
+// Purpose            : Timing and memory statistics of the operations
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "BuildProfile.h"
+
+#include "../system/JSON.h"
+
+#include <ctime>
+
+void BuildProfile::SetHistory(size_t count) {
+	std::lock_guard<std::mutex> lock(mtx);
+	history = count;
+	while (builds.size() > history)
+		builds.pop_front();
+}
+
+size_t BuildProfile::GetHistory() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return history;
+}
+
+void BuildProfile::Clear() {
+	std::lock_guard<std::mutex> lock(mtx);
+	builds.clear();
+	current = Build();
+}
+
+void BuildProfile::Discard() {
+	std::lock_guard<std::mutex> lock(mtx);
+	current = Build();
+}
+
+void BuildProfile::BeginBuild(size_t threads) {
+	std::lock_guard<std::mutex> lock(mtx);
+	current.threads = threads;
+}
+
+void BuildProfile::Record(const std::string &name, double secondsWall,
+		double secondsCPU, size_t outputBytes, bool cached) {
+	std::lock_guard<std::mutex> lock(mtx);
+	Entry *entry = nullptr;
+	for (auto &e : current.operations)
+		if (e.name == name) {
+			entry = &e;
+			break;
+		}
+	if (entry == nullptr) {
+		current.operations.emplace_back();
+		entry = &(current.operations.back());
+		entry->name = name;
+	}
+	entry->calls++;
+	if (cached)
+		entry->cacheHits++;
+	entry->secondsWall += secondsWall;
+	entry->secondsCPU += secondsCPU;
+	entry->outputBytes = outputBytes;
+}
+
+void BuildProfile::EndBuild(double secondsWall, double secondsCPU) {
+	std::lock_guard<std::mutex> lock(mtx);
+	if (current.operations.empty() || history == 0) {
+		current = Build();
+		return;
+	}
+	current.id = nextId++;
+	current.secondsWall = secondsWall;
+	current.secondsCPU = secondsCPU;
+	builds.push_back(current);
+	while (builds.size() > history)
+		builds.pop_front();
+	current = Build();
+}
+
+std::deque<BuildProfile::Build> BuildProfile::GetBuilds() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return builds;
+}
+
+BuildProfile::Build BuildProfile::GetLastBuild() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	if (builds.empty())
+		return Build();
+	return builds.back();
+}
+
+void BuildProfile::ToCSV(std::ostream &out) const {
+	const auto temp = GetBuilds();
+	out
+			<< "build;threads;operation;calls;cache_hits;seconds_wall;seconds_cpu;output_bytes\n";
+	for (const Build &build : temp) {
+		for (const Entry &e : build.operations) {
+			out << build.id << ';' << build.threads << ';' << e.name << ';'
+					<< e.calls << ';' << e.cacheHits << ';' << e.secondsWall
+					<< ';' << e.secondsCPU << ';' << e.outputBytes << '\n';
+		}
+		out << build.id << ';' << build.threads << ";total;;;"
+				<< build.secondsWall << ';' << build.secondsCPU << ";\n";
+	}
+}
+
+void BuildProfile::ToJSON(std::ostream &out) const {
+	const auto temp = GetBuilds();
+	JSON js;
+	js.SetArray(temp.size());
+	for (size_t n = 0; n < temp.size(); n++) {
+		const Build &build = temp[n];
+		JSON &jsb = js[n];
+		jsb.SetObject();
+		jsb["build"].SetNumber(build.id);
+		jsb["threads"].SetNumber(build.threads);
+		jsb["seconds_wall"].SetNumber(build.secondsWall);
+		jsb["seconds_cpu"].SetNumber(build.secondsCPU);
+		JSON &jso = jsb["operations"];
+		jso.SetArray(build.operations.size());
+		for (size_t m = 0; m < build.operations.size(); m++) {
+			const Entry &e = build.operations[m];
+			JSON &jse = jso[m];
+			jse.SetObject();
+			jse["name"].SetString(e.name);
+			jse["calls"].SetNumber(e.calls);
+			jse["cache_hits"].SetNumber(e.cacheHits);
+			jse["seconds_wall"].SetNumber(e.secondsWall);
+			jse["seconds_cpu"].SetNumber(e.secondsCPU);
+			jse["output_bytes"].SetNumber(e.outputBytes);
+		}
+	}
+	js.Save(out);
+}
+
+double BuildProfile::ThreadCPUSeconds() {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	struct timespec ts;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+		return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+	return (double) clock() / CLOCKS_PER_SEC;
+}
+
+double BuildProfile::ProcessCPUSeconds() {
+#ifdef CLOCK_PROCESS_CPUTIME_ID
+	struct timespec ts;
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0)
+		return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+	return (double) clock() / CLOCKS_PER_SEC;
+}
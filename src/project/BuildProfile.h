@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : BuildProfile.h
+// Purpose            : Timing and memory statistics of the operations
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef SRC_PROJECT_BUILDPROFILE_H_
+#define SRC_PROJECT_BUILDPROFILE_H_
+
+/** \class BuildProfile
+ * 	\code #include "BuildProfile.h"\endcode
+ * 	\ingroup project
+ *  \brief Profile of the last builds, broken down by Operation
+ *
+ * For every Operation run by the Scheduler the wall time, the CPU time of the
+ * running thread and the memory of the output objects (as reported by
+ * Object::GetMemoryUsage()) are recorded. Operations restored from the
+ * ResultCache are counted separately. The update of the Design in
+ * Builder::Prepare() is recorded as its own entry "Design::Update".
+ *
+ * The CPU time of an entry is measured on the thread running the operation
+ * only. Threads started by the operation itself (e.g. in Volume::Add(),
+ * Volume::CalcSurface() or Surface::Apply()) are not included. These are
+ * included in the CPU time of the whole build, which is the CPU time of the
+ * process.
+ *
+ * The last builds are kept (10 by default, see SetHistory()). Builds without
+ * any entries are not recorded.
+ *
+ * The profile is collected in release builds as well. It can be exported as
+ * CSV (one line per build and operation) or as JSON.
+ */
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class BuildProfile {
+public:
+	BuildProfile() = default;
+	virtual ~BuildProfile() = default;
+
+	struct Entry {
+		std::string name; ///< Operation::GetName()
+		size_t calls = 0; ///< Number of runs, including the cached ones
+		size_t cacheHits = 0;
+		double secondsWall = 0.0;
+		double secondsCPU = 0.0; ///< Thread running the operation only
+		size_t outputBytes = 0; ///< Memory of the outputs after the run
+	};
+	struct Build {
+		size_t id = 0; ///< Counts up with every recorded build
+		size_t threads = 1;
+		double secondsWall = 0.0;
+		double secondsCPU = 0.0; ///< CPU time of the process, including all threads
+		std::vector<Entry> operations; ///< In the order they were first run
+	};
+
+	void SetHistory(size_t count); ///< Number of builds to keep
+	size_t GetHistory() const;
+	void Clear();
+
+	/**\brief Drop the entries recorded since the last EndBuild()
+	 */
+	void Discard();
+
+	/**\brief Start running the operations of a build
+	 *
+	 * Entries recorded before (e.g. by Builder::Prepare()) are kept.
+	 */
+	void BeginBuild(size_t threads);
+	/**\brief Add the result of an operation to the current build
+	 *
+	 * Can be called from any worker thread.
+	 */
+	void Record(const std::string &name, double secondsWall, double secondsCPU,
+			size_t outputBytes, bool cached);
+	void EndBuild(double secondsWall, double secondsCPU);
+
+	std::deque<Build> GetBuilds() const; ///< Oldest first
+	Build GetLastBuild() const; ///< Empty, if nothing was recorded yet.
+
+	void ToCSV(std::ostream &out) const;
+	void ToJSON(std::ostream &out) const;
+
+	/**\brief CPU time of the calling thread
+	 *
+	 * Falls back to the CPU time of the process, if the platform has no
+	 * per-thread clock.
+	 */
+	static double ThreadCPUSeconds();
+	static double ProcessCPUSeconds(); ///< CPU time of all threads of the process
+
+private:
+	std::deque<Build> builds;
+	Build current;
+	size_t history = 10;
+	size_t nextId = 1;
+	mutable std::mutex mtx;
+};
+
+#endif /* SRC_PROJECT_BUILDPROFILE_H_ */
@@ -25,10 +25,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Builder.h"
 
-#include "Project.h"
+#include "ProjectData.h"
 #include "Configuration.h"
 
+#include "../system/Cancellation.h"
 #include "../system/StopWatch.h"
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -38,75 +40,21 @@ bool Builder::IsSetup() const {
 	return !operations.empty();
 }
 
-void Builder::Setup(Project &project) {
+void Builder::Setup(ProjectData &project) {
 	if (operations.empty()) {
 
 		auto &config = project.config;
-		auto &footL = project.footL;
-		auto &footR = project.footR;
-
-		if (!opCoordinateSystemConstruct) {
-			opCoordinateSystemConstruct = std::make_shared<
-					CoordinateSystemConstruct>();
-			opCoordinateSystemConstruct->belowCrotchGirth =
-					footL.belowCrotchGirth;
-			opCoordinateSystemConstruct->belowCrotchLevel =
-					footL.belowCrotchLevel;
-			opCoordinateSystemConstruct->middleOfThighGirth =
-					footL.middleOfThighGirth;
-			opCoordinateSystemConstruct->middleOfThighLevel =
-					footL.middleOfThighLevel;
-			opCoordinateSystemConstruct->aboveKneeGirth = footL.aboveKneeGirth;
-			opCoordinateSystemConstruct->aboveKneeLevel = footL.aboveKneeLevel;
-			opCoordinateSystemConstruct->overKneeCapGirth =
-					footL.overKneeCapGirth;
-			opCoordinateSystemConstruct->overKneeCapLevel =
-					footL.overKneeCapLevel;
-			opCoordinateSystemConstruct->belowKneeGirth = footL.belowKneeGirth;
-			opCoordinateSystemConstruct->belowKneeLevel = footL.belowKneeLevel;
-			opCoordinateSystemConstruct->middleOfShankGirth =
-					footL.middleOfShankGirth;
-			opCoordinateSystemConstruct->middleOfShankLevel =
-					footL.middleOfShankLevel;
-			opCoordinateSystemConstruct->aboveAnkleGirth =
-					footL.aboveAnkleGirth;
-			opCoordinateSystemConstruct->aboveAnkleLevel =
-					footL.aboveAnkleLevel;
-			opCoordinateSystemConstruct->overAnkleBoneGirth =
-					footL.overAnkleBoneGirth;
-			opCoordinateSystemConstruct->overAnkleBoneLevel =
-					footL.overAnkleBoneLevel;
-			operations.push_back(opCoordinateSystemConstruct);
-		}
+
 		if (!opFootModelLoad) {
 			opFootModelLoad = std::make_shared<FootModelLoad>();
 			opFootModelLoad->filename = config.filenameBoneModel;
 			operations.push_back(opFootModelLoad);
 		}
-		if (!opFootModelUpdate) {
-			opFootModelUpdate = std::make_shared<FootModelUpdate>();
-			opFootModelUpdate->heelPitch = config.heelPitch;
-			opFootModelUpdate->toeSpring = config.toeSpring;
-			opFootModelUpdate->heelHeight = config.heelHeight;
-			opFootModelUpdate->ballHeight = config.ballHeight;
-			opFootModelUpdate->legLengthDifference = footL.legLengthDifference;
-			operations.push_back(opFootModelUpdate);
-		}
 		if (!opFootScanLoad) {
 			opFootScanLoad = std::make_shared<FootScanLoad>();
 			opFootScanLoad->filename = config.filenameScan;
 			operations.push_back(opFootScanLoad);
 		}
-		if (!opHeelCenter) {
-			opHeelCenter = std::make_shared<HeelCenter>();
-			opHeelCenter->overAnkleBoneLevel = footL.overAnkleBoneLevel;
-			operations.push_back(opHeelCenter);
-		}
-		if (!opHeelConstruct) {
-			opHeelConstruct = std::make_shared<HeelConstruct>();
-			opHeelConstruct->heelCode = config.heelCode;
-			operations.push_back(opHeelConstruct);
-		}
 		if (!opHeelExtractInsole) {
 			opHeelExtractInsole = std::make_shared<HeelExtractInsole>();
 			operations.push_back(opHeelExtractInsole);
@@ -121,30 +69,6 @@ void Builder::Setup(Project &project) {
 			opHeelNormalize->heelReorient = config.heelReorient;
 			operations.push_back(opHeelNormalize);
 		}
-		if (!opInsoleAnalyze) {
-			opInsoleAnalyze = std::make_shared<InsoleAnalyze>();
-			opInsoleAnalyze->footLength = footL.footLength;
-			opInsoleAnalyze->ballMeasurementAngle = config.ballMeasurementAngle;
-			opInsoleAnalyze->heelDirectionAngle = config.heelDirectionAngle;
-			opInsoleAnalyze->littleToeAngle = config.littleToeAngle;
-			opInsoleAnalyze->bigToeAngle = config.bigToeAngle;
-			opInsoleAnalyze->extraLength = config.extraLength;
-			operations.push_back(opInsoleAnalyze);
-		}
-		if (!opInsoleConstruct) {
-			opInsoleConstruct = std::make_shared<InsoleConstruct>();
-			opInsoleConstruct->footLength = footL.footLength;
-			opInsoleConstruct->ballWidth = footL.ballWidth;
-			opInsoleConstruct->heelWidth = footL.heelWidth;
-			opInsoleConstruct->ballMeasurementAngle =
-					config.ballMeasurementAngle;
-			opInsoleConstruct->heelDirectionAngle = config.heelDirectionAngle;
-			opInsoleConstruct->littleToeAngle = config.littleToeAngle;
-			opInsoleConstruct->bigToeAngle = config.bigToeAngle;
-			opInsoleConstruct->tipSharpness = config.tipSharpness;
-			opInsoleConstruct->extraLength = config.extraLength;
-			operations.push_back(opInsoleConstruct);
-		}
 		if (!opInsoleFlatten) {
 			opInsoleFlatten = std::make_shared<InsoleFlatten>();
 			opInsoleFlatten->debugMIDI_48 = config.debugMIDI_48;
@@ -157,25 +81,6 @@ void Builder::Setup(Project &project) {
 			opInsoleFlatten->debugMIDI_55 = config.debugMIDI_55;
 			operations.push_back(opInsoleFlatten);
 		}
-		if (!opInsoleTransform) {
-			opInsoleTransform = std::make_shared<InsoleTransform>();
-			opInsoleTransform->heelPitch = config.heelPitch;
-			opInsoleTransform->toeSpring = config.toeSpring;
-			opInsoleTransform->heelHeight = config.heelHeight;
-			opInsoleTransform->ballHeight = config.ballHeight;
-			opInsoleTransform->legLengthDifference = footL.legLengthDifference;
-			operations.push_back(opInsoleTransform);
-		}
-		if (!opLastAnalyse) {
-			opLastAnalyse = std::make_shared<LastAnalyse>();
-			opLastAnalyse->lastReorient = config.lastReorient;
-			operations.push_back(opLastAnalyse);
-		}
-		if (!opLastConstruct) {
-			opLastConstruct = std::make_shared<LastConstruct>();
-			opLastConstruct->upperLevel = config.upperLevel;
-			operations.push_back(opLastConstruct);
-		}
 		if (!opLastLoad) {
 			opLastLoad = std::make_shared<ObjectLoad>();
 			opLastLoad->filename = config.filenameLast;
@@ -186,122 +91,175 @@ void Builder::Setup(Project &project) {
 			opLastNormalize->lastReorient = config.lastReorient;
 			operations.push_back(opLastNormalize);
 		}
-		if (!opLastUpdate) {
-			opLastUpdate = std::make_shared<LastUpdate>();
-			opLastUpdate->lastModify = config.lastModify;
-			opLastUpdate->heelPitch = config.heelPitch;
-			opLastUpdate->toeSpring = config.toeSpring;
-			opLastUpdate->heelHeight = config.heelHeight;
-			opLastUpdate->ballHeight = config.ballHeight;
-			opLastUpdate->legLengthDifference = footL.legLengthDifference;
-			operations.push_back(opLastUpdate);
-		}
-		if (!opUpperConstruct) {
-			opUpperConstruct = std::make_shared<UpperConstruct>();
-			operations.push_back(opUpperConstruct);
-		}
-		if (!opUpperFlatten) {
-			opUpperFlatten = std::make_shared<UpperFlatten>();
-			operations.push_back(opUpperFlatten);
-		}
+
+		SetupChain(chainL, config, project.footL);
+		SetupChain(chainR, config, project.footR);
 	}
 	Connect(project);
+	scheduler.Setup(operations);
+}
+
+void Builder::SetupChain(Chain &chain, const Configuration &config,
+		const FootMeasurements &foot) {
+	if (!chain.opCoordinateSystemConstruct) {
+		chain.opCoordinateSystemConstruct = std::make_shared<
+				CoordinateSystemConstruct>();
+		chain.opCoordinateSystemConstruct->belowCrotchGirth =
+				foot.belowCrotchGirth;
+		chain.opCoordinateSystemConstruct->belowCrotchLevel =
+				foot.belowCrotchLevel;
+		chain.opCoordinateSystemConstruct->middleOfThighGirth =
+				foot.middleOfThighGirth;
+		chain.opCoordinateSystemConstruct->middleOfThighLevel =
+				foot.middleOfThighLevel;
+		chain.opCoordinateSystemConstruct->aboveKneeGirth = foot.aboveKneeGirth;
+		chain.opCoordinateSystemConstruct->aboveKneeLevel = foot.aboveKneeLevel;
+		chain.opCoordinateSystemConstruct->overKneeCapGirth =
+				foot.overKneeCapGirth;
+		chain.opCoordinateSystemConstruct->overKneeCapLevel =
+				foot.overKneeCapLevel;
+		chain.opCoordinateSystemConstruct->belowKneeGirth = foot.belowKneeGirth;
+		chain.opCoordinateSystemConstruct->belowKneeLevel = foot.belowKneeLevel;
+		chain.opCoordinateSystemConstruct->middleOfShankGirth =
+				foot.middleOfShankGirth;
+		chain.opCoordinateSystemConstruct->middleOfShankLevel =
+				foot.middleOfShankLevel;
+		chain.opCoordinateSystemConstruct->aboveAnkleGirth =
+				foot.aboveAnkleGirth;
+		chain.opCoordinateSystemConstruct->aboveAnkleLevel =
+				foot.aboveAnkleLevel;
+		chain.opCoordinateSystemConstruct->overAnkleBoneGirth =
+				foot.overAnkleBoneGirth;
+		chain.opCoordinateSystemConstruct->overAnkleBoneLevel =
+				foot.overAnkleBoneLevel;
+		operations.push_back(chain.opCoordinateSystemConstruct);
+	}
+	if (!chain.opFootModelUpdate) {
+		chain.opFootModelUpdate = std::make_shared<FootModelUpdate>();
+		chain.opFootModelUpdate->heelPitch = config.heelPitch;
+		chain.opFootModelUpdate->toeSpring = config.toeSpring;
+		chain.opFootModelUpdate->heelHeight = config.heelHeight;
+		chain.opFootModelUpdate->ballHeight = config.ballHeight;
+		chain.opFootModelUpdate->legLengthDifference = foot.legLengthDifference;
+		operations.push_back(chain.opFootModelUpdate);
+	}
+	if (!chain.opHeelCenter) {
+		chain.opHeelCenter = std::make_shared<HeelCenter>();
+		chain.opHeelCenter->overAnkleBoneLevel = foot.overAnkleBoneLevel;
+		operations.push_back(chain.opHeelCenter);
+	}
+	if (!chain.opHeelConstruct) {
+		chain.opHeelConstruct = std::make_shared<HeelConstruct>();
+		chain.opHeelConstruct->heelCode = config.heelCode;
+		operations.push_back(chain.opHeelConstruct);
+	}
+	if (!chain.opInsoleAnalyze) {
+		chain.opInsoleAnalyze = std::make_shared<InsoleAnalyze>();
+		chain.opInsoleAnalyze->footLength = foot.footLength;
+		chain.opInsoleAnalyze->ballMeasurementAngle =
+				config.ballMeasurementAngle;
+		chain.opInsoleAnalyze->heelDirectionAngle = config.heelDirectionAngle;
+		chain.opInsoleAnalyze->littleToeAngle = config.littleToeAngle;
+		chain.opInsoleAnalyze->bigToeAngle = config.bigToeAngle;
+		chain.opInsoleAnalyze->extraLength = config.extraLength;
+		operations.push_back(chain.opInsoleAnalyze);
+	}
+	if (!chain.opInsoleConstruct) {
+		chain.opInsoleConstruct = std::make_shared<InsoleConstruct>();
+		chain.opInsoleConstruct->footLength = foot.footLength;
+		chain.opInsoleConstruct->ballWidth = foot.ballWidth;
+		chain.opInsoleConstruct->heelWidth = foot.heelWidth;
+		chain.opInsoleConstruct->ballMeasurementAngle =
+				config.ballMeasurementAngle;
+		chain.opInsoleConstruct->heelDirectionAngle = config.heelDirectionAngle;
+		chain.opInsoleConstruct->littleToeAngle = config.littleToeAngle;
+		chain.opInsoleConstruct->bigToeAngle = config.bigToeAngle;
+		chain.opInsoleConstruct->tipSharpness = config.tipSharpness;
+		chain.opInsoleConstruct->extraLength = config.extraLength;
+		operations.push_back(chain.opInsoleConstruct);
+	}
+	if (!chain.opInsoleTransform) {
+		chain.opInsoleTransform = std::make_shared<InsoleTransform>();
+		chain.opInsoleTransform->heelPitch = config.heelPitch;
+		chain.opInsoleTransform->toeSpring = config.toeSpring;
+		chain.opInsoleTransform->heelHeight = config.heelHeight;
+		chain.opInsoleTransform->ballHeight = config.ballHeight;
+		chain.opInsoleTransform->legLengthDifference = foot.legLengthDifference;
+		operations.push_back(chain.opInsoleTransform);
+	}
+	if (!chain.opLastAnalyse) {
+		chain.opLastAnalyse = std::make_shared<LastAnalyse>();
+		chain.opLastAnalyse->lastReorient = config.lastReorient;
+		operations.push_back(chain.opLastAnalyse);
+	}
+	if (!chain.opLastConstruct) {
+		chain.opLastConstruct = std::make_shared<LastConstruct>();
+		chain.opLastConstruct->upperLevel = config.upperLevel;
+		operations.push_back(chain.opLastConstruct);
+	}
+	if (!chain.opLastUpdate) {
+		chain.opLastUpdate = std::make_shared<LastUpdate>();
+		chain.opLastUpdate->lastModify = config.lastModify;
+		chain.opLastUpdate->heelPitch = config.heelPitch;
+		chain.opLastUpdate->toeSpring = config.toeSpring;
+		chain.opLastUpdate->heelHeight = config.heelHeight;
+		chain.opLastUpdate->ballHeight = config.ballHeight;
+		chain.opLastUpdate->legLengthDifference = foot.legLengthDifference;
+		operations.push_back(chain.opLastUpdate);
+	}
+	if (!chain.opUpperConstruct) {
+		chain.opUpperConstruct = std::make_shared<UpperConstruct>();
+		operations.push_back(chain.opUpperConstruct);
+	}
+	if (!chain.opUpperFlatten) {
+		chain.opUpperFlatten = std::make_shared<UpperFlatten>();
+		operations.push_back(chain.opUpperFlatten);
+	}
+}
+
+void Builder::SetThreads(size_t threads) {
+	scheduler.SetThreads(threads);
+}
+
+size_t Builder::GetThreads() const {
+	return scheduler.GetThreads();
+}
+
+const Scheduler::Statistics& Builder::GetStatistics() const {
+	return scheduler.GetStatistics();
+}
+
+ResultCache& Builder::GetCache() {
+	return scheduler.GetCache();
+}
+
+BuildProfile& Builder::GetProfile() {
+	return scheduler.GetProfile();
 }
 
 #ifdef DEBUG
 
-void Builder::ToDot(std::ostream &out, const Project &project) const {
+void Builder::ToDot(std::ostream &out, const ProjectData &project) const {
 	out << "digraph{\n";
 	out << "rankdir=TB;\n";
+	for (size_t n = 0; n < operations.size(); n++) {
+		const auto &op = operations[n];
+		const auto inputs = op->GetInputs();
+		const auto outputs = op->GetOutputs();
+		out << "op" << n << " [shape=record,label=\"{ ";
+		for (size_t m = 0; m < inputs.size(); m++)
+			out << (m ? " | " : "") << "<i" << m << "> in" << m;
+		out << " } | " << op->GetName() << " | { ";
+		for (size_t m = 0; m < outputs.size(); m++)
+			out << (m ? " | " : "") << "<o" << m << "> out" << m;
+		out << " }\"];\n";
+		for (size_t m = 0; m < inputs.size(); m++)
+			out << "\"" << inputs[m] << "\" -> op" << n << ":i" << m << ";\n";
+		for (size_t m = 0; m < outputs.size(); m++)
+			out << "op" << n << ":o" << m << " -> \"" << outputs[m] << "\";\n";
+	}
 	out
-			<< "opCoordinateSystemConstruct [shape=record,label=\"{ <i1> in } | opCoordinateSystemConstruct | { <o1> out }\"];\n";
-	out << "\"" << opCoordinateSystemConstruct->in
-			<< "\" -> opCoordinateSystemConstruct:i1;\n";
-	out << "opCoordinateSystemConstruct:o1 -> \""
-			<< opCoordinateSystemConstruct->out << "\";\n";
-	out
-			<< "opFootModelLoad [shape=record,label=\"{  } | opFootModelLoad | { <o1> out }\"];\n";
-	out << "opFootModelLoad:o1 -> \"" << opFootModelLoad->out << "\";\n";
-	out
-			<< "opFootModelUpdate [shape=record,label=\"{ <i1> in } | opFootModelUpdate | { <o1> out }\"];\n";
-	out << "\"" << opFootModelUpdate->in << "\" -> opFootModelUpdate:i1;\n";
-	out << "opFootModelUpdate:o1 -> \"" << opFootModelUpdate->out << "\";\n";
-	out
-			<< "opFootScanLoad [shape=record,label=\"{  } | opFootScanLoad | { <o1> out }\"];\n";
-	out << "opFootScanLoad:o1 -> \"" << opFootScanLoad->out << "\";\n";
-	out
-			<< "opHeelCenter [shape=record,label=\"{ <i1> heel_in | <i2> insole_in } | opHeelCenter | { <o1> heel_out | <o2> insole_out }\"];\n";
-	out << "\"" << opHeelCenter->heel_in << "\" -> opHeelCenter:i1;\n";
-	out << "\"" << opHeelCenter->insole_in << "\" -> opHeelCenter:i2;\n";
-	out << "opHeelCenter:o1 -> \"" << opHeelCenter->heel_out << "\";\n";
-	out << "opHeelCenter:o2 -> \"" << opHeelCenter->insole_out << "\";\n";
-	out
-			<< "opHeelConstruct [shape=record,label=\"{ <i1> in } | opHeelConstruct | { <o1> out }\"];\n";
-	out << "\"" << opHeelConstruct->in << "\" -> opHeelConstruct:i1;\n";
-	out << "opHeelConstruct:o1 -> \"" << opHeelConstruct->out << "\";\n";
-	out
-			<< "opHeelExtractInsole [shape=record,label=\"{ <i1> in } | opHeelExtractInsole | { <o1> out }\"];\n";
-	out << "\"" << opHeelExtractInsole->in << "\" -> opHeelExtractInsole:i1;\n";
-	out << "opHeelExtractInsole:o1 -> \"" << opHeelExtractInsole->out
-			<< "\";\n";
-	out
-			<< "opHeelLoad [shape=record,label=\"{  } | opHeelLoad | { <o1> out }\"];\n";
-	out << "opHeelLoad:o1 -> \"" << opHeelLoad->out << "\";\n";
-	out
-			<< "opHeelNormalize [shape=record,label=\"{ <i1> in } | opHeelNormalize | { <o1> out }\"];\n";
-	out << "\"" << opHeelNormalize->in << "\" -> opHeelNormalize:i1;\n";
-	out << "opHeelNormalize:o1 -> \"" << opHeelNormalize->out << "\";\n";
-	out
-			<< "opInsoleAnalyze [shape=record,label=\"{ <i1> insole_in | <i2> insoleFlat_in } | opInsoleAnalyze | { <o1> insole_out | <o2> insoleFlat_out }\"];\n";
-	out << "\"" << opInsoleAnalyze->insole_in << "\" -> opInsoleAnalyze:i1;\n";
-	out << "\"" << opInsoleAnalyze->insoleFlat_in
-			<< "\" -> opInsoleAnalyze:i2;\n";
-	out << "opInsoleAnalyze:o1 -> \"" << opInsoleAnalyze->insole_out << "\";\n";
-	out << "opInsoleAnalyze:o2 -> \"" << opInsoleAnalyze->insoleFlat_out
-			<< "\";\n";
-	out
-			<< "opInsoleConstruct [shape=record,label=\"{  } | opInsoleConstruct | { <o1> out }\"];\n";
-	out << "opInsoleConstruct:o1 -> \"" << opInsoleConstruct->out << "\";\n";
-	out
-			<< "opInsoleFlatten [shape=record,label=\"{ <i1> in } | opInsoleFlatten | { <o1> out }\"];\n";
-	out << "\"" << opInsoleFlatten->in << "\" -> opInsoleFlatten:i1;\n";
-	out << "opInsoleFlatten:o1 -> \"" << opInsoleFlatten->out << "\";\n";
-	out
-			<< "opInsoleTransform [shape=record,label=\"{ <i1> in } | opInsoleTransform | { <o1> out }\"];\n";
-	out << "\"" << opInsoleTransform->in << "\" -> opInsoleTransform:i1;\n";
-	out << "opInsoleTransform:o1 -> \"" << opInsoleTransform->out << "\";\n";
-	out
-			<< "opLastAnalyse [shape=record,label=\"{ <i1> in } | opLastAnalyse | { <o1> out }\"];\n";
-	out << "\"" << opLastAnalyse->in << "\" -> opLastAnalyse:i1;\n";
-	out << "opLastAnalyse:o1 -> \"" << opLastAnalyse->out << "\";\n";
-	out
-			<< "opLastConstruct [shape=record,label=\"{ <i1> insole | <i2> cs } | opLastConstruct | { <o1> out }\"];\n";
-	out << "\"" << opLastConstruct->insole << "\" -> opLastConstruct:i1;\n";
-	out << "\"" << opLastConstruct->cs << "\" -> opLastConstruct:i2;\n";
-	out << "opLastConstruct:o1 -> \"" << opLastConstruct->out << "\";\n";
-	out
-			<< "opLastLoad [shape=record,label=\"{  } | opLastLoad | { <o1> out }\"];\n";
-	out << "opLastLoad:o1 -> \"" << opLastLoad->out << "\";\n";
-	out
-			<< "opLastNormalize [shape=record,label=\"{ <i1> in } | opLastNormalize | { <o1> out }\"];\n";
-	out << "\"" << opLastNormalize->in << "\" -> opLastNormalize:i1;\n";
-	out << "opLastNormalize:o1 -> \"" << opLastNormalize->out << "\";\n";
-	out
-			<< "opLastUpdate [shape=record,label=\"{ <i1> in } | opLastUpdate | { <o1> out }\"];\n";
-	out << "\"" << opLastUpdate->in << "\" -> opLastUpdate:i1;\n";
-	out << "opLastUpdate:o1 -> \"" << opLastUpdate->out << "\";\n";
-	out
-			<< "opUpperConstruct [shape=record,label=\"{ <i1> design_in | <i2> cs_in } | opUpperConstruct | { <o1> out }\"];\n";
-	out << "\"" << opUpperConstruct->design_in
-			<< "\" -> opUpperConstruct:i1;\n";
-	out << "\"" << opUpperConstruct->cs_in << "\" -> opUpperConstruct:i2;\n";
-	out << "opUpperConstruct:o1 -> \"" << opUpperConstruct->out << "\";\n";
-	out
-			<< "opUpperFlatten [shape=record,label=\"{ <i1> in } | opUpperFlatten | { <o1> out }\"];\n";
-	out << "\"" << opUpperFlatten->in << "\" -> opUpperFlatten:i1;\n";
-	out << "opUpperFlatten:o1 -> \"" << opUpperFlatten->out << "\";\n";
-	out
-			<< "project [shape=record,label=\"{ <i1> insoleFlatL | <i2> insoleL | <i3> heelL | <i4> lastL | <i5> csL | <i6> upperL | <i7> flatteningL } | project | { }\"];\n";
+			<< "project [shape=record,label=\"{ <i1> insoleFlatL | <i2> insoleL | <i3> heelL | <i4> lastL | <i5> csL | <i6> upperL | <i7> flatteningL | <i8> insoleFlatR | <i9> insoleR | <i10> heelR | <i11> lastR | <i12> csR | <i13> upperR | <i14> flatteningR } | project | { }\"];\n";
 	out << "\"" << project.insoleFlatL << "\" -> project:i1;\n";
 	out << "\"" << project.insoleL << "\" -> project:i2;\n";
 	out << "\"" << project.heelL << "\" -> project:i3;\n";
@@ -309,335 +267,77 @@ void Builder::ToDot(std::ostream &out, const Project &project) const {
 	out << "\"" << project.csL << "\" -> project:i5;\n";
 	out << "\"" << project.upperL << "\" -> project:i6;\n";
 	out << "\"" << project.flatteningL << "\" -> project:i7;\n";
+	out << "\"" << project.insoleFlatR << "\" -> project:i8;\n";
+	out << "\"" << project.insoleR << "\" -> project:i9;\n";
+	out << "\"" << project.heelR << "\" -> project:i10;\n";
+	out << "\"" << project.lastR << "\" -> project:i11;\n";
+	out << "\"" << project.csR << "\" -> project:i12;\n";
+	out << "\"" << project.upperR << "\" -> project:i13;\n";
+	out << "\"" << project.flatteningR << "\" -> project:i14;\n";
 	out << "}\n";
 }
 
 void Builder::ToCSV(std::ostream &out) const {
 	out << "----------- Input ---------------\n";
-	out << std::left << std::setw(25) << opCoordinateSystemConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : "
-			<< (opCoordinateSystemConstruct->in->IsNeeded() ?
-					"needed" : "   -  ");
-	out << " : "
-			<< (opCoordinateSystemConstruct->in->IsValid() ?
-					"   OK  " : "invalid") << "\n";
-	out << std::left << std::setw(25) << opFootModelUpdate->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opFootModelUpdate->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opFootModelUpdate->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelCenter->GetName();
-	out << std::left << " : " << std::setw(15) << "heel_in";
-	out << " : " << (opHeelCenter->heel_in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelCenter->heel_in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelCenter->GetName();
-	out << std::left << " : " << std::setw(15) << "insole_in";
-	out << " : " << (opHeelCenter->insole_in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelCenter->insole_in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opHeelConstruct->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelConstruct->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelExtractInsole->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opHeelExtractInsole->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelExtractInsole->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelNormalize->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opHeelNormalize->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelNormalize->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleAnalyze->GetName();
-	out << std::left << " : " << std::setw(15) << "insole_in";
-	out << " : "
-			<< (opInsoleAnalyze->insole_in->IsNeeded() ? "needed" : "   -  ");
-	out << " : "
-			<< (opInsoleAnalyze->insole_in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleAnalyze->GetName();
-	out << std::left << " : " << std::setw(15) << "insoleFlat_in";
-	out << " : "
-			<< (opInsoleAnalyze->insoleFlat_in->IsNeeded() ? "needed" : "   -  ");
-	out << " : "
-			<< (opInsoleAnalyze->insoleFlat_in->IsValid() ?
-					"   OK  " : "invalid") << "\n";
-	out << std::left << std::setw(25) << opInsoleFlatten->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opInsoleFlatten->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opInsoleFlatten->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleTransform->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opInsoleTransform->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opInsoleTransform->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastAnalyse->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opLastAnalyse->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastAnalyse->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "insole";
-	out << " : " << (opLastConstruct->insole->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastConstruct->insole->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "cs";
-	out << " : " << (opLastConstruct->cs->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastConstruct->cs->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastNormalize->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opLastNormalize->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastNormalize->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastUpdate->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opLastUpdate->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastUpdate->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opUpperConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "design_in";
-	out << " : "
-			<< (opUpperConstruct->design_in->IsNeeded() ? "needed" : "   -  ");
-	out << " : "
-			<< (opUpperConstruct->design_in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opUpperConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "cs_in";
-	out << " : " << (opUpperConstruct->cs_in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opUpperConstruct->cs_in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opUpperFlatten->GetName();
-	out << std::left << " : " << std::setw(15) << "in";
-	out << " : " << (opUpperFlatten->in->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opUpperFlatten->in->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
+	for (const auto &op : operations) {
+		const auto inputs = op->GetInputs();
+		for (size_t m = 0; m < inputs.size(); m++) {
+			if (!inputs[m])
+				continue;
+			out << std::left << std::setw(25) << op->GetName();
+			out << std::left << " : " << std::setw(15)
+					<< ("in" + std::to_string(m));
+			out << " : " << (inputs[m]->IsNeeded() ? "needed" : "   -  ");
+			out << " : " << (inputs[m]->IsValid() ? "   OK  " : "invalid")
+					<< "\n";
+		}
+	}
 	out << "----------- Output --------------\n";
-	out << std::left << std::setw(25) << opCoordinateSystemConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : "
-			<< (opCoordinateSystemConstruct->out->IsNeeded() ?
-					"needed" : "   -  ");
-	out << " : "
-			<< (opCoordinateSystemConstruct->out->IsValid() ?
-					"   OK  " : "invalid") << "\n";
-	out << std::left << std::setw(25) << opFootModelLoad->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opFootModelLoad->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opFootModelLoad->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opFootModelUpdate->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opFootModelUpdate->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opFootModelUpdate->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opFootScanLoad->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opFootScanLoad->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opFootScanLoad->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelCenter->GetName();
-	out << std::left << " : " << std::setw(15) << "heel_out";
-	out << " : " << (opHeelCenter->heel_out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelCenter->heel_out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelCenter->GetName();
-	out << std::left << " : " << std::setw(15) << "insole_out";
-	out << " : "
-			<< (opHeelCenter->insole_out->IsNeeded() ? "needed" : "   -  ");
-	out << " : "
-			<< (opHeelCenter->insole_out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opHeelConstruct->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelConstruct->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelExtractInsole->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : "
-			<< (opHeelExtractInsole->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : "
-			<< (opHeelExtractInsole->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelLoad->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opHeelLoad->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelLoad->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opHeelNormalize->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opHeelNormalize->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opHeelNormalize->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleAnalyze->GetName();
-	out << std::left << " : " << std::setw(15) << "insole_out";
-	out << " : "
-			<< (opInsoleAnalyze->insole_out->IsNeeded() ? "needed" : "   -  ");
-	out << " : "
-			<< (opInsoleAnalyze->insole_out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleAnalyze->GetName();
-	out << std::left << " : " << std::setw(15) << "insoleFlat_out";
-	out << " : "
-			<< (opInsoleAnalyze->insoleFlat_out->IsNeeded() ?
-					"needed" : "   -  ");
-	out << " : "
-			<< (opInsoleAnalyze->insoleFlat_out->IsValid() ?
-					"   OK  " : "invalid") << "\n";
-	out << std::left << std::setw(25) << opInsoleConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opInsoleConstruct->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opInsoleConstruct->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleFlatten->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opInsoleFlatten->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opInsoleFlatten->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opInsoleTransform->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opInsoleTransform->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opInsoleTransform->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastAnalyse->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opLastAnalyse->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastAnalyse->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opLastConstruct->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastConstruct->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastLoad->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opLastLoad->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastLoad->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastNormalize->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opLastNormalize->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastNormalize->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opLastUpdate->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opLastUpdate->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opLastUpdate->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opUpperConstruct->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opUpperConstruct->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opUpperConstruct->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
-	out << std::left << std::setw(25) << opUpperFlatten->GetName();
-	out << std::left << " : " << std::setw(15) << "out";
-	out << " : " << (opUpperFlatten->out->IsNeeded() ? "needed" : "   -  ");
-	out << " : " << (opUpperFlatten->out->IsValid() ? "   OK  " : "invalid")
-			<< "\n";
+	for (const auto &op : operations) {
+		const auto outputs = op->GetOutputs();
+		for (size_t m = 0; m < outputs.size(); m++) {
+			out << std::left << std::setw(25) << op->GetName();
+			out << std::left << " : " << std::setw(15)
+					<< ("out" + std::to_string(m));
+			out << " : " << (outputs[m]->IsNeeded() ? "needed" : "   -  ");
+			out << " : " << (outputs[m]->IsValid() ? "   OK  " : "invalid")
+					<< "\n";
+		}
+	}
 }
 
 #endif
 
 void Builder::ResetState() {
-	opCoordinateSystemConstruct->out->MarkNeeded(false);
-	opFootModelLoad->out->MarkNeeded(false);
-	opFootModelUpdate->out->MarkNeeded(false);
-	opFootScanLoad->out->MarkNeeded(false);
-	opHeelCenter->heel_out->MarkNeeded(false);
-	opHeelCenter->insole_out->MarkNeeded(false);
-	opHeelConstruct->out->MarkNeeded(false);
-	opHeelExtractInsole->out->MarkNeeded(false);
-	opHeelLoad->out->MarkNeeded(false);
-	opHeelNormalize->out->MarkNeeded(false);
-	opInsoleAnalyze->insole_out->MarkNeeded(false);
-	opInsoleAnalyze->insoleFlat_out->MarkNeeded(false);
-	opInsoleConstruct->out->MarkNeeded(false);
-	opInsoleFlatten->out->MarkNeeded(false);
-	opInsoleTransform->out->MarkNeeded(false);
-	opLastAnalyse->out->MarkNeeded(false);
-	opLastConstruct->out->MarkNeeded(false);
-	opLastLoad->out->MarkNeeded(false);
-	opLastNormalize->out->MarkNeeded(false);
-	opLastUpdate->out->MarkNeeded(false);
-	opUpperConstruct->out->MarkNeeded(false);
-	opUpperFlatten->out->MarkNeeded(false);
+	for (const auto &op : operations)
+		for (const auto &obj : op->GetOutputs())
+			obj->MarkNeeded(false);
 }
 
-void Builder::Connect(Project &project) {
+void Builder::Connect(ProjectData &project) {
 	auto &config = project.config;
 
-	const bool symmetric = (project.footL == project.footR);
-
-	opFootModelUpdate->in = opFootModelLoad->out;
-
 	opLastNormalize->in = opLastLoad->out;
-	opLastAnalyse->in = opLastNormalize->out;
-	opLastUpdate->in = opLastAnalyse->out;
 
 	opHeelNormalize->in = opHeelLoad->out;
 	opHeelExtractInsole->in = opHeelNormalize->out;
 	opInsoleFlatten->in = opHeelExtractInsole->out;
-	opInsoleAnalyze->insoleFlat_in = opInsoleFlatten->out;
-	opInsoleAnalyze->insole_in = opHeelExtractInsole->out;
-	opHeelCenter->heel_in = opHeelNormalize->out;
-	opHeelCenter->insole_in = opInsoleAnalyze->insole_out;
-	project.heelL = opHeelCenter->heel_out;
-
-	if (config.heelConstructionType->IsSelection("construct")) {
-		opInsoleTransform->in = opInsoleConstruct->out;
-		project.insoleFlatL = opInsoleConstruct->out;
-		project.insoleL = opInsoleTransform->out;
-		opHeelConstruct->in = project.insoleL;
-		project.heelL = opHeelConstruct->out;
-
-		project.insoleFlatR = project.insoleFlatL;
-		project.insoleR = project.insoleL;
-		project.heelR = project.heelL;
-	}
 
-	if (config.heelConstructionType->IsSelection("loadFromFile")) {
-		project.insoleL = opHeelCenter->insole_out;
-		project.insoleFlatL = opInsoleAnalyze->insoleFlat_out;
+	ConnectChain(chainL, project, true);
+	ConnectChain(chainR, project, false);
 
+	// Both feet share the left chain, if the measurements are the same. The
+	// right chain is kept connected, but none of its outputs is needed, so
+	// it does not run.
+	const bool symmetric = (project.footL == project.footR);
+	if (symmetric) {
 		project.insoleFlatR = project.insoleFlatL;
 		project.insoleR = project.insoleL;
 		project.heelR = project.heelL;
-	}
-
-	opCoordinateSystemConstruct->in = project.insoleL;
-	opUpperConstruct->design_in = project.design;
-	opUpperConstruct->cs_in = opCoordinateSystemConstruct->out;
-	opUpperFlatten->in = opUpperConstruct->out;
-
-	project.upperL = opUpperConstruct->out;
-	project.upperR = opUpperConstruct->out;
-	project.flatteningL = opUpperFlatten->out;
-	project.flatteningR = opUpperFlatten->out;
-	project.csL = opCoordinateSystemConstruct->out;
-	project.csR = opCoordinateSystemConstruct->out;
-
-	if (config.lastConstructionType->IsSelection("construct")) {
-		opLastConstruct->cs = project.csL;
-		opLastConstruct->insole = project.insoleL;
-		opLastAnalyse->in = opLastConstruct->out;
-		project.lastL = opLastAnalyse->out;
-	}
-
-	if (config.lastConstructionType->IsSelection("boneBased")) {
-		opFootModelUpdate->in = opFootModelLoad->out;
-
-	}
-	if (config.lastConstructionType->IsSelection("loadFromFile")) {
-
-		project.lastR = opLastUpdate->out;
-		project.lastL = opLastUpdate->out;
+		project.csR = project.csL;
+		project.upperR = project.upperL;
+		project.flatteningR = project.flatteningL;
+		project.lastR = project.lastL;
 	}
 
 	if (config.heelConstructionType->IsModified()) {
@@ -662,10 +362,78 @@ void Builder::Connect(Project &project) {
 
 }
 
-void Builder::Update(Project &project) {
+void Builder::ConnectChain(Chain &chain, ProjectData &project, bool left) {
+	auto &config = project.config;
+
+	auto &insoleFlat = left ? project.insoleFlatL : project.insoleFlatR;
+	auto &insole = left ? project.insoleL : project.insoleR;
+	auto &heel = left ? project.heelL : project.heelR;
+	auto &cs = left ? project.csL : project.csR;
+	auto &upper = left ? project.upperL : project.upperR;
+	auto &flattening = left ? project.flatteningL : project.flatteningR;
+	auto &last = left ? project.lastL : project.lastR;
+
+	chain.opFootModelUpdate->in = opFootModelLoad->out;
+
+	chain.opLastAnalyse->in = opLastNormalize->out;
+	chain.opLastUpdate->in = chain.opLastAnalyse->out;
+
+	chain.opInsoleAnalyze->insoleFlat_in = opInsoleFlatten->out;
+	chain.opInsoleAnalyze->insole_in = opHeelExtractInsole->out;
+	chain.opHeelCenter->heel_in = opHeelNormalize->out;
+	chain.opHeelCenter->insole_in = chain.opInsoleAnalyze->insole_out;
+	heel = chain.opHeelCenter->heel_out;
+
+	if (config.heelConstructionType->IsSelection("construct")) {
+		chain.opInsoleTransform->in = chain.opInsoleConstruct->out;
+		insoleFlat = chain.opInsoleConstruct->out;
+		insole = chain.opInsoleTransform->out;
+		chain.opHeelConstruct->in = insole;
+		heel = chain.opHeelConstruct->out;
+	}
+
+	if (config.heelConstructionType->IsSelection("loadFromFile")) {
+		insole = chain.opHeelCenter->insole_out;
+		insoleFlat = chain.opInsoleAnalyze->insoleFlat_out;
+	}
+
+	chain.opCoordinateSystemConstruct->in = insole;
+	chain.opUpperConstruct->design_in = project.design;
+	chain.opUpperConstruct->cs_in = chain.opCoordinateSystemConstruct->out;
+	chain.opUpperFlatten->in = chain.opUpperConstruct->out;
+
+	upper = chain.opUpperConstruct->out;
+	flattening = chain.opUpperFlatten->out;
+	cs = chain.opCoordinateSystemConstruct->out;
+
+	if (config.lastConstructionType->IsSelection("construct")) {
+		chain.opLastConstruct->cs = cs;
+		chain.opLastConstruct->insole = insole;
+		chain.opLastAnalyse->in = chain.opLastConstruct->out;
+		last = chain.opLastAnalyse->out;
+	}
+
+	if (config.lastConstructionType->IsSelection("loadFromFile"))
+		last = chain.opLastUpdate->out;
+}
+
+void Builder::Update(ProjectData &project) {
+	if (Prepare(project))
+		Execute();
+}
+
+bool Builder::Prepare(ProjectData &project) {
 	error.clear();
 
+	// The Design is updated outside of the Scheduler, so it is recorded here.
+	BuildProfile &profile = scheduler.GetProfile();
+	profile.Discard();
+	const auto t0 = std::chrono::steady_clock::now();
+	const double cpu0 = BuildProfile::ThreadCPUSeconds();
 	project.design->Update();
+	profile.Record("Design::Update",
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(),
+			BuildProfile::ThreadCPUSeconds() - cpu0, 0, false);
 
 	Setup(project);
 
@@ -680,12 +448,8 @@ void Builder::Update(Project &project) {
 //	}
 #endif
 
-	bool propagation_complete = false;
-	while (!propagation_complete) {
-		propagation_complete = true;
-		for (const auto &op : operations)
-			propagation_complete &= !op->Propagate();
-	}
+	scheduler.ResetStatistics();
+	scheduler.Propagate();
 
 	bool setup_complete = true;
 	std::ostringstream err;
@@ -700,17 +464,15 @@ void Builder::Update(Project &project) {
 		err << __FILE__ << ":Setup - Error in setup routine.";
 		error = err.str();
 		ResetState();
-		return;
+		return false;
 	}
 
-// Single threaded execution for debugging
-
 	bool hasToRun = false;
 	for (auto &op : operations)
 		hasToRun |= op->HasToRun();
 	if (!hasToRun) {
 		ResetState();
-		return;
+		return false;
 	}
 
 #ifdef DEBUG
@@ -719,21 +481,33 @@ void Builder::Update(Project &project) {
 //		ToCSV(out);
 	}
 #endif
+	return true;
+}
 
+bool Builder::Execute() {
 	DEBUGOUT << "----- Updating -----\n";
 	StopWatch sw;
-	bool operations_complete = false;
-	while (!operations_complete) {
-		operations_complete = true;
-		for (auto &op : operations)
-			if (op->HasToRun() && op->CanRun()) {
-				DEBUGOUT << "-> running: " << op->GetName() << "\n";
-				op->Run();
-				operations_complete = false;
-			}
+	try {
+		scheduler.Run();
+	} catch (const Cancellation::Exception &ex) {
+		DEBUGOUT << "----- Updating cancelled -----\n";
+		error = ex.what();
+		ResetState();
+		return false;
 	}
 	sw.Stop();
-	DEBUGOUT << "----- Updating done in " << sw.GetSecondsCPU() << "s -----\n";
+	DEBUGOUT << "----- Updating done in " << sw.GetSecondsWall() << "s on "
+			<< scheduler.GetThreads() << " thread(s) -----\n";
+	DEBUGOUT << "Propagate(): " << scheduler.GetStatistics().propagateCalls
+			<< " calls (" << scheduler.GetStatistics().propagateCallsSaved
+			<< " saved), HasToRun(): "
+			<< scheduler.GetStatistics().hasToRunCalls << " calls ("
+			<< scheduler.GetStatistics().hasToRunCallsSaved << " saved)\n";
+	DEBUGOUT << "Cache: " << scheduler.GetStatistics().cacheHits << " of "
+			<< scheduler.GetStatistics().runCalls << " operations restored ("
+			<< scheduler.GetCache().GetDiskHits() << " from disk in total), "
+			<< scheduler.GetCache().Size() << " entries, "
+			<< scheduler.GetCache().GetMemoryUsage() / 1024 << " kB\n";
 
 #ifdef DEBUG
 	{
@@ -742,6 +516,19 @@ void Builder::Update(Project &project) {
 	}
 #endif
 	ResetState();
+	return true;
+}
+
+void Builder::Cancel() {
+	scheduler.Cancel();
+}
+
+void Builder::ClearCancel() {
+	scheduler.ClearCancel();
+}
+
+bool Builder::IsCancelled() const {
+	return scheduler.IsCancelled();
 }
 
 void Builder::Paint() const {
@@ -36,6 +36,21 @@
  * The generated operations are sorted and executed in the correct sequence
  * and only if necessary (by tracking all the modified-flags).
  *
+ * The execution is done by the Scheduler. The flags are propagated along a
+ * topological order of the operations. Independent operations are run in
+ * parallel. SetThreads(1) switches to a deterministic single-threaded mode
+ * for debugging.
+ *
+ * The operations depending on the foot measurements exist twice: one chain
+ * for the left and one for the right foot. Both chains run concurrently. If
+ * both feet have the same measurements, the right foot uses the results of
+ * the left chain.
+ *
+ * Update() is split into Prepare() and Execute(). Prepare() reads the
+ * project and the modified-flags and has to be called from the thread that
+ * owns the project. Execute() does the expensive calculations and can run in
+ * a WorkerThread. A running Execute() is stopped by Cancel().
+ *
  * # Implementation needed
  *
  * ## Debugging leftovers
@@ -168,11 +183,14 @@
 #include "operation/UpperFlatten.h"
 
 #include "operation/Operation.h"
+#include "Scheduler.h"
 
 #include <memory>
 #include <vector>
 
-class Project;
+class Configuration;
+class FootMeasurements;
+class ProjectData;
 
 class Builder {
 public:
@@ -180,13 +198,55 @@ public:
 	virtual ~Builder() = default;
 
 	bool IsSetup() const;
-	void Setup(Project &project);
-	void Update(Project &project);
+	void Setup(ProjectData &project);
+	void Update(ProjectData &project); ///< Prepare() and Execute() in one go
+
+	/**\brief Setup the chain and propagate the flags
+	 *
+	 * \return true, if some operation has to run. Execute() has to be called
+	 *         next in this case.
+	 */
+	bool Prepare(ProjectData &project);
+
+	/**\brief Run all operations that have to run
+	 *
+	 * \return false, if the build was cancelled.
+	 */
+	bool Execute();
+
+	void Cancel(); ///< Can be called from any thread.
+	void ClearCancel();
+	bool IsCancelled() const;
+
+	void SetThreads(size_t threads); ///< 0: all hardware threads, 1: single-threaded
+	size_t GetThreads() const;
+
+	/**\brief Call counters of the last Update()
+	 *
+	 * Contains the number of Operation::Propagate() and Operation::HasToRun()
+	 * calls and how many calls were saved compared to fixed-point loops.
+	 */
+	const Scheduler::Statistics& GetStatistics() const;
+
+	/**\brief Cache for the results of the operations
+	 *
+	 * Keeps the outputs of previous runs. Reverting a parameter to an earlier
+	 * value restores the results instead of recalculating them. Use
+	 * ResultCache::SetBudget() to limit the memory.
+	 */
+	ResultCache& GetCache();
+
+	/**\brief Timing and memory of every operation of the last builds
+	 *
+	 * Also collected in release builds. Export with BuildProfile::ToCSV() or
+	 * BuildProfile::ToJSON().
+	 */
+	BuildProfile& GetProfile();
 
 	void Paint() const;
 
 #ifdef DEBUG
-	void ToDot(std::ostream &out, const Project &project) const;
+	void ToDot(std::ostream &out, const ProjectData &project) const;
 	void ToCSV(std::ostream &out) const;
 #endif
 
@@ -195,7 +255,31 @@ public:
 	}
 
 private:
-	void Connect(Project &project);
+	/**\brief Operations that depend on the measurements of one foot
+	 *
+	 * There is one chain for each foot. The Scheduler runs the two chains in
+	 * parallel. Operations that only depend on the configuration (loading of
+	 * files, normalizing, ...) exist once and feed both chains.
+	 */
+	struct Chain {
+		std::shared_ptr<CoordinateSystemConstruct> opCoordinateSystemConstruct;
+		std::shared_ptr<FootModelUpdate> opFootModelUpdate;
+		std::shared_ptr<HeelCenter> opHeelCenter;
+		std::shared_ptr<HeelConstruct> opHeelConstruct;
+		std::shared_ptr<InsoleAnalyze> opInsoleAnalyze;
+		std::shared_ptr<InsoleConstruct> opInsoleConstruct;
+		std::shared_ptr<InsoleTransform> opInsoleTransform;
+		std::shared_ptr<LastAnalyse> opLastAnalyse;
+		std::shared_ptr<LastConstruct> opLastConstruct;
+		std::shared_ptr<LastUpdate> opLastUpdate;
+		std::shared_ptr<UpperConstruct> opUpperConstruct;
+		std::shared_ptr<UpperFlatten> opUpperFlatten;
+	};
+
+	void SetupChain(Chain &chain, const Configuration &config,
+			const FootMeasurements &foot);
+	void Connect(ProjectData &project);
+	void ConnectChain(Chain &chain, ProjectData &project, bool left);
 	void ResetState();
 
 public:
@@ -203,27 +287,19 @@ public:
 
 private:
 	std::vector<std::shared_ptr<Operation>> operations;
+	Scheduler scheduler;
 
-    std::shared_ptr<CoordinateSystemConstruct> opCoordinateSystemConstruct;
     std::shared_ptr<FootModelLoad> opFootModelLoad;
-    std::shared_ptr<FootModelUpdate> opFootModelUpdate;
     std::shared_ptr<FootScanLoad> opFootScanLoad;
-    std::shared_ptr<HeelCenter> opHeelCenter;
-    std::shared_ptr<HeelConstruct> opHeelConstruct;
     std::shared_ptr<HeelExtractInsole> opHeelExtractInsole;
     std::shared_ptr<ObjectLoad> opHeelLoad;
     std::shared_ptr<HeelNormalize> opHeelNormalize;
-    std::shared_ptr<InsoleAnalyze> opInsoleAnalyze;
-    std::shared_ptr<InsoleConstruct> opInsoleConstruct;
     std::shared_ptr<InsoleFlatten> opInsoleFlatten;
-    std::shared_ptr<InsoleTransform> opInsoleTransform;
-    std::shared_ptr<LastAnalyse> opLastAnalyse;
-    std::shared_ptr<LastConstruct> opLastConstruct;
     std::shared_ptr<ObjectLoad> opLastLoad;
     std::shared_ptr<LastNormalize> opLastNormalize;
-    std::shared_ptr<LastUpdate> opLastUpdate;
-    std::shared_ptr<UpperConstruct> opUpperConstruct;
-    std::shared_ptr<UpperFlatten> opUpperFlatten;
+
+	Chain chainL;
+	Chain chainR;
 
 #ifdef DEBUG
 	size_t debug_count = 0;
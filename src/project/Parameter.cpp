@@ -26,8 +26,12 @@
 
 #include "Parameter.h"
 
+#include "../system/Hash.h"
+
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 Parameter::Parameter(const std::string &name_, const std::string &description_,
 		const size_t id_, const size_t group_) :
@@ -55,3 +59,12 @@ std::string Parameter::GetDescription() const {
 	return description;
 }
 
+
+size_t Parameter::GetHash() const {
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	SHA256 hash;
+	hash.Add(GetString());
+	hash.Add(bits);
+	return (size_t) hash.Get64();
+}
@@ -77,6 +77,12 @@ public:
 	virtual std::string GetString() const = 0;
 	virtual void SetString(const std::string &newString_) = 0;
 
+	/**\brief Hash of the string and the calculated value
+	 *
+	 * Used by the Operation%s to generate the keys for the ResultCache.
+	 */
+	size_t GetHash() const;
+
 protected:
 	/**\brief ID for parameter
 	 *
@@ -29,6 +29,7 @@
 #include "Parameter.h"
 
 #include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 
@@ -43,6 +44,7 @@ void ParameterEvaluator::SetGroup(const size_t group) {
 	if (std::find(groupIdx.begin(), groupIdx.end(), group) == groupIdx.end()) {
 		groupIdx.push_back(group);
 		lookupGroupIdx[group] = (groupIdx.size() - 1);
+		structureModified = true;
 	}
 }
 
@@ -72,15 +74,19 @@ void ParameterEvaluator::Register(std::shared_ptr<ParameterFormula> &variable,
 	variable->group = group;
 	parameter.push_back(variable);
 	parameter.back()->base = (group == (size_t) -1);
+	AddToIndex(parameter.size() - 1);
+	structureModified = true;
 }
 
 std::shared_ptr<ParameterFormula> ParameterEvaluator::GetParameter(
 		const size_t id, const size_t group) {
-	for (std::shared_ptr<ParameterFormula> &param : parameter) {
-		if (param->id != id)
-			continue;
-		if (param->base || param->group == group)
-			return param;
+	const auto it = lookupID.find(id);
+	if (it != lookupID.end()) {
+		for (size_t idx : it->second) {
+			std::shared_ptr<ParameterFormula> &param = parameter[idx];
+			if (param->base || param->group == group)
+				return param;
+		}
 	}
 	if (group == (size_t) -1)
 		throw(new std::runtime_error(
@@ -92,18 +98,50 @@ std::shared_ptr<ParameterFormula> ParameterEvaluator::GetParameter(
 }
 
 bool ParameterEvaluator::HasID(const size_t id, const size_t group) const {
-	for (const auto &param : parameter)
-		if (param->id == id && (param->base || param->group == group))
+	const auto it = lookupID.find(id);
+	if (it == lookupID.end())
+		return false;
+	for (size_t idx : it->second)
+		if (parameter[idx]->base || parameter[idx]->group == group)
 			return true;
 	return false;
 }
 
-bool ParameterEvaluator::ConnectExternal(size_t n, std::set<size_t> &open) {
+void ParameterEvaluator::UpdateIndex() {
+	lookup.clear();
+	lookupID.clear();
+	for (size_t idx = 0; idx < parameter.size(); idx++)
+		AddToIndex(idx);
+}
+
+void ParameterEvaluator::AddToIndex(size_t idx) {
+	lookup[parameter[idx]->name].push_back(idx);
+	lookupID[parameter[idx]->id].push_back(idx);
+}
+
+std::vector<size_t> ParameterEvaluator::Candidates(
+		const std::string &name) const {
+	std::vector<size_t> candidates;
+	const auto it = lookup.find(name);
+	if (it == lookup.end())
+		return candidates;
+	for (size_t m : it->second)
+		if (m < position.size() && position[m] != (size_t) -1)
+			candidates.push_back(m);
+	std::sort(candidates.begin(), candidates.end(),
+			[this](size_t a, size_t b) {
+				return position[a] < position[b];
+			});
+	return candidates;
+}
+
+std::string ParameterEvaluator::ConnectExternal(size_t n,
+		std::vector<size_t> &open) {
 
-	bool skip = false;
 	const size_t NVar = parameter[n]->parser.vm.heap.size();
 	parameter[n]->parser.vm.externalvariables.resize(NVar);
 	const size_t neededGroup = parameter[n]->group;
+	inputs[n].clear();
 	for (size_t idxNeededVar = 0; idxNeededVar < NVar; idxNeededVar++) {
 		parameter[n]->parser.vm.externalvariables[idxNeededVar].reset();
 		const auto &neededVar = parameter[n]->parser.vm.heap[idxNeededVar];
@@ -111,15 +149,12 @@ bool ParameterEvaluator::ConnectExternal(size_t n, std::set<size_t> &open) {
 			continue;
 
 		bool found = false;
-		for (const auto m : evaluationOrder) {
+		for (const auto m : Candidates(neededVar.name)) {
 			if (neededGroup != (size_t) (-1)
 					&& parameter[m]->group != (size_t) (-1)
 					&& neededGroup != parameter[m]->group)
 				continue;
 
-			if (neededVar.name.compare(parameter[m]->name) != 0)
-				continue;
-
 			if (neededGroup == (size_t) (-1)
 					&& parameter[m]->group != (size_t) (-1)) {
 				// This is the special case, where parameter splitting
@@ -137,7 +172,10 @@ bool ParameterEvaluator::ConnectExternal(size_t n, std::set<size_t> &open) {
 					temp->group = groupIdx[i];
 					temp->extra = true;
 					parameter.push_back(temp);
-					open.insert(parameter.size() - 1);
+					AddToIndex(parameter.size() - 1);
+					position.push_back((size_t) -1);
+					inputs.emplace_back();
+					open.push_back(parameter.size() - 1);
 				}
 				if (parameter[m]->group != parameter[n]->group)
 					continue;
@@ -150,15 +188,70 @@ bool ParameterEvaluator::ConnectExternal(size_t n, std::set<size_t> &open) {
 			// of an internal one.
 			parameter[n]->parser.vm.ConvertToExternal(idxNeededVar,
 					idxNeededVar);
+			inputs[n].push_back(m);
 			found = true;
 			break;
 		}
-		if (!found) {
-			skip = true;
+		if (!found)
+			return neededVar.name;
+	}
+	std::sort(inputs[n].begin(), inputs[n].end());
+	inputs[n].erase(std::unique(inputs[n].begin(), inputs[n].end()),
+			inputs[n].end());
+	return std::string();
+}
+
+bool ParameterEvaluator::Reconnect(size_t n) {
+	ParameterFormula &param = *parameter[n];
+	// Split global parameters are cloned again by UpdateStructure().
+	if (param.extra || (param.base && param.group != (size_t) -1))
+		return false;
+
+	MathParser::VM &vm = param.parser.vm;
+	const size_t NVar = vm.heap.size();
+	std::vector<size_t> references(NVar, (size_t) -1);
+	for (size_t idxNeededVar = 0; idxNeededVar < NVar; idxNeededVar++) {
+		const auto &neededVar = vm.heap[idxNeededVar];
+		if (!neededVar.isinput)
+			continue;
+		for (const auto m : Candidates(neededVar.name)) {
+			if (param.group != (size_t) (-1)
+					&& parameter[m]->group != (size_t) (-1)
+					&& param.group != parameter[m]->group)
+				continue;
+			references[idxNeededVar] = m;
 			break;
 		}
+		// Missing references and references needing a split are handled
+		// (and reported) by UpdateStructure().
+		const size_t m = references[idxNeededVar];
+		if (m == (size_t) -1
+				|| (param.group == (size_t) -1
+						&& parameter[m]->group != (size_t) -1))
+			return false;
 	}
-	return skip;
+
+	std::vector<size_t> temp;
+	for (size_t m : references)
+		if (m != (size_t) -1)
+			temp.push_back(m);
+	std::sort(temp.begin(), temp.end());
+	temp.erase(std::unique(temp.begin(), temp.end()), temp.end());
+	if (temp != inputs[n])
+		return false;
+
+	vm.externalvariables.resize(NVar);
+	for (size_t idxNeededVar = 0; idxNeededVar < NVar; idxNeededVar++) {
+		vm.externalvariables[idxNeededVar].reset();
+		if (references[idxNeededVar] == (size_t) -1)
+			continue;
+		vm.externalvariables[idxNeededVar] =
+				parameter[references[idxNeededVar]];
+		vm.ConvertToExternal(idxNeededVar, idxNeededVar);
+	}
+	param.connected = true;
+	outdated[n] = true;
+	return true;
 }
 
 void ParameterEvaluator::Reset() {
@@ -181,11 +274,28 @@ void ParameterEvaluator::Reset() {
 		if (param->base)
 			param->group = (size_t) (-1);
 	}
+	UpdateIndex();
+	structureModified = true;
 }
 
 void ParameterEvaluator::Update() {
-	std::set<size_t> open;
+	// Changed formulas referencing the same parameters as before are
+	// connected in place.
+	if (!structureModified) {
+		for (size_t n = 0; n < parameter.size(); n++) {
+			if (parameter[n]->connected)
+				continue;
+			if (!Reconnect(n)) {
+				structureModified = true;
+				break;
+			}
+		}
+	}
+	if (structureModified)
+		UpdateStructure();
+}
 
+void ParameterEvaluator::UpdateStructure() {
 	// Reset some flags in the the parameters
 	Reset();
 
@@ -198,91 +308,122 @@ void ParameterEvaluator::Update() {
 	// need to be split after descending into variants and coming back to
 	// global parameters.
 
-	for (size_t n = 0; n < parameter.size(); n++)
-		open.insert(n);
+	std::vector<size_t> open(parameter.size());
+	std::iota(open.begin(), open.end(), 0);
 	evaluationOrder.clear();
-
-	size_t N0 = open.size();
-	do {
-		for (size_t n = 0; n < parameter.size(); n++) {
-			//TODO Change the check into iterator magic.
-			if (open.find(n) == open.end())
-				continue;
-			bool skip = ConnectExternal(n, open);
-			if (skip)
-				continue;
-			evaluationOrder.push_back(n);
-			open.erase(n);
+	position.assign(parameter.size(), (size_t) -1);
+	inputs.assign(parameter.size(), std::vector<size_t>());
+
+	// A parameter with an input, that is not in the evaluationOrder yet, waits
+	// for a parameter with that name to be added.
+	std::unordered_map<std::string, std::vector<size_t>> waiting;
+	for (size_t i = 0; i < open.size(); i++) {
+		const size_t n = open[i];
+		const std::string missing = ConnectExternal(n, open);
+		if (!missing.empty()) {
+			waiting[missing].push_back(n);
+			continue;
+		}
+		position[n] = evaluationOrder.size();
+		evaluationOrder.push_back(n);
+		const auto it = waiting.find(parameter[n]->name);
+		if (it != waiting.end()) {
+			open.insert(open.end(), it->second.begin(), it->second.end());
+			waiting.erase(it);
 		}
+	}
 
-		if (N0 == open.size()) {
-			// The size of the open list did not reduce, so either a
-			// reference was not found or a loop exists, that cannot be
-			// resolved.
-			std::ostringstream err;
-
-			bool hasMissingReferences = false;
-			for (size_t idx : open) {
-				const size_t neededGroup = parameter[idx]->group;
-				for (size_t idxNeededVar = 0;
-						idxNeededVar < parameter[idx]->parser.vm.heap.size();
-						idxNeededVar++) {
-					const auto &neededVar =
-							parameter[idx]->parser.vm.heap[idxNeededVar];
-					if (!neededVar.isinput)
-						continue;
-					auto varcmp = [neededGroup, name = neededVar.name](
-							const std::shared_ptr<ParameterFormula> &p) {
-						if (neededGroup != (size_t) (-1)
-								&& p->group != (size_t) (-1)
-								&& neededGroup != p->group)
-							return false;
-						return (name.compare(p->name) == 0);
-					};
-					const auto found = std::find_if(parameter.begin(),
-							parameter.end(), varcmp);
-					if (found == parameter.end()) {
-						err << "The variable ";
-						err << "\"" << parameter[idx]->name << "\"";
-						if (parameter[idx]->group != (size_t) -1)
-							err << " in group " << parameter[idx]->group;
-						err << " has a reference to \"";
-						err << neededVar.name << "\" which does not exist. ";
-						hasMissingReferences = true;
-						parameter[idx]->errorFlag = true;
-						if (parameter[idx]->errorStr.empty()) {
-							parameter[idx]->errorStr =
-									"These variables do not exist: ";
-							parameter[idx]->errorStr += neededVar.name;
-						} else {
-							parameter[idx]->errorStr += ", " + neededVar.name;
-						}
+	if (evaluationOrder.size() < parameter.size()) {
+		// Either a reference was not found or a loop exists, that cannot be
+		// resolved.
+		std::set<size_t> unresolved;
+		for (size_t n = 0; n < parameter.size(); n++)
+			if (position[n] == (size_t) -1)
+				unresolved.insert(n);
+
+		std::ostringstream err;
+
+		bool hasMissingReferences = false;
+		for (size_t idx : unresolved) {
+			const size_t neededGroup = parameter[idx]->group;
+			for (size_t idxNeededVar = 0;
+					idxNeededVar < parameter[idx]->parser.vm.heap.size();
+					idxNeededVar++) {
+				const auto &neededVar =
+						parameter[idx]->parser.vm.heap[idxNeededVar];
+				if (!neededVar.isinput)
+					continue;
+				auto varcmp = [neededGroup, name = neededVar.name](
+						const std::shared_ptr<ParameterFormula> &p) {
+					if (neededGroup != (size_t) (-1)
+							&& p->group != (size_t) (-1)
+							&& neededGroup != p->group)
+						return false;
+					return (name.compare(p->name) == 0);
+				};
+				const auto found = std::find_if(parameter.begin(),
+						parameter.end(), varcmp);
+				if (found == parameter.end()) {
+					err << "The variable ";
+					err << "\"" << parameter[idx]->name << "\"";
+					if (parameter[idx]->group != (size_t) -1)
+						err << " in group " << parameter[idx]->group;
+					err << " has a reference to \"";
+					err << neededVar.name << "\" which does not exist. ";
+					hasMissingReferences = true;
+					parameter[idx]->errorFlag = true;
+					if (parameter[idx]->errorStr.empty()) {
+						parameter[idx]->errorStr =
+								"These variables do not exist: ";
+						parameter[idx]->errorStr += neededVar.name;
+					} else {
+						parameter[idx]->errorStr += ", " + neededVar.name;
 					}
 				}
 			}
-			if (!hasMissingReferences) {
-				for (size_t idx : open) {
-					err << "The formulas entered contain a reference loop ";
-					err << "over ";
-					bool first = true;
-					if (first)
-						first = false;
-					else
-						err << ", ";
-					err << parameter[idx]->name;
-				}
-				err << '.';
+		}
+		if (!hasMissingReferences) {
+			for (size_t idx : unresolved) {
+				err << "The formulas entered contain a reference loop ";
+				err << "over ";
+				bool first = true;
+				if (first)
+					first = false;
+				else
+					err << ", ";
+				err << parameter[idx]->name;
 			}
-			throw std::runtime_error(err.str());
+			err << '.';
 		}
-		N0 = open.size();
+		throw std::runtime_error(err.str());
+	}
 
-	} while (!open.empty());
+	dependents.assign(parameter.size(), std::vector<size_t>());
+	for (size_t n = 0; n < parameter.size(); n++) {
+		parameter[n]->connected = true;
+		for (size_t m : inputs[n])
+			dependents[m].push_back(n);
+	}
+	outdated.assign(parameter.size(), true);
+	structureModified = false;
 }
 
 void ParameterEvaluator::Calculate() {
-	for (size_t idx : evaluationOrder)
-		parameter[idx]->Calculate();
+	for (size_t idx : evaluationOrder) {
+		if (!outdated[idx])
+			continue;
+		outdated[idx] = false;
+		ParameterFormula &param = *parameter[idx];
+		const double oldValue = param.ToDouble();
+		const Unit oldUnit = param.GetUnit();
+		const bool oldError = param.errorFlag;
+		param.Calculate();
+		if (param.ToDouble() == oldValue && param.GetUnit() == oldUnit
+				&& param.errorFlag == oldError)
+			continue;
+		for (size_t m : dependents[idx])
+			outdated[m] = true;
+	}
 }
 
 void ParameterEvaluator::Clear() {
@@ -290,5 +431,12 @@ void ParameterEvaluator::Clear() {
 	groupIdx.clear();
 	lookupGroupIdx.clear();
 	evaluationOrder.clear();
+	lookup.clear();
+	lookupID.clear();
+	position.clear();
+	inputs.clear();
+	dependents.clear();
+	outdated.clear();
+	structureModified = true;
 	currentGroup = (size_t) -1;
 }
@@ -51,6 +51,17 @@
  * group 1 and one with group 2 for that variable. All other variables are
  * taken from the no-group.
  *
+ * ## Incremental evaluation
+ *
+ * The parameters are indexed by name and by ID. Update() keeps the
+ * connections and the evaluationOrder as long as the structure does not
+ * change. A formula, that was changed but references the same parameters as
+ * before, is only reconnected. Everything else (registering parameters, new
+ * references, splitting of global parameters) rebuilds the structure.
+ *
+ * Calculate() only evaluates the parameters, that were changed, and the
+ * parameters depending on them, if their value or unit changed.
+ *
  * ## JSON
  *
  * This lass uses JSON serialization to store and retrieve its contents to
@@ -112,12 +123,16 @@ public:
 	 * assigns the parameters depending on their group to the Evaluation%s.
 	 * The Parameter calculations are linked and an evaluationOrder is
 	 * calculated for each variant.
+	 *
+	 * If only formulas were changed and their references stay the same, the
+	 * changed formulas are reconnected and the rest is kept.
 	 */
 	void Update();
 
 	/**\brief Calculated the values of the variables.
 	 *
-	 * Does the actual calculation.
+	 * Does the actual calculation. Only the parameters changed since the
+	 * last call and their dependents are evaluated.
 	 */
 	void Calculate();
 
@@ -130,18 +145,49 @@ public:
 	bool HasID(const size_t id, const size_t group = (size_t) -1) const;
 
 private:
-	bool ConnectExternal(size_t n, std::set<size_t> &open);
+	void UpdateStructure();
+	void UpdateIndex();
+	void AddToIndex(size_t idx);
+
+	/**\brief Connect the inputs of a parameter
+	 *
+	 * Only parameters already in the evaluationOrder are connected. Global
+	 * parameters using a variant are split and the clones are appended to
+	 * open.
+	 *
+	 * \return Name of the first input, that cannot be connected (yet), or an
+	 * 		   empty string.
+	 */
+	std::string ConnectExternal(size_t n, std::vector<size_t> &open);
+
+	/**\brief Connect a changed formula without changing the structure
+	 *
+	 * \return false, if the references of the formula changed and the
+	 * 		   structure has to be updated.
+	 */
+	bool Reconnect(size_t n);
+
+	/**\brief Parameters with a name in the order of the evaluation
+	 *
+	 * Parameters not in the evaluationOrder yet are left out.
+	 */
+	std::vector<size_t> Candidates(const std::string &name) const;
 
 	std::vector<std::shared_ptr<ParameterFormula>> parameter;
 
-//	std::set<std::string> parameterNames;
-//	std::unordered_map<std::string, size_t> lookup;
-//	std::unordered_map<size_t, size_t> lookupID;
+	std::unordered_map<std::string, std::vector<size_t>> lookup; ///< Name to indices in parameter
+	std::unordered_map<size_t, std::vector<size_t>> lookupID; ///< ID to indices in parameter
 
 	std::vector<size_t> groupIdx;
 	std::unordered_map<size_t, size_t> lookupGroupIdx;
 
 	std::vector<size_t> evaluationOrder;
+	std::vector<size_t> position; ///< Position of each parameter in the evaluationOrder
+
+	std::vector<std::vector<size_t>> inputs; ///< Parameters referenced by each parameter
+	std::vector<std::vector<size_t>> dependents; ///< Parameters referencing each parameter
+	std::vector<bool> outdated; ///< Parameters to evaluate in the next Calculate()
+	bool structureModified = true;
 
 //	std::vector<Evaluation> evaluations;
 
@@ -0,0 +1,331 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ParameterEvaluator_test.cpp
+// Purpose            : Incremental evaluation of the ParameterEvaluator
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_CPPUNIT
+
+#include "ParameterEvaluator.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ParameterFormula.h"
+#include "../system/StopWatch.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class ParameterEvaluatorTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( ParameterEvaluatorTest );
+	CPPUNIT_TEST(testSameReferences);
+	CPPUNIT_TEST(testDependents);
+	CPPUNIT_TEST(testChangedReference);
+	CPPUNIT_TEST(testSplit);
+	CPPUNIT_TEST(testErrors);
+	CPPUNIT_TEST(testSpeed);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	typedef std::vector<std::shared_ptr<ParameterFormula>> Parameters;
+
+	static std::shared_ptr<ParameterFormula> Add(ParameterEvaluator &ev,
+			const std::string &name, const std::string &formula, size_t id) {
+		auto p = ev.Register(name, "", "", id);
+		p->SetString(formula);
+		return p;
+	}
+
+	/**\brief Chain of global parameters and two groups of variant parameters
+	 *
+	 * Every tenth global parameter uses a variant parameter and is split.
+	 * Every third variant parameter is a constant, the others use the
+	 * variant parameter before and a global parameter.
+	 *
+	 * \return The variant parameters
+	 */
+	static Parameters Variants(ParameterEvaluator &ev, size_t N,
+			Parameters &all) {
+		Parameters variants;
+		ev.SetGroup();
+		for (size_t i = 0; i < N; i++) {
+			std::string f =
+					(i == 0) ?
+							"1 cm" : ("c" + std::to_string(i - 1) + " + 1 mm");
+			if (i % 10 == 5)
+				f = "m" + std::to_string(i) + " * 1.01 + c"
+						+ std::to_string(i - 1);
+			all.push_back(Add(ev, "c" + std::to_string(i), f, 1000 + i));
+		}
+		for (size_t g = 0; g < 2; g++) {
+			ev.SetGroup(g);
+			for (size_t i = 0; i < N; i++) {
+				const std::string f =
+						(i % 3 == 0) ?
+								std::to_string(20 + i + g) + " cm" :
+								("m" + std::to_string(i - 1) + " * 0.9 + c0");
+				all.push_back(
+						Add(ev, "m" + std::to_string(i), f, 5000 + i));
+				variants.push_back(all.back());
+			}
+		}
+		return variants;
+	}
+
+	static void Evaluate(ParameterEvaluator &ev) {
+		ev.Update();
+		ev.Calculate();
+	}
+
+	/**\brief Compare all values against an evaluator set up from scratch
+	 */
+	static void CheckFull(const Parameters &all, size_t N) {
+		ParameterEvaluator full;
+		Parameters fresh;
+		Variants(full, N, fresh);
+		CPPUNIT_ASSERT_EQUAL(all.size(), fresh.size());
+		for (size_t i = 0; i < all.size(); i++)
+			fresh[i]->SetString(all[i]->GetString());
+		Evaluate(full);
+		for (size_t i = 0; i < all.size(); i++) {
+			CPPUNIT_ASSERT_EQUAL(fresh[i]->ToDouble(), all[i]->ToDouble());
+			CPPUNIT_ASSERT(fresh[i]->GetUnit() == all[i]->GetUnit());
+		}
+	}
+
+	void testSameReferences() {
+		const size_t N = 30;
+		ParameterEvaluator ev;
+		Parameters all;
+		Parameters variants = Variants(ev, N, all);
+		Evaluate(ev);
+		CheckFull(all, N);
+
+		// Constants and formulas with the same references
+		variants[3]->SetString("15 cm");
+		Evaluate(ev);
+		CheckFull(all, N);
+		variants[N + 4]->SetString("m3 * 0.5 + c0");
+		all[0]->SetString("2 cm");
+		Evaluate(ev);
+		CheckFull(all, N);
+		all[15]->SetString("c14 + m15 / 2");
+		Evaluate(ev);
+		CheckFull(all, N);
+	}
+
+	/**\brief Only the changed parameter and its dependents are evaluated
+	 *
+	 * A parameter that is evaluated clears its errorFlag. The flag is set by
+	 * hand on all parameters before the edit.
+	 */
+	void testDependents() {
+		ParameterEvaluator ev;
+		auto x = Add(ev, "x", "1 cm", 1);
+		auto y = Add(ev, "y", "x * 2", 2);
+		auto z = Add(ev, "z", "y + 1 cm", 3);
+		auto w = Add(ev, "w", "3 cm", 4);
+		auto u = Add(ev, "u", "w * 2", 5);
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.03, z->ToDouble(), 1e-12);
+
+		const Parameters all = { x, y, z, w, u };
+		for (auto &p : all)
+			p->errorFlag = true;
+		x->SetString("2 cm");
+		Evaluate(ev);
+		CPPUNIT_ASSERT(!x->errorFlag);
+		CPPUNIT_ASSERT(!y->errorFlag);
+		CPPUNIT_ASSERT(!z->errorFlag);
+		CPPUNIT_ASSERT(w->errorFlag);
+		CPPUNIT_ASSERT(u->errorFlag);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.05, z->ToDouble(), 1e-12);
+
+		// Nothing changed: nothing is evaluated.
+		for (auto &p : all)
+			p->errorFlag = true;
+		Evaluate(ev);
+		for (auto &p : all)
+			CPPUNIT_ASSERT(p->errorFlag);
+		for (auto &p : all)
+			p->errorFlag = false;
+
+		// The same value stops the propagation.
+		y->SetString("x + x");
+		z->errorFlag = true;
+		Evaluate(ev);
+		CPPUNIT_ASSERT(z->errorFlag);
+	}
+
+	void testChangedReference() {
+		ParameterEvaluator ev;
+		auto x = Add(ev, "x", "1 cm", 1);
+		auto y = Add(ev, "y", "x * 2", 2);
+		auto w = Add(ev, "w", "3 cm", 3);
+		auto v = Add(ev, "v", "y + w", 4);
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.05, v->ToDouble(), 1e-12);
+
+		// y is rebuilt to follow w instead of x.
+		y->SetString("w * 2");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.06, y->ToDouble(), 1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.09, v->ToDouble(), 1e-12);
+		x->SetString("5 cm");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.09, v->ToDouble(), 1e-12);
+		w->SetString("1 cm");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.02, y->ToDouble(), 1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.03, v->ToDouble(), 1e-12);
+
+		// A parameter registered later than its user
+		v->SetString("y + late");
+		Add(ev, "late", "1 m", 5);
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.02, v->ToDouble(), 1e-12);
+	}
+
+	/**\brief Global parameters using a variant are split for each group
+	 */
+	void testSplit() {
+		ParameterEvaluator ev;
+		ev.SetGroup();
+		auto k = Add(ev, "k", "2 cm", 1);
+		auto a = Add(ev, "a", "b + 1 cm", 2);
+		ev.SetGroup(0);
+		Add(ev, "b", "10 cm", 3);
+		Add(ev, "e", "a * 2", 4);
+		ev.SetGroup(1);
+		Add(ev, "b", "20 cm", 3);
+		Add(ev, "e", "a * 2", 4);
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.22, ev.GetParameter(4, 0)->ToDouble(),
+				1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.42, ev.GetParameter(4, 1)->ToDouble(),
+				1e-12);
+
+		// No variant used: a is global again.
+		a->SetString("k * 2");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.08, ev.GetParameter(4, 0)->ToDouble(),
+				1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.08, ev.GetParameter(4, 1)->ToDouble(),
+				1e-12);
+		k->SetString("3 cm");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.12, ev.GetParameter(4, 1)->ToDouble(),
+				1e-12);
+
+		// Split again, the clones follow changes of the global parameters.
+		a->SetString("k + b");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.26, ev.GetParameter(4, 0)->ToDouble(),
+				1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.46, ev.GetParameter(4, 1)->ToDouble(),
+				1e-12);
+		k->SetString("1 cm");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.22, ev.GetParameter(4, 0)->ToDouble(),
+				1e-12);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.42, ev.GetParameter(4, 1)->ToDouble(),
+				1e-12);
+	}
+
+	void testErrors() {
+		ParameterEvaluator ev;
+		auto x = Add(ev, "x", "1 cm", 1);
+		auto y = Add(ev, "y", "x * 2", 2);
+		auto z = Add(ev, "z", "y + 1 cm", 3);
+		Evaluate(ev);
+
+		x->SetString("missing + 1 cm");
+		CPPUNIT_ASSERT_THROW(ev.Update(), std::runtime_error);
+		x->SetString("z + 1 cm");
+		CPPUNIT_ASSERT_THROW(ev.Update(), std::runtime_error);
+
+		// Back to normal
+		x->SetString("4 cm");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.09, z->ToDouble(), 1e-12);
+		y->SetString("x * 3");
+		Evaluate(ev);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.13, z->ToDouble(), 1e-12);
+	}
+
+	/**\brief Edit single variant parameters in a large set
+	 *
+	 * Compares the incremental evaluation to a full recalculation after
+	 * Reset().
+	 */
+	void testSpeed() {
+		const size_t N = 300;
+		const size_t R = 100;
+		ParameterEvaluator ev;
+		Parameters all;
+		Parameters variants = Variants(ev, N, all);
+		ParameterEvaluator evFull;
+		Parameters allFull;
+		Parameters variantsFull = Variants(evFull, N, allFull);
+
+		StopWatch watch;
+		watch.Start();
+		Evaluate(ev);
+		watch.Stop();
+		std::cout << "\n" << all.size() << " parameters, initial: "
+				<< watch.GetSecondsCPU() * 1e3 << " ms\n";
+		Evaluate(evFull);
+
+		StopWatch watchIncremental;
+		StopWatch watchFull;
+		for (size_t r = 0; r < R; r++) {
+			// Constants only
+			const size_t n = ((r * 37) / 3 * 3) % variants.size();
+			const std::string f = std::to_string(10 + r % 7) + " cm";
+			variants[n]->SetString(f);
+			variantsFull[n]->SetString(f);
+
+			watchIncremental.Start();
+			Evaluate(ev);
+			watchIncremental.Stop();
+
+			watchFull.Start();
+			evFull.Reset();
+			Evaluate(evFull);
+			watchFull.Stop();
+		}
+		for (size_t i = 0; i < all.size(); i++)
+			CPPUNIT_ASSERT_EQUAL(allFull[i]->ToDouble(), all[i]->ToDouble());
+		std::cout << "Per edit: incremental "
+				<< watchIncremental.GetSecondsCPU() * 1e3 / R
+				<< " ms, full recalculation "
+				<< watchFull.GetSecondsCPU() * 1e3 / R << " ms\n";
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ParameterEvaluatorTest);
+#endif
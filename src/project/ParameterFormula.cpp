@@ -55,6 +55,7 @@ std::string ParameterFormula::GetString() const {
 
 void ParameterFormula::Init() {
 	parser.vm.Clear();
+	connected = false;
 	errorFlag = false;
 	errorStr.clear();
 	try {
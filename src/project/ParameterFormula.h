@@ -139,6 +139,13 @@ protected:
 	 */
 	bool unstable = false;
 
+	/**\brief Indicates, that the inputs are connected to other parameters.
+	 *
+	 * Reset when the formula is parsed. The ParameterEvaluator connects the
+	 * new code to the referenced parameters in the next Update().
+	 */
+	bool connected = false;
+
 public:
 	bool errorFlag = false; //!< \b True, if an error occurred during evaluation of the formula.
 	std::string errorStr; //!< If an error occurred this contains the error otherwise empty.
@@ -32,6 +32,7 @@
 #include "WorkerThread.h"
 
 #include <wx/log.h>
+#include <wx/stdpaths.h>
 #include <wx/txtstrm.h>
 #if wxUSE_STD_IOSTREAM
 #include <wx/wfstream.h>
@@ -40,6 +41,7 @@
 #endif
 
 #include <cstdio>
+#include <filesystem>
 #include <float.h>
 
 #include "../gui/gui.h"
@@ -50,31 +52,19 @@
 IMPLEMENT_DYNAMIC_CLASS(Project, wxDocument)
 
 Project::Project() :
-		wxDocument() {
-
-	Register(); // Register all ParameterFormulas with the ParameterEvaluator.
+		wxDocument(), threadEnded(CS) {
 
 //	footScan.InitExample();
 
 	thread0 = nullptr;
 	thread1 = nullptr;
 
-	// Init the (potential) inputs to the build process.
-
-	design = std::make_shared<Design>();
-
-	insoleFlatL = std::make_shared<Insole>();
-	insoleFlatR = std::make_shared<Insole>();
-	insoleL = std::make_shared<Insole>();
-	insoleR = std::make_shared<Insole>();
-
-	lastL = std::make_shared<LastModel>();
-	lastR = std::make_shared<LastModel>();
-
-	heelL = std::make_shared<ObjectGeometry>();
-	heelR = std::make_shared<ObjectGeometry>();
-
 	builder.Setup(*this);
+	// The imported lasts and heels are kept on disk between sessions.
+	builder.GetCache().SetDirectory(
+			(std::filesystem::path(
+					wxStandardPaths::Get().GetUserLocalDataDir().ToStdString())
+					/ "cache").string());
 
 	Bind(wxEVT_COMMAND_THREAD_COMPLETED, &Project::OnCalculationDone, this);
 	Bind(wxEVT_COMMAND_THREAD_UPDATE, &Project::OnRefreshViews, this);
@@ -84,29 +74,10 @@ Project::Project() :
 Project::~Project() {
 	Unbind(wxEVT_COMMAND_THREAD_UPDATE, &Project::OnRefreshViews, this);
 	Unbind(wxEVT_COMMAND_THREAD_COMPLETED, &Project::OnCalculationDone, this);
-	{
-		wxCriticalSectionLocker locker(CSLeft);
-		if (thread0 != nullptr)
-			thread0->Delete();
-	}
-	{
-		wxCriticalSectionLocker locker(CSRight);
-		if (thread1 != nullptr)
-			thread1->Delete();
-	}
+	StopBuild();
 	DEBUGOUT << "Project: Destructor called.\n";
 }
 
-void Project::Register() {
-	evaluator.Clear();
-	evaluator.SetGroup();
-	config.Register(evaluator);
-	evaluator.SetGroup((size_t) ProjectView::Side::Left);
-	footL.Register(evaluator);
-	evaluator.SetGroup((size_t) ProjectView::Side::Right);
-	footR.Register(evaluator);
-}
-
 void Project::CheckNeeded() {
 	const auto &v = GetViews();
 	for (auto &ob : v) {
@@ -149,31 +120,62 @@ void Project::CheckNeeded() {
 }
 
 void Project::Update() {
-	if (config.IsModified() || footL.IsModified() || footR.IsModified())
+	StopBuild();
+
+	if (ProjectData::IsModified())
 		Modify(true);
 
-	try {
-		evaluator.Update();
-		evaluator.Calculate();
-	} catch (std::exception &ex) {
-		std::cerr << "Error while updating: " << ex.what() << '\n';
-//		return;
-	}
+	Evaluate();
 
 	builder.Setup(*this);
 
 	CheckNeeded();
 
-	builder.Update(*this);
+	// The modified-flags are consumed by Prepare(). Everything after that only
+	// works on the objects and can be moved to the WorkerThread.
+	const bool hasToRun = builder.Prepare(*this);
 
+	ResetModified();
+
+	if (!hasToRun) {
+		if (!builder.error.empty())
+			std::cerr << builder.error << "\n";
+		UpdateAllViews();
+		return;
+	}
+
+	if (useMultiThreading) {
+		WorkerThread *thread = new WorkerThread(this, 0);
+		{
+			wxMutexLocker locker(CS);
+			thread0 = thread;
+		}
+		if (thread->Run() == wxTHREAD_NO_ERROR)
+			return;
+		delete thread; // Resets thread0.
+		std::cerr << "Project::" << __FUNCTION__
+				<< " - Could not start the worker thread.\n";
+	}
+	builder.Execute();
 	if (!builder.error.empty())
 		std::cerr << builder.error << "\n";
+	UpdateAllViews();
+}
 
-	config.Modify(false);
-	footL.Modify(false);
-	footR.Modify(false);
+void Project::StopBuild() {
+	wxMutexLocker locker(CS);
+	if (thread0 != nullptr) {
+		builder.Cancel();
+		// The thread is detached and removes itself from the project.
+		while (thread0 != nullptr)
+			threadEnded.Wait();
+	}
+	builder.ClearCancel();
+}
 
-	UpdateAllViews();
+bool Project::IsBuilding() const {
+	wxMutexLocker locker(CS);
+	return thread0 != nullptr;
 }
 
 DocumentIstream& Project::LoadObject(DocumentIstream &istream) {
@@ -189,23 +191,7 @@ DocumentIstream& Project::LoadObject(DocumentIstream &istream) {
 		if (!json.IsObject())
 			return istream;
 
-		if (json.HasKey("configuration")) {
-			JSON &conf = json["configuration"];
-			config.FromJSON(conf);
-		}
-		if (json.HasKey("measurements")) {
-			JSON &meas = json["measurements"];
-			footL.FromJSON(meas);
-			footR.FromJSON(meas);
-		}
-		if (json.HasKey("measurementsLeft")) {
-			JSON &measL = json["measurementsLeft"];
-			footL.FromJSON(measL);
-		}
-		if (json.HasKey("measurementsRight")) {
-			JSON &measR = json["measurementsRight"];
-			footR.FromJSON(measR);
-		}
+		FromJSON(json);
 		stream.clear();
 		Update();
 		UpdateAllViews();
@@ -237,19 +223,7 @@ DocumentOstream& Project::SaveObject(DocumentOstream &ostream) {
 	wxDocument::SaveObject(ostream);
 
 	JSON json;
-	json.SetObject();
-	JSON &conf = json["configuration"];
-	config.ToJSON(conf);
-
-	if (footL == footR) {
-		JSON &meas = json["measurements"];
-		footL.ToJSON(meas);
-	} else {
-		JSON &measL = json["measurementsLeft"];
-		footL.ToJSON(measL);
-		JSON &measR = json["measurementsRight"];
-		footR.ToJSON(measR);
-	}
+	ToJSON(json);
 	json.Save(stream);
 
 	DEBUGOUT << "Project::" << __FUNCTION__ << "(...)";
@@ -296,33 +270,25 @@ void Project::OnRefreshViews(wxThreadEvent &event) {
 }
 
 void Project::OnCalculationDone(wxThreadEvent &event) {
-	CS.Enter();
-
-	CS.Leave();
-	UpdateAllViews(); //TODO This has been done by OnRefreshViews.
+	if (!builder.error.empty())
+		std::cerr << builder.error << "\n";
+	UpdateAllViews();
 }
 
 void Project::StopAllThreads() {
-	{
-		wxCriticalSectionLocker enter(CS);
-		if (thread0) {
-			if (thread0->Delete() != wxTHREAD_NO_ERROR)
-				wxLogError
-				("Can't delete thread0!");
-		}
-		if (thread1) {
-			if (thread1->Delete() != wxTHREAD_NO_ERROR)
-				wxLogError
-				("Can't delete thread1!");
-		}
+	builder.Cancel();
+	wxMutexLocker enter(CS);
+	if (thread0) {
+		if (thread0->Delete() != wxTHREAD_NO_ERROR)
+			wxLogError
+			("Can't delete thread0!");
 	}
-	while (true) {
-		{
-			wxCriticalSectionLocker enter(CS);
-			if (thread0 == nullptr && thread1 == nullptr)
-				break;
-		}
-		wxThread::This()->Sleep(1);
+	if (thread1) {
+		if (thread1->Delete() != wxTHREAD_NO_ERROR)
+			wxLogError
+			("Can't delete thread1!");
 	}
+	while (thread0 != nullptr || thread1 != nullptr)
+		threadEnded.Wait();
 }
 
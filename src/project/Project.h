@@ -32,7 +32,8 @@
  * \code #include "Project.h"\endcode
  * \brief Project container
  *
- * Data part of the Data View Model.
+ * Data part of the Data View Model. The parameters and the generated
+ * objects are kept in the ProjectData base class.
  *
  * Dataflow upon update:
  *
@@ -64,17 +65,9 @@
 #include "../3D/OrientedMatrix.h"
 #include "../3D/PointCloud.h"
 #include "../3D/Polygon3.h"
-#include "CoordinateSystem.h"
 
-#include "Builder.h"
-#include "Configuration.h"
-#include "object/Design.h"
 #include "foot/FootModel.h"
-#include "FootMeasurements.h"
-#include "object/Insole.h"
-#include "object/LastModel.h"
-#include "ParameterEvaluator.h"
-#include "object/Upper.h"
+#include "ProjectData.h"
 
 class WorkerThread;
 
@@ -86,7 +79,7 @@ typedef wxInputStream DocumentIstream;
 typedef wxOutputStream DocumentOstream;
 #endif // wxUSE_STD_IOSTREAM/!wxUSE_STD_IOSTREAM
 
-class Project: public wxDocument {
+class Project: public wxDocument, public ProjectData {
 	friend class WorkerThread;
 public:
 
@@ -101,10 +94,22 @@ public:
 	void SaveLast(wxString fileName, bool left, bool right);
 	void SaveSkin(wxString fileName, bool left, bool right);
 
-	void Register();
 	void CheckNeeded();
+	/**\brief Recalculate everything that depends on modified parameters
+	 *
+	 * A running build is cancelled first. The flags are evaluated in the
+	 * calling thread; the calculation itself is done in a WorkerThread. The
+	 * views are updated, when it is finished.
+	 */
 	void Update();
 
+	/**\brief Cancel the running build and wait until it has stopped
+	 *
+	 * Call this before modifying parameters, that are read by the build.
+	 */
+	void StopBuild();
+	bool IsBuilding() const; ///< The objects are being written to.
+
 	void StopAllThreads(); //!< Call from OnClose; the event loop has to be running.
 
 private:
@@ -112,40 +117,6 @@ private:
 	void OnRefreshViews(wxThreadEvent &event);
 
 public:
-
-	Configuration config;
-	FootMeasurements footL;
-	FootMeasurements footR;
-	std::shared_ptr<Design> design;
-
-	ParameterEvaluator evaluator;
-	Builder builder;
-
-	// Last to generate
-	std::shared_ptr<LastModel> lastL;
-	std::shared_ptr<LastModel> lastR;
-
-	// Shoe
-	std::shared_ptr<ObjectGeometry> heelL;
-	std::shared_ptr<ObjectGeometry> heelR;
-
-	std::shared_ptr<Insole> insoleFlatL;
-	std::shared_ptr<Insole> insoleFlatR;
-	std::shared_ptr<Insole> insoleL;
-	std::shared_ptr<Insole> insoleR;
-
-	// Pattern for the upper of the shoe
-	std::shared_ptr<CoordinateSystem> csL;
-	std::shared_ptr<CoordinateSystem> csR;
-
-	std::shared_ptr<Upper> upperL;
-	std::shared_ptr<Upper> upperR;
-
-	std::shared_ptr<Upper> flatteningL;
-	std::shared_ptr<Upper> flatteningR;
-
-
-
 //	FootModel footL;
 //	FootModel footR;
 
@@ -153,11 +124,12 @@ public:
 //	LastModel lastModelR;
 
 private:
-	bool useMultiThreading = false;
+	bool useMultiThreading = true;
 	WorkerThread *thread0;
 	WorkerThread *thread1;
 
-	wxCriticalSection CS;
+	mutable wxMutex CS; ///< Guards thread0 and thread1
+	wxCondition threadEnded; ///< Signalled by a WorkerThread, when it ends.
 	wxCriticalSection CSLeft;
 	wxCriticalSection CSRight;
 
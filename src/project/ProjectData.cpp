@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ProjectData.cpp
+// Purpose            : Project data without the document/view framework
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ProjectData.h"
+
+#include <exception>
+#include <iostream>
+
+ProjectData::ProjectData() {
+	Register();
+
+	// Init the (potential) inputs to the build process.
+
+	design = std::make_shared<Design>();
+
+	insoleFlatL = std::make_shared<Insole>();
+	insoleFlatR = std::make_shared<Insole>();
+	insoleL = std::make_shared<Insole>();
+	insoleR = std::make_shared<Insole>();
+
+	lastL = std::make_shared<LastModel>();
+	lastR = std::make_shared<LastModel>();
+
+	heelL = std::make_shared<ObjectGeometry>();
+	heelR = std::make_shared<ObjectGeometry>();
+}
+
+void ProjectData::Register() {
+	evaluator.Clear();
+	evaluator.SetGroup();
+	config.Register(evaluator);
+	evaluator.SetGroup((size_t) Side::Left);
+	footL.Register(evaluator);
+	evaluator.SetGroup((size_t) Side::Right);
+	footR.Register(evaluator);
+}
+
+void ProjectData::FromJSON(const JSON &js) {
+	if (!js.IsObject())
+		return;
+	if (js.HasKey("configuration")) {
+		const JSON &conf = js["configuration"];
+		config.FromJSON(conf);
+	}
+	if (js.HasKey("measurements")) {
+		const JSON &meas = js["measurements"];
+		footL.FromJSON(meas);
+		footR.FromJSON(meas);
+	}
+	if (js.HasKey("measurementsLeft")) {
+		const JSON &measL = js["measurementsLeft"];
+		footL.FromJSON(measL);
+	}
+	if (js.HasKey("measurementsRight")) {
+		const JSON &measR = js["measurementsRight"];
+		footR.FromJSON(measR);
+	}
+}
+
+void ProjectData::ToJSON(JSON &js) const {
+	js.SetObject();
+	JSON &conf = js["configuration"];
+	config.ToJSON(conf);
+
+	if (footL == footR) {
+		JSON &meas = js["measurements"];
+		footL.ToJSON(meas);
+	} else {
+		JSON &measL = js["measurementsLeft"];
+		footL.ToJSON(measL);
+		JSON &measR = js["measurementsRight"];
+		footR.ToJSON(measR);
+	}
+}
+
+bool ProjectData::IsModified() const {
+	return config.IsModified() || footL.IsModified() || footR.IsModified();
+}
+
+void ProjectData::ResetModified() {
+	config.Modify(false);
+	footL.Modify(false);
+	footR.Modify(false);
+}
+
+bool ProjectData::Evaluate() {
+	try {
+		evaluator.Update();
+		evaluator.Calculate();
+	} catch (std::exception &ex) {
+		std::cerr << "Error while updating: " << ex.what() << '\n';
+		return false;
+	}
+	return true;
+}
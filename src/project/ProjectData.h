@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ProjectData.h
+// Purpose            : Project data without the document/view framework
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROJECTDATA_H
+#define PROJECTDATA_H
+
+/*!\class ProjectData
+ * \ingroup project
+ * \code #include "ProjectData.h"\endcode
+ * \brief Parameters and generated objects of a project
+ *
+ * Everything the Builder needs to generate a shoe. The Project adds the
+ * document/view handling of wxWidgets on top. Without the Project this
+ * class is used by the batch build (openshoedesigner-batch), that runs on
+ * headless servers.
+ */
+
+#include "../system/JSON.h"
+#include "Builder.h"
+#include "Configuration.h"
+#include "CoordinateSystem.h"
+#include "FootMeasurements.h"
+#include "ParameterEvaluator.h"
+#include "object/Design.h"
+#include "object/Insole.h"
+#include "object/LastModel.h"
+#include "object/ObjectGeometry.h"
+#include "object/Upper.h"
+
+#include <memory>
+#include <stddef.h>
+
+class ProjectData {
+public:
+	/**\brief Side of the shoe
+	 *
+	 * The values are also used as groups in the ParameterEvaluator.
+	 */
+	enum class Side : size_t {
+		Both = 0, Left = 10, Right = 20
+	};
+
+	ProjectData();
+	virtual ~ProjectData() = default;
+
+	void Register(); ///< Register all ParameterFormula%s with the ParameterEvaluator.
+
+	void FromJSON(const JSON &js);
+	void ToJSON(JSON &js) const;
+
+	bool IsModified() const; ///< Configuration or measurements were modified.
+	void ResetModified();
+
+	/**\brief Evaluate the formulas of the parameters
+	 *
+	 * \return false, if the evaluation failed. The error is written to
+	 *         std::cerr.
+	 */
+	bool Evaluate();
+
+public:
+	Configuration config;
+	FootMeasurements footL;
+	FootMeasurements footR;
+	std::shared_ptr<Design> design;
+
+	ParameterEvaluator evaluator;
+	Builder builder;
+
+	// Last to generate
+	std::shared_ptr<LastModel> lastL;
+	std::shared_ptr<LastModel> lastR;
+
+	// Shoe
+	std::shared_ptr<ObjectGeometry> heelL;
+	std::shared_ptr<ObjectGeometry> heelR;
+
+	std::shared_ptr<Insole> insoleFlatL;
+	std::shared_ptr<Insole> insoleFlatR;
+	std::shared_ptr<Insole> insoleL;
+	std::shared_ptr<Insole> insoleR;
+
+	// Pattern for the upper of the shoe
+	std::shared_ptr<CoordinateSystem> csL;
+	std::shared_ptr<CoordinateSystem> csR;
+
+	std::shared_ptr<Upper> upperL;
+	std::shared_ptr<Upper> upperR;
+
+	std::shared_ptr<Upper> flatteningL;
+	std::shared_ptr<Upper> flatteningR;
+};
+
+#endif /* PROJECTDATA_H */
@@ -89,6 +89,10 @@ void ProjectView::Paint(bool usePicking) const {
 
 	const bool shiftapart = (showLeft && showRight);
 
+	// While a WorkerThread is building, the objects are being written to.
+	// They are painted again, when the build has finished.
+	const bool building = project->IsBuilding();
+
 	// XY in the plane and Z pointing upwards.
 	glRotatef(-90, 1, 0, 0);
 
@@ -101,7 +105,7 @@ void ProjectView::Paint(bool usePicking) const {
 	matBones.UseColor();
 
 #ifdef DEBUG
-	if (!usePicking) {
+	if (!usePicking && !building) {
 		OpenGLMaterial::EnableColors();
 		matLines.UseColor(0.8);
 
@@ -109,7 +113,7 @@ void ProjectView::Paint(bool usePicking) const {
 	}
 #endif
 
-	if (showLeft) {
+	if (showLeft && !building) {
 
 		glPushMatrix();
 		if (shiftapart)
@@ -200,7 +204,7 @@ void ProjectView::Paint(bool usePicking) const {
 
 		glPopMatrix();
 	}
-	if (showRight) {
+	if (showRight && !building) {
 		glPushMatrix();
 		if (shiftapart)
 			glTranslatef(0, -project->footR.littleToeGirth->ToDouble() / M_PI,
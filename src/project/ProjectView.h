@@ -40,14 +40,13 @@
 #include <vector>
 
 #include "../3D/BackgroundImage.h"
+#include "ProjectData.h"
 
 class FootMeasurements;
 
 class ProjectView: public wxView {
 public:
-	enum class Side : size_t {
-		Both = 0, Left = 10, Right = 20
-	};
+	typedef ProjectData::Side Side;
 	enum class Display : int {
 		Shoe = 0, ///< The 3D view of the shoe is shown on the left
 		Insole = 1,
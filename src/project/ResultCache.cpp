@@ -0,0 +1,398 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ResultCache.cpp
+// Purpose            : Cache for the output objects of operations
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "ResultCache.h"
+
+#include "../3D/Archive.h"
+#include "../3D/MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <tuple>
+
+ResultCache::~ResultCache() {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stop = true;
+	}
+	cvPending.notify_all();
+	if (writer.joinable())
+		writer.join();
+}
+
+void ResultCache::SetBudget(size_t bytes) {
+	std::lock_guard<std::mutex> lock(mtx);
+	budget = bytes;
+	Evict();
+}
+
+size_t ResultCache::GetBudget() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return budget;
+}
+
+size_t ResultCache::GetMemoryUsage() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return usage;
+}
+
+size_t ResultCache::Size() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return entries.size();
+}
+
+void ResultCache::Clear() {
+	std::lock_guard<std::mutex> lock(mtx);
+	entries.clear();
+	index.clear();
+	usage = 0;
+}
+
+void ResultCache::SetDirectory(const std::string &directory_) {
+	if (!directory_.empty()) {
+		std::error_code ec;
+		std::filesystem::create_directories(
+				std::filesystem::path(directory_) / ArchiveWriter::GetFormat(),
+				ec);
+	}
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		directory = directory_;
+	}
+	Prune();
+}
+
+std::string ResultCache::GetDirectory() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return directory;
+}
+
+void ResultCache::SetDiskBudget(size_t bytes) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		diskBudget = bytes;
+	}
+	Prune();
+}
+
+size_t ResultCache::GetDiskBudget() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return diskBudget;
+}
+
+void ResultCache::Flush() {
+	std::unique_lock<std::mutex> lock(mtx);
+	cvWritten.wait(lock, [this] {
+		return pending.empty() && !writing;
+	});
+}
+
+bool ResultCache::Store(size_t key,
+		const std::vector<std::shared_ptr<Object>> &objects,
+		const std::string &persistentKey) {
+	if (key == 0 || objects.empty())
+		return false;
+	const bool persistent = !persistentKey.empty()
+			&& !GetDirectory().empty();
+	if (GetBudget() == 0 && !persistent)
+		return false;
+
+	// One copy serves the memory and the disk cache. It is never modified.
+	Entry entry;
+	entry.key = key;
+	entry.persistentKey = persistentKey;
+	for (const auto &obj : objects) {
+		if (!obj)
+			return false;
+		std::shared_ptr<const Object> temp = obj->Clone();
+		if (!temp)
+			return false;
+		entry.bytes += temp->GetMemoryUsage();
+		entry.objects.push_back(temp);
+	}
+
+	if (persistent) {
+		std::lock_guard<std::mutex> lock(mtx);
+		pending.push_back(entry);
+		if (!writer.joinable())
+			writer = std::thread(&ResultCache::WriteFiles, this);
+		cvPending.notify_one();
+	}
+	return StoreMemory(std::move(entry));
+}
+
+bool ResultCache::StoreMemory(Entry &&entry) {
+	std::lock_guard<std::mutex> lock(mtx);
+	if (budget == 0 || entry.bytes > budget)
+		return false;
+	const size_t key = entry.key;
+	auto it = index.find(key);
+	if (it != index.end()) {
+		usage -= it->second->bytes;
+		entries.erase(it->second);
+	}
+	usage += entry.bytes;
+	entries.push_front(std::move(entry));
+	index[key] = entries.begin();
+	Evict();
+	return true;
+}
+
+bool ResultCache::Restore(size_t key,
+		const std::vector<std::shared_ptr<Object>> &objects,
+		const std::string &persistentKey) {
+	std::vector<std::shared_ptr<const Object>> cached;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		auto it = index.find(key);
+		if (key != 0 && it != index.end()
+				&& it->second->objects.size() == objects.size()) {
+			entries.splice(entries.begin(), entries, it->second);
+			cached = it->second->objects;
+			hits++;
+		}
+		if (cached.empty() && !persistentKey.empty()) {
+			// Evicted from memory, but not yet written to disk
+			for (const Entry &entry : pending) {
+				if (entry.persistentKey == persistentKey
+						&& entry.objects.size() == objects.size()) {
+					cached = entry.objects;
+					hits++;
+					break;
+				}
+			}
+		}
+	}
+	if (!cached.empty()) {
+		// The cached objects are never modified, so they can be copied
+		// without holding the lock. An eviction in the meantime is no
+		// problem.
+		for (size_t n = 0; n < objects.size(); n++)
+			objects[n]->CopyFrom(*cached[n]);
+		return true;
+	}
+	if (key != 0 && !persistentKey.empty()
+			&& RestoreFile(persistentKey, objects)) {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			hits++;
+			diskHits++;
+		}
+		Store(key, objects);
+		return true;
+	}
+	std::lock_guard<std::mutex> lock(mtx);
+	misses++;
+	return false;
+}
+
+size_t ResultCache::GetHits() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return hits;
+}
+
+size_t ResultCache::GetMisses() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return misses;
+}
+
+size_t ResultCache::GetDiskHits() const {
+	std::lock_guard<std::mutex> lock(mtx);
+	return diskHits;
+}
+
+size_t ResultCache::UniqueHash() {
+	// Counting down from the top, to stay clear of small hash values.
+	static std::atomic<size_t> counter((size_t) -1);
+	return counter--;
+}
+
+void ResultCache::Evict() {
+	while (usage > budget && !entries.empty()) {
+		usage -= entries.back().bytes;
+		index.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+std::string ResultCache::GetFormatDirectory() const {
+	const std::string dir = GetDirectory();
+	if (dir.empty())
+		return std::string();
+	return (std::filesystem::path(dir) / ArchiveWriter::GetFormat()).string();
+}
+
+std::string ResultCache::GetFilename(const std::string &persistentKey) const {
+	const std::string dir = GetFormatDirectory();
+	if (dir.empty())
+		return std::string();
+	return (std::filesystem::path(dir) / (persistentKey + ".cache")).string();
+}
+
+void ResultCache::WriteFiles() {
+	std::unique_lock<std::mutex> lock(mtx);
+	while (true) {
+		cvPending.wait(lock, [this] {
+			return stop || !pending.empty();
+		});
+		// Pending files are still written, when the cache is destroyed.
+		if (pending.empty())
+			return;
+		Entry entry = std::move(pending.front());
+		pending.pop_front();
+		writing = true;
+		lock.unlock();
+		if (StoreFile(entry))
+			Prune();
+		entry.objects.clear();
+		lock.lock();
+		writing = false;
+		cvWritten.notify_all();
+	}
+}
+
+bool ResultCache::StoreFile(const Entry &entry) const {
+	const std::string filename = GetFilename(entry.persistentKey);
+	if (filename.empty())
+		return false;
+	std::error_code ec;
+	// The same key always has the same content.
+	if (std::filesystem::exists(filename, ec))
+		return false;
+
+	// Written under a temporary name and renamed afterwards, so that other
+	// processes using the same directory never see a partial file.
+	const std::string temp = filename + "."
+			+ std::to_string(std::random_device()()) + ".tmp";
+	bool success = true;
+	try {
+		std::ofstream out(temp, std::ios::binary);
+		ArchiveWriter archive(out);
+		archive.WriteHeader();
+		archive.WriteValue((uint64_t) entry.objects.size());
+		for (const auto &obj : entry.objects) {
+			if (!obj->Save(archive)) {
+				success = false;
+				break;
+			}
+		}
+		if (success)
+			archive.WriteChecksum();
+		out.close();
+		success &= !out.fail();
+	} catch (const std::exception&) {
+		success = false;
+	}
+	if (success) {
+		std::filesystem::rename(temp, filename, ec);
+		success = !ec;
+	}
+	if (!success)
+		std::filesystem::remove(temp, ec);
+	return success;
+}
+
+bool ResultCache::RestoreFile(const std::string &persistentKey,
+		const std::vector<std::shared_ptr<Object>> &objects) const {
+	const std::string filename = GetFilename(persistentKey);
+	if (filename.empty())
+		return false;
+	std::error_code ec;
+	if (!std::filesystem::exists(filename, ec))
+		return false;
+	bool valid = false;
+	bool damaged = false;
+	try {
+		MappedFile file(filename);
+		ArchiveReader archive(file.Data(), file.Size());
+		// A file of another format is left alone. It is not expected in the
+		// directory of this format.
+		if (!archive.ReadHeader())
+			return false;
+		valid = archive.ReadValue<uint64_t>() == objects.size();
+		for (const auto &obj : objects)
+			valid = valid && obj && obj->Load(archive);
+		valid = valid && archive.AtEnd();
+		damaged = !valid;
+	} catch (const std::exception&) {
+		damaged = true;
+	}
+	// Damaged files are removed, so that the next Store() writes them again.
+	// A used file is marked as recently used for Prune().
+	if (damaged)
+		std::filesystem::remove(filename, ec);
+	if (valid)
+		std::filesystem::last_write_time(filename,
+				std::filesystem::file_time_type::clock::now(), ec);
+	return valid;
+}
+
+void ResultCache::Prune() const {
+	const std::string dir = GetFormatDirectory();
+	const size_t limit = GetDiskBudget();
+	if (dir.empty())
+		return;
+	typedef std::filesystem::file_time_type Time;
+	// Temporary files are left over by a crash. Files being written by
+	// another process are younger than this.
+	const Time old = Time::clock::now() - std::chrono::hours(1);
+
+	std::vector<std::tuple<Time, size_t, std::filesystem::path>> files;
+	size_t total = 0;
+	std::error_code ec;
+	for (const auto &item : std::filesystem::directory_iterator(dir, ec)) {
+		if (!item.is_regular_file(ec))
+			continue;
+		const std::filesystem::path &path = item.path();
+		const Time time = item.last_write_time(ec);
+		if (ec)
+			continue;
+		if (path.extension() == ".tmp") {
+			if (time < old)
+				std::filesystem::remove(path, ec);
+			continue;
+		}
+		if (path.extension() != ".cache")
+			continue;
+		const size_t size = (size_t) item.file_size(ec);
+		if (ec)
+			continue;
+		files.emplace_back(time, size, path);
+		total += size;
+	}
+	if (total <= limit)
+		return;
+	std::sort(files.begin(), files.end());
+	for (const auto &file : files) {
+		if (total <= limit)
+			break;
+		if (std::filesystem::remove(std::get<2>(file), ec))
+			total -= std::get<1>(file);
+	}
+}
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ResultCache.h
+// Purpose            : Cache for the output objects of operations
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef SRC_PROJECT_RESULTCACHE_H_
+#define SRC_PROJECT_RESULTCACHE_H_
+
+/** \class ResultCache
+ * 	\code #include "ResultCache.h"\endcode
+ * 	\ingroup project
+ *  \brief Least-recently-used cache for the outputs of the Operation%s
+ *
+ * The key is the hash returned by Operation::GetHash(). It covers the
+ * parameters and the hashes of the input objects. The hashes of the input
+ * objects are in turn the keys of the operations that produced them. Thus
+ * toggling a parameter back to a previous value results in the same keys
+ * down the whole chain and all operations are restored from the cache.
+ *
+ * Only objects supporting Object::Clone() are stored. The cache keeps
+ * copies of the objects. The memory is limited by a budget; the least
+ * recently used entries are evicted first. A budget of 0 disables the cache.
+ *
+ * Store() and Restore() can be called from the worker threads of the
+ * Scheduler. The copying is done outside of the lock.
+ *
+ * Persistent entries are additionally written into a directory (see
+ * SetDirectory()), one file per Operation::GetPersistentKey(). The objects
+ * are written by Object::Save() in the format of ArchiveWriter. The files
+ * are placed in a subdirectory named by ArchiveWriter::GetFormat(), so
+ * builds with different formats can share the directory without removing
+ * each others files. After a restart of the
+ * program Restore() maps the file and reads the objects back. This skips the
+ * import of large meshes when a project is opened again.
+ *
+ * The files are written by a background thread from the copies taken by
+ * Store(), so the build does not wait for the disk. The total size of the
+ * files is limited by SetDiskBudget(). The least recently used files (by
+ * their modification time, which is updated on every read) are removed
+ * when the directory is set and after each write. Only the subdirectory of
+ * this format is pruned.
+ */
+
+#include "object/Object.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ResultCache {
+public:
+	ResultCache() = default;
+	ResultCache(const ResultCache&) = delete;
+	ResultCache& operator=(const ResultCache&) = delete;
+	virtual ~ResultCache(); ///< Waits for the pending files to be written.
+
+	void SetBudget(size_t bytes); ///< Memory budget in bytes
+	size_t GetBudget() const;
+	size_t GetMemoryUsage() const;
+	size_t Size() const; ///< Number of entries
+	void Clear(); ///< Remove the entries in memory. The files on disk are kept.
+
+	/**\brief Directory for the persistent entries
+	 *
+	 * The directory (and the subdirectory for the format) is created if
+	 * needed and pruned to the disk budget. An empty string (the default)
+	 * disables the disk cache.
+	 */
+	void SetDirectory(const std::string &directory);
+	std::string GetDirectory() const;
+	void SetDiskBudget(size_t bytes); ///< Limit for the files in the directory
+	size_t GetDiskBudget() const;
+	void Flush(); ///< Wait until all pending files are written.
+
+	/**\brief Store copies of the objects under the given key
+	 *
+	 * \param persistentKey If not empty, also write the objects into the
+	 *                      directory under this name, if all of them support
+	 *                      Object::Save(). The file is written later by the
+	 *                      background thread.
+	 * \return false, if an object does not support cloning or does not fit
+	 *         into the budget.
+	 */
+	bool Store(size_t key, const std::vector<std::shared_ptr<Object>> &objects,
+			const std::string &persistentKey = std::string());
+
+	/**\brief Copy the cached objects back into the given objects
+	 *
+	 * \param persistentKey Look for this name in the directory, if the key is
+	 *                      not in memory.
+	 * \return false, if there is no entry for the key.
+	 */
+	bool Restore(size_t key,
+			const std::vector<std::shared_ptr<Object>> &objects,
+			const std::string &persistentKey = std::string());
+
+	size_t GetHits() const; ///< Restored from memory or disk
+	size_t GetMisses() const;
+	size_t GetDiskHits() const; ///< Restored from disk
+
+	/**\brief Hash that is not used by anything else
+	 *
+	 * Assigned to objects, whose state cannot be described by a hash.
+	 */
+	static size_t UniqueHash();
+
+private:
+	struct Entry {
+		size_t key = 0;
+		std::string persistentKey; ///< Name of the file
+		std::vector<std::shared_ptr<const Object>> objects;
+		size_t bytes = 0;
+	};
+
+	void Evict();
+	bool StoreMemory(Entry &&entry);
+	void WriteFiles(); ///< Loop of the background thread
+	bool StoreFile(const Entry &entry) const;
+	bool RestoreFile(const std::string &persistentKey,
+			const std::vector<std::shared_ptr<Object>> &objects) const;
+	void Prune() const;
+	std::string GetFormatDirectory() const; ///< Empty, if disabled
+	std::string GetFilename(const std::string &persistentKey) const;
+
+	std::list<Entry> entries; ///< Front is the most recently used entry.
+	std::unordered_map<size_t, std::list<Entry>::iterator> index;
+
+	size_t budget = 512 * 1024 * 1024;
+	size_t usage = 0;
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t diskHits = 0;
+	std::string directory;
+	size_t diskBudget = (size_t) 4 * 1024 * 1024 * 1024;
+
+	std::list<Entry> pending; ///< Waiting for the background thread
+	bool writing = false; ///< The background thread writes a file.
+	bool stop = false;
+	std::thread writer;
+	std::condition_variable cvPending;
+	std::condition_variable cvWritten;
+	mutable std::mutex mtx;
+};
+
+#endif /* SRC_PROJECT_RESULTCACHE_H_ */
@@ -0,0 +1,454 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Scheduler.cpp
+// Purpose            : Dependency-aware execution of operations
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   : -lpthread
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "Scheduler.h"
+
+#include "../system/Cancellation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+Scheduler::Scheduler() {
+	SetThreads(0);
+}
+
+void Scheduler::SetThreads(size_t threads) {
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	this->threads = std::max<size_t>(threads, 1);
+}
+
+size_t Scheduler::GetThreads() const {
+	return threads;
+}
+
+void Scheduler::Setup(const std::vector<std::shared_ptr<Operation>> &operations) {
+	nodes.clear();
+	nodes.resize(operations.size());
+
+	std::unordered_map<const Object*, size_t> producer;
+	for (size_t n = 0; n < operations.size(); n++) {
+		nodes[n].op = operations[n];
+		for (const auto &obj : operations[n]->GetOutputs())
+			if (obj)
+				producer[obj.get()] = n;
+	}
+	for (size_t n = 0; n < operations.size(); n++) {
+		for (const auto &obj : operations[n]->GetInputs()) {
+			if (!obj)
+				continue;
+			auto it = producer.find(obj.get());
+			if (it == producer.end() || it->second == n)
+				continue;
+			const size_t m = it->second;
+			auto &pred = nodes[n].predecessors;
+			if (std::find(pred.begin(), pred.end(), m) != pred.end())
+				continue;
+			pred.push_back(m);
+			nodes[m].successors.push_back(n);
+		}
+	}
+	Sort();
+}
+
+void Scheduler::Sort() {
+	// Kahn's algorithm. Ties are resolved by the original index, so that the
+	// order is stable for independent operations.
+	order.clear();
+	order.reserve(nodes.size());
+	std::vector<size_t> inDegree(nodes.size());
+	std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+	for (size_t n = 0; n < nodes.size(); n++) {
+		inDegree[n] = nodes[n].predecessors.size();
+		if (inDegree[n] == 0)
+			ready.push(n);
+	}
+	while (!ready.empty()) {
+		const size_t n = ready.top();
+		ready.pop();
+		order.push_back(n);
+		for (size_t m : nodes[n].successors)
+			if (--inDegree[m] == 0)
+				ready.push(m);
+	}
+	acyclic = (order.size() == nodes.size());
+	if (!acyclic) {
+		std::cerr << "Scheduler::" << __FUNCTION__
+				<< " - The operations contain a cycle. Falling back to fixed-point iteration.\n";
+		order.clear();
+		for (size_t n = 0; n < nodes.size(); n++)
+			order.push_back(n);
+	}
+}
+
+size_t Scheduler::Size() const {
+	return nodes.size();
+}
+
+const std::vector<size_t>& Scheduler::GetPredecessors(size_t idx) const {
+	return nodes.at(idx).predecessors;
+}
+
+const std::vector<size_t>& Scheduler::GetSuccessors(size_t idx) const {
+	return nodes.at(idx).successors;
+}
+
+const std::vector<size_t>& Scheduler::GetOrder() const {
+	return order;
+}
+
+bool Scheduler::IsAcyclic() const {
+	return acyclic;
+}
+
+void Scheduler::ResetStatistics() {
+	statistics = Statistics();
+}
+
+const Scheduler::Statistics& Scheduler::GetStatistics() const {
+	return statistics;
+}
+
+bool Scheduler::Propagate() {
+	if (!acyclic)
+		return PropagateFixedPoint();
+
+	std::vector<bool> modified(nodes.size(), false);
+	size_t calls = 0;
+
+	// Forward: The valid-flags only depend on the predecessors.
+	for (size_t n : order) {
+		modified[n] = nodes[n].op->Propagate();
+		calls++;
+	}
+	// Backward: The needed-flags of the outputs can only have been changed
+	// by a successor.
+	for (auto it = order.rbegin(); it != order.rend(); ++it) {
+		const size_t n = *it;
+		const auto &succ = nodes[n].successors;
+		if (std::none_of(succ.begin(), succ.end(), [&modified](size_t m) {
+			return modified[m];
+		}))
+			continue;
+		if (nodes[n].op->Propagate())
+			modified[n] = true;
+		calls++;
+	}
+
+	const size_t callsFixedPoint = nodes.size()
+			* FixedPointPasses(modified, false);
+	statistics.propagateCalls += calls;
+	if (callsFixedPoint > calls)
+		statistics.propagateCallsSaved += callsFixedPoint - calls;
+
+	return std::any_of(modified.begin(), modified.end(), [](bool m) {
+		return m;
+	});
+}
+
+bool Scheduler::PropagateFixedPoint() {
+	bool modified = false;
+	bool propagation_complete = false;
+	while (!propagation_complete) {
+		propagation_complete = true;
+		for (auto &node : nodes) {
+			const bool m = node.op->Propagate();
+			statistics.propagateCalls++;
+			propagation_complete &= !m;
+			modified |= m;
+		}
+	}
+	return modified;
+}
+
+size_t Scheduler::FixedPointPasses(const std::vector<bool> &flags,
+		bool forward) const {
+	std::vector<size_t> pass(nodes.size(), 0);
+	size_t maxPass = 0;
+	for (size_t n : order) {
+		if (!flags[n])
+			continue;
+		pass[n] = 1;
+		for (size_t m : nodes[n].predecessors)
+			if (flags[m])
+				pass[n] = std::max(pass[n], pass[m] + ((m > n) ? 1 : 0));
+		maxPass = std::max(maxPass, pass[n]);
+	}
+	if (!forward) {
+		for (auto it = order.rbegin(); it != order.rend(); ++it) {
+			const size_t n = *it;
+			if (!flags[n])
+				continue;
+			for (size_t m : nodes[n].successors)
+				if (flags[m])
+					pass[n] = std::max(pass[n], pass[m] + ((m > n) ? 1 : 0));
+			maxPass = std::max(maxPass, pass[n]);
+		}
+	}
+	return maxPass + 1;
+}
+
+size_t Scheduler::Run() {
+	const auto t0 = std::chrono::steady_clock::now();
+	const double cpu0 = BuildProfile::ProcessCPUSeconds();
+	const bool singleThreaded = (threads <= 1 || !acyclic);
+	profile.BeginBuild(singleThreaded ? 1 : threads);
+	size_t count;
+	if (singleThreaded)
+		count = RunSingleThreaded();
+	else
+		count = RunMultiThreaded();
+	statistics.runCalls += count;
+	profile.EndBuild(
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(),
+			BuildProfile::ProcessCPUSeconds() - cpu0);
+	return count;
+}
+
+void Scheduler::Cancel() {
+	cancel = true;
+}
+
+void Scheduler::ClearCancel() {
+	cancel = false;
+}
+
+bool Scheduler::IsCancelled() const {
+	return cancel;
+}
+
+ResultCache& Scheduler::GetCache() {
+	return cache;
+}
+
+BuildProfile& Scheduler::GetProfile() {
+	return profile;
+}
+
+bool Scheduler::Execute(size_t idx) {
+	Operation &op = *(nodes[idx].op);
+	Cancellation::Scope scope(&cancel);
+	const auto t0 = std::chrono::steady_clock::now();
+	const double cpu0 = BuildProfile::ThreadCPUSeconds();
+	const size_t key = op.GetHash();
+	const std::string persistentKey = op.GetPersistentKey();
+	const auto outputs = op.GetOutputs();
+	bool cached = false;
+	if (key != 0 && cache.Restore(key, outputs, persistentKey)) {
+		op.RunCached();
+		for (const auto &obj : outputs) {
+			obj->MarkValid(true);
+			obj->MarkNeeded(false);
+		}
+		cached = true;
+	} else {
+		op.Run();
+		if (key != 0
+				&& std::all_of(outputs.begin(), outputs.end(),
+						[](const std::shared_ptr<Object> &obj) {
+							return obj && obj->IsValid();
+						}))
+			cache.Store(key, outputs, persistentKey);
+	}
+	// Objects depending on an unknown state get a hash, that never matches.
+	for (size_t n = 0; n < outputs.size(); n++) {
+		if (!outputs[n])
+			continue;
+		if (key == 0)
+			outputs[n]->SetHash(ResultCache::UniqueHash());
+		else
+			outputs[n]->SetHash(Operation::HashCombine(key, n));
+	}
+
+	size_t bytes = 0;
+	for (const auto &obj : outputs)
+		if (obj)
+			bytes += obj->GetMemoryUsage();
+	profile.Record(op.GetName(),
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(),
+			BuildProfile::ThreadCPUSeconds() - cpu0, bytes, cached);
+	return cached;
+}
+
+size_t Scheduler::RunSingleThreaded() {
+	std::vector<bool> ran(nodes.size(), false);
+	size_t count = 0;
+	size_t calls = 0;
+	bool operations_complete = false;
+	while (!operations_complete) {
+		operations_complete = true;
+		for (size_t n : order) {
+			if (cancel)
+				throw Cancellation::Exception();
+			calls++;
+			if (nodes[n].op->HasToRun() && nodes[n].op->CanRun()) {
+				DEBUGOUT << "-> running: " << nodes[n].op->GetName() << "\n";
+				if (Execute(n))
+					statistics.cacheHits++;
+				ran[n] = true;
+				count++;
+				operations_complete = false;
+			}
+		}
+		// In topological order a single pass is sufficient.
+		if (acyclic)
+			break;
+	}
+	statistics.hasToRunCalls += calls;
+	if (acyclic) {
+		const size_t callsFixedPoint = nodes.size()
+				* FixedPointPasses(ran, true);
+		if (callsFixedPoint > calls)
+			statistics.hasToRunCallsSaved += callsFixedPoint - calls;
+	}
+	return count;
+}
+
+size_t Scheduler::RunMultiThreaded() {
+	std::mutex mtx;
+	std::condition_variable cvWork;
+	std::condition_variable cvDone;
+	std::deque<size_t> queue;
+	std::deque<size_t> done;
+	std::vector<bool> busy(nodes.size(), false);
+	std::vector<bool> ran(nodes.size(), false);
+	size_t active = 0;
+	size_t count = 0;
+	size_t calls = 0;
+	bool stop = false;
+	std::exception_ptr exception;
+
+	auto worker = [&]() {
+		std::unique_lock<std::mutex> lock(mtx);
+		while (true) {
+			cvWork.wait(lock, [&] {
+				return stop || !queue.empty();
+			});
+			if (queue.empty())
+				return;
+			const size_t idx = queue.front();
+			queue.pop_front();
+			lock.unlock();
+			std::exception_ptr ex;
+			bool cached = false;
+			try {
+				cached = Execute(idx);
+			} catch (...) {
+				ex = std::current_exception();
+			}
+			lock.lock();
+			if (ex && !exception)
+				exception = ex;
+			if (cached)
+				statistics.cacheHits++;
+			busy[idx] = false;
+			active--;
+			count++;
+			done.push_back(idx);
+			cvDone.notify_one();
+		}
+	};
+
+	std::vector<std::thread> pool;
+	const size_t poolSize = std::min(threads, nodes.size());
+	for (size_t n = 0; n < poolSize; n++)
+		pool.emplace_back(worker);
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		// At the start every operation is a candidate. Later only the
+		// successors of finished operations can become ready.
+		std::vector<size_t> candidates = order;
+		while (true) {
+			// An operation is only tested, if none of its predecessors is
+			// running. Otherwise its input objects might be written to while
+			// reading the valid-flags.
+			if (cancel && !exception)
+				exception = std::make_exception_ptr(Cancellation::Exception());
+			if (!exception) {
+				try {
+					for (size_t n : candidates) {
+						if (busy[n])
+							continue;
+						const auto &pred = nodes[n].predecessors;
+						if (std::any_of(pred.begin(), pred.end(),
+								[&busy](size_t m) {
+									return busy[m];
+								}))
+							continue;
+						calls++;
+						if (nodes[n].op->HasToRun() && nodes[n].op->CanRun()) {
+							DEBUGOUT << "-> running: " << nodes[n].op->GetName()
+									<< "\n";
+							busy[n] = true;
+							ran[n] = true;
+							active++;
+							queue.push_back(n);
+						}
+					}
+				} catch (...) {
+					exception = std::current_exception();
+				}
+				cvWork.notify_all();
+			}
+			if (active == 0)
+				break;
+			cvDone.wait(lock, [&] {
+				return !done.empty();
+			});
+			candidates.clear();
+			while (!done.empty()) {
+				for (size_t m : nodes[done.front()].successors)
+					if (std::find(candidates.begin(), candidates.end(), m)
+							== candidates.end())
+						candidates.push_back(m);
+				done.pop_front();
+			}
+		}
+		stop = true;
+	}
+	cvWork.notify_all();
+	for (auto &th : pool)
+		th.join();
+
+	statistics.hasToRunCalls += calls;
+	const size_t callsFixedPoint = nodes.size() * FixedPointPasses(ran, true);
+	if (callsFixedPoint > calls)
+		statistics.hasToRunCallsSaved += callsFixedPoint - calls;
+
+	if (exception)
+		std::rethrow_exception(exception);
+	return count;
+}
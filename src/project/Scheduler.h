@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Scheduler.h
+// Purpose            : Dependency-aware execution of operations
+// Thread Safe        : No
+// Platform dependent : No
+// Compiler Options   : -lpthread
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef SRC_PROJECT_SCHEDULER_H_
+#define SRC_PROJECT_SCHEDULER_H_
+
+/** \class Scheduler
+ * 	\code #include "Scheduler.h"\endcode
+ * 	\ingroup project
+ *  \brief Run the operations of the Builder along their dependency graph.
+ *
+ * The graph is derived from the in- and outputs of the Operation%s: If an
+ * output object of one operation is the input object of another operation,
+ * the second one depends on the first one.
+ *
+ * The graph is sorted topologically once in Setup(). Propagate() then needs
+ * only a single forward sweep for the valid-flags and a single backward sweep
+ * for the needed-flags, instead of looping over all operations until nothing
+ * changes. Only if the graph contains a cycle, the fixed-point loops are used.
+ *
+ * In multi-threaded mode all operations that have to run and whose
+ * predecessors are idle are handed to a pool of worker threads. Independent
+ * chains (e.g. last and heel) are thereby calculated concurrently. After an
+ * operation has finished, only its successors are checked.
+ *
+ * With a single thread the operations are run in the calling thread in
+ * topological order. This is deterministic and meant for debugging.
+ *
+ * The Statistics count the calls to Operation::Propagate() and
+ * Operation::HasToRun() of the last update. The number of saved calls is
+ * calculated by replaying the modifications on the fixed-point loops over
+ * the operations in the order passed to Setup().
+ *
+ * Operations that share an input object must only read from it, unless one
+ * of them depends (transitively) on the other.
+ *
+ * Before an operation is run, its hash is looked up in the ResultCache. On a
+ * hit the outputs are copied from the cache and Operation::RunCached() is
+ * called instead of Operation::Run(). Either way the outputs get a hash
+ * derived from the hash of the operation.
+ *
+ * Every call to Run() is recorded in the BuildProfile.
+ *
+ * A running build can be cancelled from another thread with Cancel(). No
+ * further operations are started, and the running operations are stopped at
+ * their next Cancellation::Check(). Run() then throws a
+ * Cancellation::Exception. The outputs of the aborted operations stay
+ * invalid and are recalculated by the next build.
+ *
+ * Exceptions thrown by Operation::Run() are collected. After all running
+ * operations have finished, the first exception is rethrown in the calling
+ * thread.
+ */
+
+#include "operation/Operation.h"
+#include "BuildProfile.h"
+#include "ResultCache.h"
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <vector>
+
+class Scheduler {
+public:
+	Scheduler();
+	virtual ~Scheduler() = default;
+
+	/**\brief Set the number of worker threads
+	 *
+	 * \param threads Number of threads. 0 selects the number of hardware
+	 *                threads, 1 selects the single-threaded debugging mode.
+	 */
+	void SetThreads(size_t threads);
+	size_t GetThreads() const;
+
+	/**\brief Build the dependency graph from the connected operations
+	 *
+	 * Has to be called again after the operations were reconnected.
+	 */
+	void Setup(const std::vector<std::shared_ptr<Operation>> &operations);
+
+	size_t Size() const;
+	const std::vector<size_t>& GetPredecessors(size_t idx) const;
+	const std::vector<size_t>& GetSuccessors(size_t idx) const;
+	const std::vector<size_t>& GetOrder() const; ///< Indices in topological order
+	bool IsAcyclic() const;
+
+	/**\brief Propagate the needed- and valid-flags through the graph
+	 *
+	 * \return true, if some flag was modified.
+	 */
+	bool Propagate();
+
+	/**\brief Run all operations that have to run
+	 *
+	 * \return Number of Operation::Run() calls.
+	 */
+	size_t Run();
+
+	/**\brief Request the cancellation of a running build
+	 *
+	 * Can be called from any thread. The request stays active until
+	 * ClearCancel() is called. Run() is cancelled right away, if it is
+	 * called while the request is active.
+	 */
+	void Cancel();
+	void ClearCancel();
+	bool IsCancelled() const;
+
+	ResultCache& GetCache();
+	BuildProfile& GetProfile();
+
+	struct Statistics {
+		size_t propagateCalls = 0;
+		size_t propagateCallsSaved = 0;
+		size_t hasToRunCalls = 0;
+		size_t hasToRunCallsSaved = 0;
+		size_t runCalls = 0;
+		size_t cacheHits = 0;
+	};
+	void ResetStatistics();
+	const Statistics& GetStatistics() const;
+
+private:
+	void Sort();
+	bool PropagateFixedPoint();
+	size_t RunSingleThreaded();
+	size_t RunMultiThreaded();
+
+	/**\brief Run a single operation or restore its outputs from the cache
+	 *
+	 * \return true, if the outputs were restored from the cache.
+	 */
+	bool Execute(size_t idx);
+
+	/**\brief Passes the fixed-point loops would have needed
+	 *
+	 * An operation influenced by a neighbor that comes later in the order of
+	 * Setup() is only reached in the next pass. The last pass is the one,
+	 * where nothing happens anymore.
+	 *
+	 * \param flags Operations, that have modified something or have run.
+	 * \param forward Follow the predecessors (true) or also the successors.
+	 */
+	size_t FixedPointPasses(const std::vector<bool> &flags, bool forward) const;
+
+	struct Node {
+		std::shared_ptr<Operation> op;
+		std::vector<size_t> predecessors;
+		std::vector<size_t> successors;
+	};
+	std::vector<Node> nodes;
+	std::vector<size_t> order;
+	bool acyclic = true;
+	size_t threads = 1;
+	std::atomic<bool> cancel = false;
+	Statistics statistics;
+	ResultCache cache;
+	BuildProfile profile;
+};
+
+#endif /* SRC_PROJECT_SCHEDULER_H_ */
@@ -29,6 +29,8 @@
 
 #include "../Config.h"
 
+#include <exception>
+
 wxDEFINE_EVENT(wxEVT_COMMAND_THREAD_COMPLETED, wxThreadEvent);
 wxDEFINE_EVENT(wxEVT_COMMAND_THREAD_UPDATE, wxThreadEvent);
 
@@ -41,7 +43,7 @@ WorkerThread::WorkerThread(Project * project, size_t threadNr)
 WorkerThread::~WorkerThread()
 {
 	if(project != nullptr){
-		wxCriticalSectionLocker enter(project->CS);
+		wxMutexLocker enter(project->CS);
 		switch(threadNr){
 		case 0:
 			project->thread0 = nullptr;
@@ -50,21 +52,24 @@ WorkerThread::~WorkerThread()
 			project->thread1 = nullptr;
 			break;
 		}
+		project->threadEnded.Broadcast();
 	}
 }
 
 wxThread::ExitCode WorkerThread::Entry()
 {
-	if(threadNr >= 2) return (wxThread::ExitCode) 1;
+	if(threadNr != 0) return (wxThread::ExitCode) 1;
 
 	if(TestDestroy()) return (wxThread::ExitCode) 2;
-	bool flag = true;
-	while(flag && !TestDestroy()){
-//		if(threadNr == 0) flag = project->UpdateLeft();
-//		if(threadNr == 1) flag = project->UpdateRight();
-		wxQueueEvent(project, new wxThreadEvent(wxEVT_COMMAND_THREAD_UPDATE));
+	bool completed = false;
+	try{
+		completed = project->builder.Execute();
+	}catch(const std::exception &ex){
+		project->builder.error = ex.what();
+		completed = true;
 	}
-	wxQueueEvent(project, new wxThreadEvent(wxEVT_COMMAND_THREAD_COMPLETED));
+	if(completed)
+		wxQueueEvent(project, new wxThreadEvent(wxEVT_COMMAND_THREAD_COMPLETED));
 	DEBUGOUT << "Thread" << threadNr << " exit.\n";
 	return (wxThread::ExitCode) 0;
 }
@@ -28,9 +28,12 @@
 #define WORKERTHREAD_H
 
 /*!\class WorkerThread
- * \brief Thread for the loadheavy calculation of the volume
+ * \brief Thread for the loadheavy calculations of the Builder
  *
- * This thread inscribes the volume with the bones of the foot.
+ * Thread 0 runs Builder::Execute() after Project::Update() has prepared the
+ * build. When the build has finished, a wxEVT_COMMAND_THREAD_COMPLETED event
+ * is sent to the Project. A cancelled build sends no event, because a new
+ * build is started right away.
  */
 
 #include <stddef.h>
@@ -38,6 +38,7 @@ CommandConfigSetEnum::CommandConfigSetEnum(const wxString &name,
 
 bool CommandConfigSetEnum::Do() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
+	project->StopBuild();
 
 	switch (parameter) {
 	case ID_MEASUREMENTSOURCE:
@@ -80,6 +81,7 @@ bool CommandConfigSetEnum::Do() {
 
 bool CommandConfigSetEnum::Undo() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
+	project->StopBuild();
 
 	switch (parameter) {
 
@@ -62,6 +62,7 @@ bool CommandConfigSetParameter::Do() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 
 	ParameterEvaluator &params = project->evaluator;
 	params.Reset();
@@ -93,6 +94,7 @@ bool CommandConfigSetParameter::Undo() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 
 	ParameterEvaluator &params = project->evaluator;
 	params.Reset();
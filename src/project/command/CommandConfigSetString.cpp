@@ -39,6 +39,7 @@ bool CommandConfigSetString::Do() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 	bool modified = false;
 
 	std::shared_ptr<ParameterString> param;
@@ -56,6 +57,7 @@ bool CommandConfigSetString::Undo() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 
 	std::shared_ptr<ParameterString> param;
 	GetParam(param);
@@ -38,6 +38,7 @@ bool CommandFootMeasurementSet::Do() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 
 	bool hasChanged = false;
 
@@ -63,6 +64,7 @@ bool CommandFootMeasurementSet::Undo() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 
 	bool hasChanged = false;
 	if (active == ProjectView::Side::Left
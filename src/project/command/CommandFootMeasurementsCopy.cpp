@@ -40,6 +40,7 @@ bool CommandFootMeasurementsCopy::Do() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 	if (toSide == ProjectView::Side::Left) {
 		oldValue = project->footL;
 		project->footL = project->footR;
@@ -57,6 +58,7 @@ bool CommandFootMeasurementsCopy::Undo() {
 	DEBUGOUT << __FUNCTION__ << ": " << __FILE__ << "\n";
 	if (project == NULL)
 		return false;
+	project->StopBuild();
 
 	if (toSide == ProjectView::Side::Left) {
 		project->footL = oldValue;
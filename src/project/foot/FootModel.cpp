@@ -568,16 +568,16 @@ void FootModel::CalculateSkin() {
 						bone->p2.z + bone->r2 + 0 * bone->s2));
 	}
 
-	const double cellvol = bb.GetVolume() / 50000.0;
+	// The resolution is set for 3.2 million cells in the bounding box. Only the
+	// bricks near the surface of the skin use memory.
+	const double cellvol = bb.GetVolume() / (50000.0 * 64.0);
 	const double res = cbrt(cellvol);
-	skin.SetExtent(bb.GetSizeX(), bb.GetSizeY(), bb.GetSizeZ(), res);
-	skin.SetOrigin(Vector3(bb.xmin, bb.ymin, bb.zmin));
+	skin.SetGrid(Vector3(bb.xmin, bb.ymin, bb.zmin), res);
 	//	volume.AddHalfplane(Vector3(0, 0, 1), -0.10, 0.01);
 	//	volume.AddSphere(Vector3(0, 0.1, 0), 0.15, 0.1);
 	//	volume.AddSphere(Vector3(0.13, 0, 0.0), 0.19, 0.01);
 	//	volume.AddCylinder(Vector3(0.0, 0, 0.0), Vector3(0.05 * 1, 0, -0.00), 0.04,
 	//			0.04, 0.02, 0.04);
-	skin.Clear();
 
 	for (auto &bone : bones) {
 		skin.AddCylinder(bone->p1, bone->p2, bone->r1 + bone->s1,
@@ -93,7 +93,7 @@
 
 #include "../../3D/AffineTransformMatrix.h"
 #include "../../3D/BoundingBox.h"
-#include "../../3D/Volume.h"
+#include "../../3D/SparseVolume.h"
 #include "../../math/NelderMeadOptimizer.h"
 #include "../object/Object.h"
 //#include "../FootMeasurements.h"
@@ -136,7 +136,7 @@ public:
 	AffineTransformMatrix origin; //!< Origin for drawing. The origin of the model is the ankle.
 
 	BoundingBox bounds;
-	Volume skin;
+	SparseVolume skin;
 
 	std::string filename;
 
@@ -106,6 +106,19 @@ void Insole::Line::Paint() const {
 	glEnd();
 }
 
+std::shared_ptr<Object> Insole::Clone() const {
+	return std::make_shared<Insole>(*this);
+}
+
+void Insole::CopyFrom(const Object &other) {
+	*this = dynamic_cast<const Insole&>(other);
+}
+
+size_t Insole::GetMemoryUsage() const {
+	return Geometry::GetMemoryUsage() + outline.GetMemoryUsage()
+			+ lines.capacity() * sizeof(Line);
+}
+
 void Insole::Transform(const AffineTransformMatrix &m) {
 	A.Transform(m);
 	B.Transform(m);
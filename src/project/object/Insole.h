@@ -102,6 +102,10 @@ protected:
 	};
 
 public:
+	virtual std::shared_ptr<Object> Clone() const override;
+	virtual void CopyFrom(const Object &other) override;
+	virtual size_t GetMemoryUsage() const override;
+
 	/**\brief Transform the insole using a transform matrix.
 	 *
 	 * Has the advantage, that the normal vectors are transformed correctly.
@@ -125,7 +129,7 @@ public:
 	 *
 	 * 2D Painting is happening inside CanvasInsole.
 	 */
-	void Paint() const;
+	virtual void Paint() const override;
 
 private:
 	void ToOpenGL(const Point &p, const std::string &label) const;
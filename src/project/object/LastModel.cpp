@@ -906,12 +906,30 @@ LastModel::LastModel(const Geometry &geo) :
 		ObjectGeometry(geo) {
 }
 
+std::shared_ptr<Object> LastModel::Clone() const {
+	return std::make_shared<LastModel>(*this);
+}
+
+void LastModel::CopyFrom(const Object &other) {
+	*this = dynamic_cast<const LastModel&>(other);
+}
+
+size_t LastModel::GetMemoryUsage() const {
+	return ObjectGeometry::GetMemoryUsage() + planeXZ.GetMemoryUsage()
+			+ bottomleft.GetMemoryUsage() + bottomright.GetMemoryUsage()
+			+ bottom.GetMemoryUsage() + top.GetMemoryUsage()
+			+ HeelGirth.GetMemoryUsage() + WaistGirth.GetMemoryUsage()
+			+ LittleToeGirth.GetMemoryUsage() + BigToeGirth.GetMemoryUsage()
+			+ scalevalues.capacity() * sizeof(double);
+}
+
 void LastModel::Transform(std::function<Vector3(Vector3)> func) {
 	for (auto &p : tg.p)
 		p = func(p);
 
 	for (size_t n = 0; n < CountVertices(); n++)
 		v[n] = func(v[n]);
+	InvalidateCache();
 }
 
 void LastModel::Mirror() {
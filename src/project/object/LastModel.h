@@ -65,6 +65,10 @@ public:
 	LastModel(const Geometry &geo);
 	virtual ~LastModel() = default;
 
+	virtual std::shared_ptr<Object> Clone() const override;
+	virtual void CopyFrom(const Object &other) override;
+	virtual size_t GetMemoryUsage() const override;
+
 	void Transform(std::function<Vector3(Vector3)> func);
 	void Mirror();
 
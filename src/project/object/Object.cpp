@@ -25,6 +25,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Object.h"
 
+#include <stdexcept>
+
 void Object::MarkNeeded(bool needed_) {
 	needed = needed_;
 }
@@ -40,3 +42,32 @@ void Object::MarkValid(bool valid_) {
 bool Object::IsValid() const {
 	return valid;
 }
+
+void Object::SetHash(size_t hash_) {
+	hash = hash_;
+}
+
+size_t Object::GetHash() const {
+	return hash;
+}
+
+std::shared_ptr<Object> Object::Clone() const {
+	return nullptr;
+}
+
+void Object::CopyFrom(const Object &/*other*/) {
+	throw std::logic_error(
+			"Object::CopyFrom - This object does not support copying.");
+}
+
+size_t Object::GetMemoryUsage() const {
+	return 0;
+}
+
+bool Object::Save(ArchiveWriter &/*archive*/) const {
+	return false;
+}
+
+bool Object::Load(ArchiveReader &/*archive*/) {
+	return false;
+}
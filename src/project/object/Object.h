@@ -40,6 +40,12 @@
  * impede the ordering of member variables in memory.
  */
 
+#include <cstddef>
+#include <memory>
+
+class ArchiveReader;
+class ArchiveWriter;
+
 class Object {
 public:
 	Object() = default;
@@ -51,9 +57,41 @@ public:
 	void MarkValid(bool valid_);
 	bool IsValid() const;
 
+	/**\brief Hash of the state this object was calculated from
+	 *
+	 * Set by the Scheduler after the producing Operation has run. Operations
+	 * further down the chain include this hash into their own hash. 0 means
+	 * unknown, e.g. for objects not produced by an Operation.
+	 */
+	void SetHash(size_t hash_);
+	size_t GetHash() const;
+
+	/**\name Support for the ResultCache
+	 *
+	 * Objects not overriding these functions are never cached.
+	 * \{
+	 */
+	virtual std::shared_ptr<Object> Clone() const; ///< Deep copy or nullptr, if not supported.
+	virtual void CopyFrom(const Object &other); ///< Assign a clone back to this object.
+	virtual size_t GetMemoryUsage() const; ///< Approximate size in bytes.
+	/**\}
+	 */
+
+	/**\name Support for the disk cache of the ResultCache
+	 *
+	 * Objects not overriding these functions are only cached in memory. The
+	 * flags and the hash are not saved.
+	 * \{
+	 */
+	virtual bool Save(ArchiveWriter &archive) const; ///< Write the state, false if not supported.
+	virtual bool Load(ArchiveReader &archive); ///< Read the state written by Save(), false if not supported.
+	/**\}
+	 */
+
 private:
 	bool needed = false;
 	bool valid = false;
+	size_t hash = 0;
 };
 
 #endif /* OBJECT_OBJECT_H */
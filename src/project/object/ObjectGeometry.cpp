@@ -26,6 +26,9 @@
 
 #include "ObjectGeometry.h"
 
+#include "../../3D/Archive.h"
+#include "../../3D/OpenGL.h"
+
 #include <sstream>
 #include <stdexcept>
 
@@ -37,10 +40,47 @@ ObjectGeometry::ObjectGeometry(const Geometry &&other) :
 		Geometry(std::move(other)) {
 }
 
+std::shared_ptr<Object> ObjectGeometry::Clone() const {
+	return std::make_shared<ObjectGeometry>(*this);
+}
+
+void ObjectGeometry::CopyFrom(const Object &other) {
+	*this = dynamic_cast<const ObjectGeometry&>(other);
+}
+
+size_t ObjectGeometry::GetMemoryUsage() const {
+	return Geometry::GetMemoryUsage() + sizeof(BoundingBox)
+			+ (compact ? compact->GetMemoryUsage() : 0);
+}
+
+bool ObjectGeometry::Save(ArchiveWriter &archive) const {
+	archive.WriteGeometry(*this);
+	archive.WriteValue(BB);
+	archive.WriteValue((uint8_t) (compact ? 1 : 0));
+	if (compact)
+		archive.WriteMesh(*compact);
+	return true;
+}
+
+bool ObjectGeometry::Load(ArchiveReader &archive) {
+	archive.ReadGeometry(*this);
+	BB = archive.ReadValue<BoundingBox>();
+	compact.reset();
+	if (archive.ReadValue<uint8_t>() != 0) {
+		FloatMesh mesh;
+		archive.ReadMesh(mesh);
+		compact = std::make_shared<const FloatMesh>(std::move(mesh));
+	}
+	return true;
+}
+
 void ObjectGeometry::UpdateBoundingBox() {
 	BB.Empty();
 	for (size_t i = 0; i < CountVertices(); i++)
 		BB.Insert(v[i]);
+	if (compact)
+		for (size_t i = 0; i < compact->CountVertices(); i++)
+			BB.Insert(compact->GetVertex(i));
 }
 
 void ObjectGeometry::SelectFacesCloseTo(const Vector3 &vect) {
@@ -71,3 +111,44 @@ void ObjectGeometry::SelectFacesCloseTo(const Vector3 &vect) {
 	UnselectAll();
 	SelectByGroup(it->first);
 }
+
+void ObjectGeometry::Compact() {
+	FloatMesh mesh;
+	mesh.Assign(*this);
+	Compact(std::move(mesh));
+}
+
+void ObjectGeometry::Compact(FloatMesh &&mesh) {
+	// Geometry::Clear() resets the name and the matrix.
+	const std::string tempName = name;
+	const AffineTransformMatrix tempMatrix = matrix;
+	Clear();
+	name = tempName;
+	matrix = tempMatrix;
+	mesh.Shrink();
+	compact = std::make_shared<const FloatMesh>(std::move(mesh));
+}
+
+void ObjectGeometry::Expand() {
+	if (!compact)
+		return;
+	std::shared_ptr<const FloatMesh> temp = compact;
+	compact.reset();
+	temp->CopyTo(*this);
+	CalculateNormals();
+}
+
+bool ObjectGeometry::IsCompact() const {
+	return (bool) compact;
+}
+
+void ObjectGeometry::Paint() const {
+	if (!compact) {
+		Geometry::Paint();
+		return;
+	}
+	glPushMatrix();
+	matrix.GLMultMatrix();
+	compact->Paint();
+	glPopMatrix();
+}
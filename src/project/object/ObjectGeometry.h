@@ -32,12 +32,20 @@
  *  \brief Stored a geometry together with modification flags
  *
  * Overloaded Geometry with additional modification flag.
+ *
+ * Large meshes, that are only kept as input for other operations, can be
+ * stored in single precision (Compact()). The Geometry itself is empty then.
+ * Operations, that calculate with the data, call Expand() on their copy
+ * first.
  */
 
 #include "../../3D/BoundingBox.h"
+#include "../../3D/FloatMesh.h"
 #include "../../3D/Geometry.h"
 #include "Object.h"
 
+#include <memory>
+
 class ObjectGeometry: public Geometry, public Object {
 public:
 	ObjectGeometry() = default;
@@ -45,12 +53,30 @@ public:
 	ObjectGeometry(const Geometry &&other);
 	virtual ~ObjectGeometry() = default;
 
+	virtual std::shared_ptr<Object> Clone() const override;
+	virtual void CopyFrom(const Object &other) override;
+	virtual size_t GetMemoryUsage() const override;
+	virtual bool Save(ArchiveWriter &archive) const override;
+	virtual bool Load(ArchiveReader &archive) override;
+
 public:
 	void UpdateBoundingBox();
 	void SelectFacesCloseTo(const Vector3 &normalVector);
 
+	/**\brief Move the vertices and triangles into a FloatMesh
+	 */
+	void Compact();
+	void Compact(FloatMesh &&mesh); ///< Replace the geometry by a FloatMesh.
+	void Expand(); ///< Copy the FloatMesh back into the Geometry in double precision.
+	bool IsCompact() const;
+
+	virtual void Paint() const override; ///< Paints the FloatMesh, if compact.
+
 public:
 	BoundingBox BB;
+
+private:
+	std::shared_ptr<const FloatMesh> compact; ///< Shared by copies, never modified.
 };
 
 #endif /* OBJECT_OBJECTGEOMETRY_H */
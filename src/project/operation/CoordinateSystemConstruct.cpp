@@ -38,6 +38,22 @@ std::string CoordinateSystemConstruct::GetName() const {
 	return "CoordinateSystemConstruct";
 }
 
+std::vector<std::shared_ptr<Object>> CoordinateSystemConstruct::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> CoordinateSystemConstruct::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> CoordinateSystemConstruct::GetParameters() const {
+	return { belowCrotchGirth, belowCrotchLevel, middleOfThighGirth,
+			middleOfThighLevel, aboveKneeGirth, aboveKneeLevel,
+			overKneeCapGirth, overKneeCapLevel, belowKneeGirth, belowKneeLevel,
+			middleOfShankGirth, middleOfShankLevel, aboveAnkleGirth,
+			aboveAnkleLevel, overAnkleBoneGirth, overAnkleBoneLevel };
+}
+
 bool CoordinateSystemConstruct::CanRun() {
 	std::string missing;
 
@@ -43,12 +43,16 @@
 #include "../ParameterFormula.h"
 
 #include <memory>
+#include <vector>
 class CoordinateSystemConstruct: public Operation {
 public:
 	CoordinateSystemConstruct();
 	virtual ~CoordinateSystemConstruct() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
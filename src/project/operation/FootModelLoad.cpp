@@ -25,6 +25,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "FootModelLoad.h"
 
+#include <system_error>
+
 FootModelLoad::FootModelLoad() {
 	out = std::make_shared<FootModel>();
 }
@@ -33,6 +35,31 @@ std::string FootModelLoad::GetName() const {
 	return "FootModelLoad";
 }
 
+std::vector<std::shared_ptr<Object>> FootModelLoad::GetInputs() const {
+	return {};
+}
+
+std::vector<std::shared_ptr<Object>> FootModelLoad::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> FootModelLoad::GetParameters() const {
+	return { filename };
+}
+
+size_t FootModelLoad::GetHash() const {
+	const size_t hash = Operation::GetHash();
+	if (hash == 0)
+		return 0;
+	// Include the modification time of the file.
+	std::error_code ec;
+	const auto timeModified = std::filesystem::last_write_time(
+			filename->GetString(), ec);
+	if (ec)
+		return 0;
+	return HashCombine(hash, timeModified.time_since_epoch().count());
+}
+
 bool FootModelLoad::CanRun() {
 	std::string missing;
 
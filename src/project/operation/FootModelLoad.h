@@ -42,6 +42,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 class FootModelLoad: public Operation {
 public:
@@ -50,6 +51,10 @@ public:
 	bool CanRun() override;
 	bool HasToRun() override;
 	std::string GetName() const override;
+	std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
+	size_t GetHash() const override;
 	void Run() override;
 	bool Propagate() override;
 
@@ -38,6 +38,18 @@ std::string FootModelUpdate::GetName() const {
 	return "FootModelUpdate";
 }
 
+std::vector<std::shared_ptr<Object>> FootModelUpdate::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> FootModelUpdate::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> FootModelUpdate::GetParameters() const {
+	return { heelPitch, toeSpring, heelHeight, ballHeight, legLengthDifference };
+}
+
 bool FootModelUpdate::CanRun() {
 	std::string missing;
 
@@ -27,6 +27,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <system_error>
 
 FootScanLoad::FootScanLoad() {
 	out = std::make_shared<FootModel>();
@@ -36,6 +37,31 @@ std::string FootScanLoad::GetName() const {
 	return "FootScanLoad";
 }
 
+std::vector<std::shared_ptr<Object>> FootScanLoad::GetInputs() const {
+	return {};
+}
+
+std::vector<std::shared_ptr<Object>> FootScanLoad::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> FootScanLoad::GetParameters() const {
+	return { filename };
+}
+
+size_t FootScanLoad::GetHash() const {
+	const size_t hash = Operation::GetHash();
+	if (hash == 0)
+		return 0;
+	// Include the modification time of the file.
+	std::error_code ec;
+	const auto timeModified = std::filesystem::last_write_time(
+			filename->GetString(), ec);
+	if (ec)
+		return 0;
+	return HashCombine(hash, timeModified.time_since_epoch().count());
+}
+
 bool FootScanLoad::CanRun() {
 	std::string missing;
 
@@ -41,6 +41,7 @@
 
 #include <memory>
 #include <filesystem>
+#include <vector>
 
 class FootScanLoad: public Operation {
 public:
@@ -48,6 +49,10 @@ public:
 	bool CanRun() override;
 	bool HasToRun() override;
 	std::string GetName() const override;
+	std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
+	size_t GetHash() const override;
 	void Run() override;
 	bool Propagate() override;
 
@@ -38,6 +38,18 @@ std::string HeelCenter::GetName() const {
 	return "HeelCenter";
 }
 
+std::vector<std::shared_ptr<Object>> HeelCenter::GetInputs() const {
+	return { heel_in, insole_in };
+}
+
+std::vector<std::shared_ptr<Object>> HeelCenter::GetOutputs() const {
+	return { heel_out, insole_out };
+}
+
+std::vector<std::shared_ptr<Parameter>> HeelCenter::GetParameters() const {
+	return { overAnkleBoneLevel };
+}
+
 bool HeelCenter::CanRun() {
 	std::string missing;
 
@@ -44,6 +44,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class HeelCenter: public Operation {
 public:
@@ -51,6 +52,9 @@ public:
 	virtual ~HeelCenter() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
@@ -24,6 +24,12 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 #include "HeelConstruct.h"
+
+#include "../../3D/DistanceField.h"
+#include "../../math/MathParser.h"
+#include "../../system/Cancellation.h"
+
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 
@@ -35,6 +41,18 @@ std::string HeelConstruct::GetName() const {
 	return "HeelConstruct";
 }
 
+std::vector<std::shared_ptr<Object>> HeelConstruct::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> HeelConstruct::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> HeelConstruct::GetParameters() const {
+	return { heelCode };
+}
+
 bool HeelConstruct::CanRun() {
 	std::string missing;
 
@@ -92,6 +110,68 @@ void HeelConstruct::Run() {
 
 	out->Clear();
 
+	BoundingBox box;
+	for (size_t n = 0; n < in->CountVertices(); n++)
+		box.Insert(in->GetVertex(n));
+	if (!box.IsEmpty()) {
+		try {
+			// The code returns the signed distance to the heel at x, y, z.
+			MathParser parser;
+			parser.vm.heap.Set("x", MathParser::Value(0.0, Unit("m")));
+			parser.vm.heap.Set("y", MathParser::Value(0.0, Unit("m")));
+			parser.vm.heap.Set("z", MathParser::Value(0.0, Unit("m")));
+			parser.ParseCode(heelCode->GetString());
+			const size_t idxX = parser.vm.heap.GetIndex("x");
+			const size_t idxY = parser.vm.heap.GetIndex("y");
+			const size_t idxZ = parser.vm.heap.GetIndex("z");
+			auto Code = [&](const Vector3 &p) {
+				parser.vm.Reset();
+				parser.vm.heap[idxX]() = p.x;
+				parser.vm.heap[idxY]() = p.y;
+				parser.vm.heap[idxZ]() = p.z;
+				parser.vm.Run();
+				if (parser.vm.stack.empty())
+					return 0.0;
+				return parser.vm.stack.front().ToDouble();
+			};
+
+			// Find the heel on a coarse grid below the insole first. Only the
+			// box around it is calculated at the full resolution.
+			const double coarse = std::max(0.004, resolution);
+			DistanceField search;
+			search.SetGrid(
+					Vector3(box.xmin - coarse, box.ymin - coarse,
+							box.zmin - depth),
+					Vector3(box.xmax + coarse, box.ymax + coarse,
+							box.zmax + coarse), coarse);
+			search.FromGeometry(*in);
+			search.Apply(DistanceField::Operation::Intersection, Code);
+			const BoundingBox heel = search.GetBoundingBox(2.0 * coarse);
+
+			if (!heel.IsEmpty()) {
+				DistanceField field;
+				field.maxDistance = 4.0 * resolution;
+				field.SetGrid(Vector3(heel.xmin, heel.ymin, heel.zmin),
+						Vector3(heel.xmax, heel.ymax, heel.zmax), resolution);
+				field.FromGeometry(*in);
+				field.Apply(DistanceField::Operation::Intersection, Code);
+				field.CalcSurface();
+				AffineTransformMatrix m;
+				m.TranslateGlobal(field.origin.x, field.origin.y,
+						field.origin.z);
+				field.geometry.Transform(m);
+				field.geometry.CalculateNormals();
+				*out = field.geometry;
+			}
+		} catch (const Cancellation::Exception&) {
+			throw;
+		} catch (const std::exception &ex) {
+			// Errors in the code of the heel
+			error = ex.what();
+			out->Clear();
+		}
+	}
+
 	out->MarkValid(true);
 	out->MarkNeeded(false);
 }
@@ -34,6 +34,13 @@
  * Given the transformed insole, this operation uses the provided code
  * to generate a signed-distance-field and applie marching cubes to it to
  * generate the heel of the shoe.
+ *
+ * The code returns the signed distance to the surface of the heel (negative
+ * inside) for a point x, y, z (in m). The heel is the solid of the code below
+ * the insole: it is intersected with the column under the insole.
+ *
+ * The heel is first searched for on a coarse grid. The DistanceField at the
+ * final resolution only covers the box around the heel found.
  */
 
 #include "Operation.h"
@@ -43,12 +50,16 @@
 #include "../ParameterString.h"
 
 #include <memory>
+#include <vector>
 class HeelConstruct: public Operation {
 public:
 	HeelConstruct();
 	virtual ~HeelConstruct() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
@@ -59,6 +70,9 @@ public:
 	std::shared_ptr<ObjectGeometry> out;
 
 	std::shared_ptr<ParameterString> heelCode;
+
+	double resolution = 0.001; ///< Size of the voxels of the DistanceField
+	double depth = 0.15; ///< Depth below the insole, the heel is searched in
 };
 
 #endif /* SRC_PROJECT_OPERATION_HEELCONSTRUCT_H_ */
@@ -41,6 +41,18 @@ std::string HeelExtractInsole::GetName() const {
 	return "HeelExtractInsole";
 }
 
+std::vector<std::shared_ptr<Object>> HeelExtractInsole::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> HeelExtractInsole::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> HeelExtractInsole::GetParameters() const {
+	return {};
+}
+
 bool HeelExtractInsole::CanRun() {
 	std::string missing;
 
@@ -196,3 +208,11 @@ void HeelExtractInsole::Run() {
 	out->MarkValid(true);
 	out->MarkNeeded(false);
 }
+
+void HeelExtractInsole::RunCached() {
+	// Run() modifies the groups and the selection of the input. Redo this, so
+	// that the input is in the same state as after a normal run.
+	const Vector3 up(0.707, 0.0, 0.707);
+	in->CalculateGroups(22.5 / 180.0 * M_PI);
+	in->SelectFacesCloseTo(up);
+}
@@ -42,6 +42,7 @@
 #include "../../math/Matrix.h"
 #include "../ParameterFormula.h"
 #include <memory>
+#include <vector>
 
 class HeelExtractInsole: public Operation {
 public:
@@ -49,10 +50,14 @@ public:
 	virtual ~HeelExtractInsole() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
 	virtual void Run() override;
+	virtual void RunCached() override;
 
 public:
 
@@ -38,6 +38,18 @@ std::string HeelNormalize::GetName() const {
 	return "HeelNormalize";
 }
 
+std::vector<std::shared_ptr<Object>> HeelNormalize::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> HeelNormalize::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> HeelNormalize::GetParameters() const {
+	return { heelReorient };
+}
+
 bool HeelNormalize::CanRun() {
 	std::string missing;
 
@@ -85,8 +97,9 @@ bool HeelNormalize::HasToRun() {
 
 void HeelNormalize::Run() {
 	*out = *in;
+	out->Expand();
 
-	if (in->PassedSelfCheck()) {
+	if (out->PassedSelfCheck()) {
 		DEBUGOUT << "in is OK\n";
 	} else {
 		DEBUGOUT << "in is NOK\n";
@@ -41,6 +41,7 @@
 #include "Operation.h"
 
 #include <memory>
+#include <vector>
 
 class HeelNormalize: public Operation {
 public:
@@ -48,6 +49,9 @@ public:
 	virtual ~HeelNormalize() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
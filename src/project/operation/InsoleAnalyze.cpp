@@ -38,6 +38,19 @@ std::string InsoleAnalyze::GetName() const {
 	return "InsoleAnalyze";
 }
 
+std::vector<std::shared_ptr<Object>> InsoleAnalyze::GetInputs() const {
+	return { insole_in, insoleFlat_in };
+}
+
+std::vector<std::shared_ptr<Object>> InsoleAnalyze::GetOutputs() const {
+	return { insole_out, insoleFlat_out };
+}
+
+std::vector<std::shared_ptr<Parameter>> InsoleAnalyze::GetParameters() const {
+	return { footLength, ballMeasurementAngle, heelDirectionAngle,
+			littleToeAngle, bigToeAngle, extraLength };
+}
+
 bool InsoleAnalyze::CanRun() {
 	std::string missing;
 
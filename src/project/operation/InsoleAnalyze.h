@@ -47,12 +47,16 @@
 #include "../ParameterFormula.h"
 
 #include <memory>
+#include <vector>
 class InsoleAnalyze: public Operation {
 public:
 	InsoleAnalyze();
 	virtual ~InsoleAnalyze() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
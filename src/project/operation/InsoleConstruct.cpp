@@ -40,6 +40,20 @@ std::string InsoleConstruct::GetName() const {
 	return "InsoleConstruct";
 }
 
+std::vector<std::shared_ptr<Object>> InsoleConstruct::GetInputs() const {
+	return {};
+}
+
+std::vector<std::shared_ptr<Object>> InsoleConstruct::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> InsoleConstruct::GetParameters() const {
+	return { footLength, ballWidth, heelWidth, ballMeasurementAngle,
+			heelDirectionAngle, littleToeAngle, bigToeAngle, tipSharpness,
+			extraLength };
+}
+
 bool InsoleConstruct::CanRun() {
 	std::string missing;
 
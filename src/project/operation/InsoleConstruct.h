@@ -56,12 +56,16 @@
 #include "Operation.h"
 
 #include <memory>
+#include <vector>
 class InsoleConstruct: public Operation {
 public:
 	InsoleConstruct();
 	virtual ~InsoleConstruct() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
@@ -52,6 +52,19 @@ std::string InsoleFlatten::GetName() const {
 	return "InsoleFlatten";
 }
 
+std::vector<std::shared_ptr<Object>> InsoleFlatten::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> InsoleFlatten::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> InsoleFlatten::GetParameters() const {
+	return { debugMIDI_48, debugMIDI_49, debugMIDI_50, debugMIDI_51,
+			debugMIDI_52, debugMIDI_53, debugMIDI_54, debugMIDI_55 };
+}
+
 bool InsoleFlatten::CanRun() {
 	std::string missing;
 
@@ -182,6 +195,7 @@ void InsoleFlatten::Run() {
 		v.y = v.v;
 		v.z = 0.0;
 	}
+	out->InvalidateCache();
 	// Move the UV values from the vertices to the triangles
 	out->FlagUV(true, false);
 	out->CalculateUVCoordinateSystems();
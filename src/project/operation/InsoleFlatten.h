@@ -43,6 +43,7 @@
 #include "../ParameterValue.h"
 
 #include <memory>
+#include <vector>
 
 class InsoleFlatten: public Operation {
 public:
@@ -50,6 +51,9 @@ public:
 	virtual ~InsoleFlatten() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
@@ -39,6 +39,18 @@ std::string InsoleTransform::GetName() const {
 	return "InsoleTransform";
 }
 
+std::vector<std::shared_ptr<Object>> InsoleTransform::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> InsoleTransform::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> InsoleTransform::GetParameters() const {
+	return { heelPitch, toeSpring, heelHeight, ballHeight, legLengthDifference };
+}
+
 bool InsoleTransform::CanRun() {
 	std::string missing;
 
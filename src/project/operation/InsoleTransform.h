@@ -45,6 +45,7 @@
 #include "Operation.h"
 
 #include <memory>
+#include <vector>
 
 class InsoleTransform: public Operation {
 public:
@@ -52,6 +53,9 @@ public:
 	virtual ~InsoleTransform() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
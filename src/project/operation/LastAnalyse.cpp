@@ -46,6 +46,18 @@ std::string LastAnalyse::GetName() const {
 	return "LastAnalyse";
 }
 
+std::vector<std::shared_ptr<Object>> LastAnalyse::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> LastAnalyse::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> LastAnalyse::GetParameters() const {
+	return { lastReorient };
+}
+
 bool LastAnalyse::CanRun() {
 	std::string missing;
 
@@ -41,6 +41,7 @@
 #include "Operation.h"
 
 #include <memory>
+#include <vector>
 
 class LastAnalyse: public Operation {
 protected:
@@ -53,6 +54,9 @@ public:
 	virtual ~LastAnalyse() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
@@ -37,6 +37,18 @@ std::string LastConstruct::GetName() const {
 	return "LastConstruct";
 }
 
+std::vector<std::shared_ptr<Object>> LastConstruct::GetInputs() const {
+	return { insole, cs };
+}
+
+std::vector<std::shared_ptr<Object>> LastConstruct::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> LastConstruct::GetParameters() const {
+	return { upperLevel };
+}
+
 bool LastConstruct::CanRun() {
 	std::string missing;
 
@@ -43,6 +43,7 @@
 #include "../ParameterFormula.h"
 
 #include <memory>
+#include <vector>
 
 class LastConstruct: public Operation {
 public:
@@ -50,6 +51,9 @@ public:
 	virtual ~LastConstruct() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
@@ -38,6 +38,7 @@
 #include "../../math/Symmetry.h"
 
 #include <iostream>
+#include <vector>
 #include <sstream>
 #include <stdexcept>
 
@@ -49,6 +50,18 @@ std::string LastNormalize::GetName() const {
 	return "LastNormalize";
 }
 
+std::vector<std::shared_ptr<Object>> LastNormalize::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> LastNormalize::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> LastNormalize::GetParameters() const {
+	return { lastReorient };
+}
+
 bool LastNormalize::CanRun() {
 	std::string missing;
 
@@ -96,6 +109,7 @@ bool LastNormalize::HasToRun() {
 
 void LastNormalize::Run() {
 	*out = *in;
+	out->Expand();
 //	out->Transform(AffineTransformMatrix::Scaling(0.1));
 	out->UpdateBoundingBox();
 
@@ -196,9 +210,11 @@ void LastNormalize::ReorientSymmetry() {
 //		debug.Clear();
 	Symmetry symmetry;
 	symmetry.Init(180);
-	for (double cut = 0.2; cut < 0.81; cut += 0.2) {
-		Polygon3 section = out->IntersectPlane(Vector3(1, 0, 0),
-				bbc.GlobalX(cut));
+	std::vector<double> cuts;
+	for (double cut = 0.2; cut < 0.81; cut += 0.2)
+		cuts.push_back(bbc.GlobalX(cut));
+	for (Polygon3 &section : out->IntersectPlanes(Vector3(1, 0, 0), cuts,
+			true)) {
 
 //		ex.Add(section);
 
@@ -262,10 +278,11 @@ void LastNormalize::ReorientSole() {
 	kde.SetCyclic(2 * M_PI);
 
 	AffineTransformMatrix bbc = out->BB.GetCoordinateSystem();
-	for (double cut = 0.2; cut < 0.81; cut += 0.2) {
-		Polygon3 section = out->IntersectPlane(Vector3(1, 0, 0),
-				bbc.GlobalX(cut));
-
+	std::vector<double> cuts;
+	for (double cut = 0.2; cut < 0.81; cut += 0.2)
+		cuts.push_back(bbc.GlobalX(cut));
+	for (Polygon3 &section : out->IntersectPlanes(Vector3(1, 0, 0), cuts,
+			true)) {
 		Vector3 rot = section.GetRotationalAxis();
 		if (rot.x > 0)
 			section.Reverse();
@@ -303,9 +320,11 @@ void LastNormalize::ReorientFrontBack() {
 //		loop.Clear();
 	std::vector<double> ratio;
 	AffineTransformMatrix bbc = out->BB.GetCoordinateSystem();
-	for (double cut = 0.1; cut < 0.91; cut += 0.1) {
-		Polygon3 section = out->IntersectPlane(Vector3(1, 0, 0),
-				bbc.GlobalX(cut));
+	std::vector<double> cuts;
+	for (double cut = 0.1; cut < 0.91; cut += 0.1)
+		cuts.push_back(bbc.GlobalX(cut));
+	for (const Polygon3 &section : out->IntersectPlanes(Vector3(1, 0, 0),
+			cuts, true)) {
 		BoundingBox temp;
 		for (size_t n = 0; n < section.Size(); n++)
 			temp.Insert(section[n]);
@@ -371,9 +390,11 @@ void LastNormalize::ReorientLeftRight() {
 //		kde.XLinspace(0, 1, 100);
 //		kde.XSetLinear();
 	AffineTransformMatrix bbc = out->BB.GetCoordinateSystem();
-	for (double cut = 0.1; cut < 0.91; cut += 0.1) {
-		Polygon3 section = out->IntersectPlane(Vector3(1, 0, 0),
-				bbc.GlobalX(cut));
+	std::vector<double> cuts;
+	for (double cut = 0.1; cut < 0.91; cut += 0.1)
+		cuts.push_back(bbc.GlobalX(cut));
+	for (const Polygon3 &section : out->IntersectPlanes(Vector3(1, 0, 0),
+			cuts, true)) {
 		loop.AddEdgeToVertex(section.GetCenter());
 
 		//			BoundingBox bb2;
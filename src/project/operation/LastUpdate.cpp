@@ -36,6 +36,19 @@ std::string LastUpdate::GetName() const {
 	return "LastUpdate";
 }
 
+std::vector<std::shared_ptr<Object>> LastUpdate::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> LastUpdate::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> LastUpdate::GetParameters() const {
+	return { lastModify, heelPitch, toeSpring, heelHeight, ballHeight,
+			legLengthDifference };
+}
+
 bool LastUpdate::CanRun() {
 	std::string missing;
 
@@ -42,6 +42,7 @@
 #include "Operation.h"
 
 #include <memory>
+#include <vector>
 
 class LastUpdate: public Operation {
 public:
@@ -49,6 +50,9 @@ public:
 	virtual ~LastUpdate() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
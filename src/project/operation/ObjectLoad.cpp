@@ -31,11 +31,14 @@
 #include "../../3D/FileOBJ.h"
 #include "../../3D/FilePLY.h"
 #include "../../3D/FileSTL.h"
+#include "../../3D/MappedFile.h"
 #include "../../3D/PolyCylinder.h"
+#include "../../system/Hash.h"
 
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <system_error>
 
 ObjectLoad::ObjectLoad() {
 	out = std::make_shared<ObjectGeometry>();
@@ -45,6 +48,85 @@ std::string ObjectLoad::GetName() const {
 	return "ObjectLoad";
 }
 
+std::vector<std::shared_ptr<Object>> ObjectLoad::GetInputs() const {
+	return {};
+}
+
+std::vector<std::shared_ptr<Object>> ObjectLoad::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> ObjectLoad::GetParameters() const {
+	return { filename };
+}
+
+/**\brief SHA256 over the content of a file
+ *
+ * About 300 MB/s, still much faster than parsing the file.
+ */
+static std::string HashFile(const std::string &filename) {
+	MappedFile file(filename);
+	SHA256 hash;
+	hash.Add(file.Data(), file.Size());
+	return hash.GetHex();
+}
+
+bool ObjectLoad::AddToHash(SHA256 &hash) const {
+	if (!filename)
+		return false;
+	const std::string fn = filename->GetString();
+	std::error_code ec;
+	const auto timeModified = std::filesystem::last_write_time(fn, ec);
+	if (ec)
+		return false;
+	const uintmax_t size = std::filesystem::file_size(fn, ec);
+	if (ec)
+		return false;
+
+	std::string hashContent;
+	{
+		std::lock_guard<std::mutex> lock(mtxHash);
+		if (fn != hashedFile || timeModified != hashedTime
+				|| size != hashedSize) {
+			try {
+				fileHash = HashFile(fn);
+			} catch (const std::exception&) {
+				return false;
+			}
+			hashedFile = fn;
+			hashedTime = timeModified;
+			hashedSize = size;
+		}
+		hashContent = fileHash;
+	}
+
+	// The name of the file is not included, only the extension selecting
+	// the importer. A copy of the file has the same hash.
+	std::string extension = std::filesystem::path(fn).extension().string();
+	for (auto &ch : extension)
+		ch = std::tolower(ch);
+	hash.Add(GetName());
+	hash.Add(extension);
+	hash.Add(hashContent);
+	hash.Add((uint64_t) (compact ? 1 : 0));
+	return true;
+}
+
+size_t ObjectLoad::GetHash() const {
+	SHA256 hash;
+	if (!AddToHash(hash))
+		return 0;
+	const size_t result = (size_t) hash.Get64();
+	return (result == 0) ? 1 : result;
+}
+
+std::string ObjectLoad::GetPersistentKey() const {
+	SHA256 hash;
+	if (!AddToHash(hash))
+		return std::string();
+	return hash.GetHex();
+}
+
 bool ObjectLoad::CanRun() {
 	std::string missing;
 
@@ -139,7 +221,13 @@ void ObjectLoad::Run() {
 	if (extension.compare(".stl") == 0) {
 		FileSTL stl(filename->GetString());
 		out->Clear();
-		stl.Read(*out);
+		if (compact) {
+			FloatMesh mesh;
+			stl.Read(mesh);
+			out->Compact(std::move(mesh));
+		} else {
+			stl.Read(*out);
+		}
 	}
 
 	if (extension.compare(".dat") == 0) {
@@ -147,14 +235,22 @@ void ObjectLoad::Run() {
 		pc.Load(filepath.string());
 		*out = pc.GenerateGeometry(false);
 	}
-	out->CalculateNormals();
-	if (out->IsClosed()) {
-		DEBUGOUT << "Fully closed hull loaded." << "\n";
-	} else {
-		DEBUGOUT << "Geometry has open edges." << "\n";
+	if (!out->IsCompact()) {
+		out->CalculateNormals();
+		if (out->IsClosed()) {
+			DEBUGOUT << "Fully closed hull loaded." << "\n";
+		} else {
+			DEBUGOUT << "Geometry has open edges." << "\n";
+		}
+		if (compact)
+			out->Compact();
 	}
 	lastModified = std::filesystem::last_write_time(filepath);
 	out->MarkValid(true);
 	out->MarkNeeded(false);
 }
 
+void ObjectLoad::RunCached() {
+	lastModified = std::filesystem::last_write_time(filename->GetString());
+}
+
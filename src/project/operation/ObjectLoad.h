@@ -37,9 +37,18 @@
  * If the filename is changed or the modification time of the file is changed
  * the file is reloaded.
  *
+ * The hash for the ResultCache is calculated from the content of the file,
+ * not from its name. The result is kept in the disk cache
+ * (GetPersistentKey()), so reopening a project does not import the file
+ * again.
+ *
  * Several file formats are supported: DXF, GTS, OBJ, PLY, STL and some obscure
  * file format for sliced last scans. The files are identified by the file
  * extension.
+ *
+ * By default the mesh is stored in single precision. STL files are read
+ * without converting to double at all. The operations using the output
+ * expand their copy with ObjectGeometry::Expand().
  */
 
 #include "../../3D/Geometry.h"
@@ -47,8 +56,14 @@
 #include "../ParameterString.h"
 #include "Operation.h"
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class SHA256;
 
 class ObjectLoad: public Operation {
 public:
@@ -56,17 +71,38 @@ public:
 	virtual ~ObjectLoad() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
+	virtual size_t GetHash() const override;
+	virtual std::string GetPersistentKey() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
 	virtual void Run() override;
+	virtual void RunCached() override;
 
 	std::shared_ptr<ParameterString> filename;
 	std::shared_ptr<ObjectGeometry> out;
 
+	bool compact = true; ///< Store the loaded mesh in single precision (see ObjectGeometry::Compact()).
+
 private:
 	std::filesystem::file_time_type lastModified;
 
+	/**\brief Add everything the output depends on to the hash
+	 *
+	 * \return false, if the file cannot be read.
+	 */
+	bool AddToHash(SHA256 &hash) const;
+
+	// The hash of the content is only recalculated, if the file changes.
+	mutable std::mutex mtxHash;
+	mutable std::string hashedFile;
+	mutable std::filesystem::file_time_type hashedTime;
+	mutable uintmax_t hashedSize = 0;
+	mutable std::string fileHash; ///< SHA256 of the content in hex digits
+
 };
 
 #endif /* OPERATION_OBJECTLOAD_H */
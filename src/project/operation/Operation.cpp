@@ -25,10 +25,54 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Operation.h"
 
+#include "../Parameter.h"
+#include "../../system/Hash.h"
+
 std::string Operation::GetName() const {
 	return "Operation (base class)";
 }
 
+std::vector<std::shared_ptr<Object>> Operation::GetInputs() const {
+	return {};
+}
+
+std::vector<std::shared_ptr<Object>> Operation::GetOutputs() const {
+	return {};
+}
+
+std::vector<std::shared_ptr<Parameter>> Operation::GetParameters() const {
+	return {};
+}
+
+size_t Operation::GetHash() const {
+	SHA256 hash;
+	hash.Add(GetName());
+	for (const auto &param : GetParameters()) {
+		if (!param)
+			return 0;
+		hash.Add((uint64_t) param->GetHash());
+	}
+	for (const auto &obj : GetInputs()) {
+		if (!obj || obj->GetHash() == 0)
+			return 0;
+		hash.Add((uint64_t) obj->GetHash());
+	}
+	const size_t result = (size_t) hash.Get64();
+	return (result == 0) ? 1 : result;
+}
+
+std::string Operation::GetPersistentKey() const {
+	return std::string();
+}
+
+void Operation::RunCached() {
+	// Nothing
+}
+
+size_t Operation::HashCombine(size_t hash, size_t value) {
+	return hash ^ (value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
+}
+
 #ifdef DEBUG
 void Operation::Paint() const {
 	// Nothing
@@ -40,8 +40,14 @@
  * The operations can be scheduled to run in parallel.
  */
 
+#include "../object/Object.h"
+
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
+class Parameter;
 class Operation {
 public:
 	Operation() = default;
@@ -53,6 +59,52 @@ public:
 	 */
 	virtual std::string GetName() const;
 
+	/**\brief Return the objects read by this operation
+	 *
+	 * Used by the Builder to derive the dependencies between the operations.
+	 * Unconnected inputs are returned as nullptr.
+	 */
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const;
+
+	/**\brief Return the objects written by this operation
+	 *
+	 * Counterpart to GetInputs().
+	 */
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const;
+
+	/**\brief Return the parameters influencing this operation
+	 *
+	 * Unconnected parameters are returned as nullptr.
+	 */
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const;
+
+	/**\brief Hash over the state of all inputs and parameters
+	 *
+	 * The hash is used as the key for the ResultCache and is passed on to the
+	 * output objects. It combines the name of the operation, the values of
+	 * the parameters and the hashes of the input objects.
+	 *
+	 * Operations depending on further state (e.g. files on the drive) extend
+	 * this hash.
+	 *
+	 * \return Hash or 0, if the result cannot be cached (unknown or
+	 * 		   unconnected input).
+	 */
+	virtual size_t GetHash() const;
+
+	/**\brief Name of the outputs in the disk cache of the ResultCache
+	 *
+	 * The import of large meshes is expensive, but its result only depends on
+	 * the file and a few parameters. These operations return a key, so that
+	 * the outputs survive a restart of the program. The key has to be the
+	 * same for every run and build, e.g. the SHA256 (system/Hash.h) of the
+	 * content of the file and the parameters in hex digits.
+	 *
+	 * \return Key or an empty string (the default), if the outputs are only
+	 *         cached in memory.
+	 */
+	virtual std::string GetPersistentKey() const;
+
 	/**\brief Checking (mostly) if all inputs and all outputs are connected.
 	 *
 	 * Mostly a check, if the setup of this operations was correct and
@@ -98,11 +150,19 @@ public:
 	 */
 	virtual void Run() = 0;
 
+	/**\brief Called instead of Run(), if the outputs were restored
+	 *
+	 * The Scheduler has copied the outputs from the ResultCache and marked
+	 * them valid. Operations with internal state update it here.
+	 */
+	virtual void RunCached();
+
 #ifdef DEBUG
 	virtual void Paint() const;
 #endif
 
-public:
+	static size_t HashCombine(size_t hash, size_t value); ///< Mix a value into a hash
+
 	std::string error;
 };
 
@@ -37,6 +37,18 @@ std::string UpperConstruct::GetName() const {
 	return "UpperConstruct";
 }
 
+std::vector<std::shared_ptr<Object>> UpperConstruct::GetInputs() const {
+	return { design_in, cs_in };
+}
+
+std::vector<std::shared_ptr<Object>> UpperConstruct::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> UpperConstruct::GetParameters() const {
+	return {};
+}
+
 bool UpperConstruct::CanRun() {
 	std::string missing;
 
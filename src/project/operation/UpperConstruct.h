@@ -41,12 +41,16 @@
 #include "../object/Upper.h"
 
 #include <memory>
+#include <vector>
 class UpperConstruct: public Operation {
 public:
 	UpperConstruct();
 	virtual ~UpperConstruct() = default;
 
 	virtual std::string GetName() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetInputs() const override;
+	virtual std::vector<std::shared_ptr<Object>> GetOutputs() const override;
+	virtual std::vector<std::shared_ptr<Parameter>> GetParameters() const override;
 	virtual bool CanRun() override;
 	virtual bool Propagate() override;
 	virtual bool HasToRun() override;
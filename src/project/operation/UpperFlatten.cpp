@@ -37,6 +37,18 @@ std::string UpperFlatten::GetName() const {
 	return "UpperFlatten";
 }
 
+std::vector<std::shared_ptr<Object>> UpperFlatten::GetInputs() const {
+	return { in };
+}
+
+std::vector<std::shared_ptr<Object>> UpperFlatten::GetOutputs() const {
+	return { out };
+}
+
+std::vector<std::shared_ptr<Parameter>> UpperFlatten::GetParameters() const {
+	return {};
+}
+
 bool UpperFlatten::CanRun() {
 	std::string missing;
 
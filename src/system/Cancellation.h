@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Cancellation.h
+// Purpose            : Cooperative cancellation of long calculations
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYSTEM_CANCELLATION_H
+#define SYSTEM_CANCELLATION_H
+
+/*!\class Cancellation
+ * \brief Cooperative cancellation of long calculations
+ *
+ * A thread that runs a cancellable calculation installs the flag to watch
+ * with a Cancellation::Scope. Long loops (e.g. marching cubes, flattening,
+ * solving of surfaces) call Cancellation::Check() from time to time. If the
+ * flag was set by another thread, Check() throws a Cancellation::Exception,
+ * that unwinds the calculation.
+ *
+ * The flag is stored per thread. Code running without a Scope (e.g. in the
+ * GUI thread) is never cancelled, so the checks can be placed in library
+ * code without further ado.
+ *
+ * Header only, so that the libraries do not need to link against
+ * library_system.
+ */
+
+#include <atomic>
+#include <stdexcept>
+
+class Cancellation {
+public:
+	class Exception: public std::runtime_error {
+	public:
+		Exception() :
+				std::runtime_error("Calculation was cancelled.") {
+		}
+	};
+
+	/*!\brief Watch a flag in the current thread, while this object exists
+	 */
+	class Scope {
+	public:
+		explicit Scope(const std::atomic<bool> *flag) :
+				previous(current) {
+			current = flag;
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+		~Scope() {
+			current = previous;
+		}
+	private:
+		const std::atomic<bool> *previous;
+	};
+
+	static bool IsRequested() {
+		return current != nullptr && current->load(std::memory_order_relaxed);
+	}
+
+	static void Check() {
+		if (IsRequested())
+			throw Exception();
+	}
+
+	/*!\brief Flag watched by the current thread
+	 *
+	 * Worker threads of a calculation install the flag of the calling thread
+	 * with a Scope, so that they are cancelled as well.
+	 */
+	static const std::atomic<bool>* Current() {
+		return current;
+	}
+
+private:
+	static inline thread_local const std::atomic<bool> *current = nullptr;
+};
+
+#endif /* SYSTEM_CANCELLATION_H */
@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Hash.cpp
+// Purpose            : Checksums and hashes for files and caches
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "Hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The sums are reduced modulo 2^32 - 1 after this many words. b grows with
+// the square of the number of words and has to stay below 2^64.
+static const size_t maxWords = 65536;
+static const uint64_t modulus = 0xFFFFFFFF;
+
+static uint32_t LoadLE32(const uint8_t *p) {
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16)
+			| ((uint32_t) p[3] << 24);
+}
+
+void Fletcher64::AddWord(uint32_t word) {
+	a += word;
+	b += a;
+	if (++words == maxWords) {
+		a %= modulus;
+		b %= modulus;
+		words = 0;
+	}
+}
+
+void Fletcher64::Add(const void *data, size_t bytes) {
+	const uint8_t *p = (const uint8_t*) data;
+	while (pendingCount > 0 && pendingCount < 4 && bytes > 0) {
+		pending[pendingCount++] = *p++;
+		bytes--;
+		if (pendingCount == 4) {
+			AddWord(LoadLE32(pending));
+			pendingCount = 0;
+		}
+	}
+	for (; bytes >= 4; bytes -= 4, p += 4)
+		AddWord(LoadLE32(p));
+	for (; bytes > 0; bytes--)
+		pending[pendingCount++] = *p++;
+}
+
+uint64_t Fletcher64::Get() const {
+	Fletcher64 temp = *this;
+	if (temp.pendingCount > 0) {
+		std::memset(temp.pending + temp.pendingCount, 0,
+				4 - temp.pendingCount);
+		temp.AddWord(LoadLE32(temp.pending));
+	}
+	return ((temp.b % modulus) << 32) | (temp.a % modulus);
+}
+
+static const uint32_t k256[64] = { 0x428a2f98, 0x71374491, 0xb5c0fbcf,
+		0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98,
+		0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
+		0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+		0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8,
+		0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+		0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e,
+		0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
+		0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c,
+		0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee,
+		0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+		0xc67178f2 };
+
+static inline uint32_t RotateRight(uint32_t x, unsigned int n) {
+	return (x >> n) | (x << (32 - n));
+}
+
+SHA256::SHA256() {
+	const uint32_t init[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+			0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+	std::memcpy(state, init, sizeof(state));
+}
+
+void SHA256::Transform(uint32_t state[8], const uint8_t block[64]) {
+	uint32_t w[64];
+	for (size_t i = 0; i < 16; i++)
+		w[i] = ((uint32_t) block[4 * i] << 24)
+				| ((uint32_t) block[4 * i + 1] << 16)
+				| ((uint32_t) block[4 * i + 2] << 8)
+				| (uint32_t) block[4 * i + 3];
+	for (size_t i = 16; i < 64; i++) {
+		const uint32_t s0 = RotateRight(w[i - 15], 7)
+				^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		const uint32_t s1 = RotateRight(w[i - 2], 17)
+				^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+	uint32_t a = state[0];
+	uint32_t b = state[1];
+	uint32_t c = state[2];
+	uint32_t d = state[3];
+	uint32_t e = state[4];
+	uint32_t f = state[5];
+	uint32_t g = state[6];
+	uint32_t h = state[7];
+	for (size_t i = 0; i < 64; i++) {
+		const uint32_t S1 = RotateRight(e, 6) ^ RotateRight(e, 11)
+				^ RotateRight(e, 25);
+		const uint32_t ch = (e & f) ^ (~e & g);
+		const uint32_t t1 = h + S1 + ch + k256[i] + w[i];
+		const uint32_t S0 = RotateRight(a, 2) ^ RotateRight(a, 13)
+				^ RotateRight(a, 22);
+		const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+		const uint32_t t2 = S0 + maj;
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+void SHA256::Add(const void *data, size_t bytes) {
+	const uint8_t *p = (const uint8_t*) data;
+	length += bytes;
+	if (blockCount > 0) {
+		const size_t n = std::min(bytes, 64 - blockCount);
+		std::memcpy(block + blockCount, p, n);
+		blockCount += n;
+		p += n;
+		bytes -= n;
+		if (blockCount < 64)
+			return;
+		Transform(state, block);
+		blockCount = 0;
+	}
+	for (; bytes >= 64; bytes -= 64, p += 64)
+		Transform(state, p);
+	std::memcpy(block, p, bytes);
+	blockCount = bytes;
+}
+
+void SHA256::Add(const std::string &value) {
+	Add((uint64_t) value.size());
+	Add(value.data(), value.size());
+}
+
+void SHA256::Add(uint64_t value) {
+	uint8_t bytes[8];
+	for (size_t i = 0; i < 8; i++)
+		bytes[i] = (uint8_t) (value >> (8 * i));
+	Add(bytes, sizeof(bytes));
+}
+
+void SHA256::Finish(uint8_t digest[32]) const {
+	// Padding: a single 1 bit, zeros and the length in bits (big endian).
+	SHA256 temp = *this;
+	const uint64_t bits = length * 8;
+	const uint8_t one = 0x80;
+	temp.Add(&one, 1);
+	const uint8_t zero[64] = { 0 };
+	temp.Add(zero, (temp.blockCount <= 56) ? (56 - temp.blockCount) :
+			(120 - temp.blockCount));
+	uint8_t size[8];
+	for (size_t i = 0; i < 8; i++)
+		size[i] = (uint8_t) (bits >> (56 - 8 * i));
+	temp.Add(size, sizeof(size));
+	for (size_t i = 0; i < 8; i++)
+		for (size_t j = 0; j < 4; j++)
+			digest[4 * i + j] = (uint8_t) (temp.state[i] >> (24 - 8 * j));
+}
+
+std::string SHA256::GetHex() const {
+	uint8_t digest[32];
+	Finish(digest);
+	const char hex[] = "0123456789abcdef";
+	std::string result;
+	for (uint8_t byte : digest) {
+		result += hex[byte >> 4];
+		result += hex[byte & 15];
+	}
+	return result;
+}
+
+uint64_t SHA256::Get64() const {
+	uint8_t digest[32];
+	Finish(digest);
+	uint64_t result = 0;
+	for (size_t i = 0; i < 8; i++)
+		result = (result << 8) | digest[i];
+	return result;
+}
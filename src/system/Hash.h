@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Hash.h
+// Purpose            : Checksums and hashes for files and caches
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef SYSTEM_HASH_H
+#define SYSTEM_HASH_H
+
+/*!\class Fletcher64
+ * \brief Fast checksum to detect damaged data
+ *
+ * Fletcher's checksum over 32 bit little endian words. The data can be added
+ * in pieces of any size; the result only depends on the sequence of bytes.
+ * A trailing incomplete word is padded with zeros.
+ *
+ * This detects truncated files and random bit errors. It is not meant to
+ * identify content, i.e. it is not collision resistant.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Fletcher64 {
+public:
+	void Add(const void *data, size_t bytes);
+	uint64_t Get() const;
+
+private:
+	void AddWord(uint32_t word);
+	uint64_t a = 0;
+	uint64_t b = 0;
+	size_t words = 0; ///< Words added since the last reduction of a and b
+	uint8_t pending[4] = { 0, 0, 0, 0 };
+	size_t pendingCount = 0;
+};
+
+/*!\class SHA256
+ * \brief Secure hash algorithm SHA-256 (FIPS 180-4)
+ *
+ * Used to identify content, e.g. as a key for a cache on disk. The result is
+ * the same for every build and platform, in contrast to std::hash.
+ *
+ * The data can be added in pieces. Strings are added with their length, so
+ * that a sequence of strings cannot be confused with a different split of
+ * the same characters.
+ */
+class SHA256 {
+public:
+	SHA256();
+
+	void Add(const void *data, size_t bytes);
+	void Add(const std::string &value); ///< Length and characters
+	void Add(uint64_t value); ///< As 8 bytes in little endian order
+
+	std::string GetHex() const; ///< 64 hex digits
+	uint64_t Get64() const; ///< The first 8 bytes of the digest
+
+private:
+	void Finish(uint8_t digest[32]) const;
+	static void Transform(uint32_t state[8], const uint8_t block[64]);
+	uint32_t state[8];
+	uint8_t block[64];
+	size_t blockCount = 0; ///< Bytes in block
+	uint64_t length = 0; ///< Total number of bytes added
+};
+
+#endif /* SYSTEM_HASH_H */
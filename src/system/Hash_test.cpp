@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : Hash_test.cpp
+// Purpose            : Tests for the checksums and hashes
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef USE_CPPUNIT
+
+#include "Hash.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <string>
+
+class HashTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( HashTest );
+	CPPUNIT_TEST(testFletcher64);
+	CPPUNIT_TEST(testSHA256);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	void testFletcher64() {
+		// Test vectors of Fletcher-64 with little endian words
+		Fletcher64 sum;
+		sum.Add("abcde", 5);
+		CPPUNIT_ASSERT_EQUAL((uint64_t) 0xC8C6C527646362C6, sum.Get());
+		Fletcher64 sum2;
+		sum2.Add("abcdef", 6);
+		CPPUNIT_ASSERT_EQUAL((uint64_t) 0xC8C72B276463C8C6, sum2.Get());
+
+		// The result does not depend on the pieces.
+		std::string data;
+		for (size_t n = 0; n < 300000; n++)
+			data += (char) (n * 7 + n / 13);
+		Fletcher64 whole;
+		whole.Add(data.data(), data.size());
+		Fletcher64 pieces;
+		size_t pos = 0;
+		for (size_t len = 1; pos < data.size(); len = len % 11 + 1) {
+			const size_t n = std::min(len, data.size() - pos);
+			pieces.Add(data.data() + pos, n);
+			pos += n;
+		}
+		CPPUNIT_ASSERT_EQUAL(whole.Get(), pieces.Get());
+		data[1000] ^= 1;
+		Fletcher64 changed;
+		changed.Add(data.data(), data.size());
+		CPPUNIT_ASSERT(whole.Get() != changed.Get());
+	}
+
+	void testSHA256() {
+		// Test vectors of FIPS 180-4
+		CPPUNIT_ASSERT_EQUAL(
+				std::string(
+						"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"),
+				SHA256().GetHex());
+		SHA256 abc;
+		abc.Add("abc", 3);
+		CPPUNIT_ASSERT_EQUAL(
+				std::string(
+						"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"),
+				abc.GetHex());
+		CPPUNIT_ASSERT_EQUAL((uint64_t) 0xba7816bf8f01cfea, abc.Get64());
+		const std::string two =
+				"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+		SHA256 sha2;
+		sha2.Add(two.data(), two.size());
+		CPPUNIT_ASSERT_EQUAL(
+				std::string(
+						"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"),
+				sha2.GetHex());
+
+		// One million 'a', added in uneven pieces
+		const std::string a(1000, 'a');
+		SHA256 million;
+		size_t count = 0;
+		for (size_t len = 1; count < 1000000; len = len % 97 + 1) {
+			const size_t n = std::min(len, 1000000 - count);
+			million.Add(a.data(), n);
+			count += n;
+		}
+		CPPUNIT_ASSERT_EQUAL(
+				std::string(
+						"cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"),
+				million.GetHex());
+
+		// Strings are separated by their length.
+		SHA256 s1;
+		s1.Add(std::string("ab"));
+		s1.Add(std::string("c"));
+		SHA256 s2;
+		s2.Add(std::string("a"));
+		s2.Add(std::string("bc"));
+		CPPUNIT_ASSERT(s1.GetHex() != s2.GetHex());
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(HashTest);
+#endif
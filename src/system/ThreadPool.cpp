@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ThreadPool.cpp
+// Purpose            : Shared pool of threads for parallel loops
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "ThreadPool.h"
+
+#include "Cancellation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**\brief One call of ThreadPool::ForEach()
+ */
+struct ThreadPool::Job {
+	const std::function<void(size_t)> *task = nullptr;
+	size_t count = 0;
+	std::atomic<size_t> next { 0 }; ///< Next task to start
+	const std::atomic<bool> *cancel = nullptr;
+	unsigned int slots = 0; ///< Threads of the pool, that may still join
+	unsigned int active = 0; ///< Threads of the pool working on the job
+	std::exception_ptr error;
+};
+
+/**\brief The threads of the pool and the queue of the jobs
+ */
+class ThreadPool::Workers {
+public:
+	Workers() {
+		const unsigned int threads = ThreadPool::GetThreads();
+		for (unsigned int n = 1; n < threads; n++)
+			workers.emplace_back(&Workers::Loop, this);
+	}
+	~Workers() {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			stop = true;
+		}
+		cvWork.notify_all();
+		for (std::thread &th : workers)
+			th.join();
+	}
+
+	void Run(Job &job) {
+		if (!workers.empty() && job.slots > 0) {
+			std::lock_guard<std::mutex> lock(mtx);
+			queue.push_back(&job);
+			cvWork.notify_all();
+		}
+		Work(job);
+		// No thread of the pool may join after this. The threads already
+		// working on the job are waited for.
+		std::unique_lock<std::mutex> lock(mtx);
+		queue.erase(std::remove(queue.begin(), queue.end(), &job),
+				queue.end());
+		cvDone.wait(lock, [&job] {
+			return job.active == 0;
+		});
+	}
+
+private:
+	void Work(Job &job) {
+		Cancellation::Scope scope(job.cancel);
+		for (size_t n = job.next++; n < job.count; n = job.next++) {
+			try {
+				Cancellation::Check();
+				(*job.task)(n);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mtx);
+				if (!job.error)
+					job.error = std::current_exception();
+				job.next = job.count;
+			}
+		}
+	}
+
+	void Loop() {
+		std::unique_lock<std::mutex> lock(mtx);
+		while (true) {
+			cvWork.wait(lock, [this] {
+				return stop || !queue.empty();
+			});
+			if (stop)
+				return;
+			Job &job = *queue.front();
+			if (job.slots == 0 || job.next >= job.count) {
+				queue.pop_front();
+				continue;
+			}
+			job.slots--;
+			job.active++;
+			lock.unlock();
+			Work(job);
+			lock.lock();
+			job.active--;
+			if (job.active == 0)
+				cvDone.notify_all();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<Job*> queue;
+	bool stop = false;
+	std::mutex mtx;
+	std::condition_variable cvWork;
+	std::condition_variable cvDone;
+};
+
+void ThreadPool::ForEach(size_t count,
+		const std::function<void(size_t)> &task, unsigned int threads) {
+	if (count == 0)
+		return;
+	if (threads == 0)
+		threads = GetThreads();
+	threads = (unsigned int) std::min<size_t>(threads, count);
+	if (threads <= 1) {
+		for (size_t n = 0; n < count; n++) {
+			Cancellation::Check();
+			task(n);
+		}
+		return;
+	}
+	static Workers pool;
+	Job job;
+	job.task = &task;
+	job.count = count;
+	job.cancel = Cancellation::Current();
+	job.slots = threads - 1;
+	pool.Run(job);
+	if (job.error)
+		std::rethrow_exception(job.error);
+}
+
+unsigned int ThreadPool::GetThreads() {
+	return std::max<unsigned int>(std::thread::hardware_concurrency(), 1);
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ThreadPool.h
+// Purpose            : Shared pool of threads for parallel loops
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef SYSTEM_THREADPOOL_H
+#define SYSTEM_THREADPOOL_H
+
+/*!\class ThreadPool
+ * \brief Shared pool of threads for parallel loops in the libraries
+ *
+ * The threads are started once, on the first call, with one thread per core
+ * besides the calling thread. All parallel loops of the program share them,
+ * instead of starting and joining threads on every call.
+ *
+ * ForEach() runs the tasks of a loop on the pool and waits for them. The
+ * calling thread works on the tasks as well. Therefore a ForEach() inside of
+ * a task (or with all threads of the pool busy) cannot deadlock; it just
+ * runs with fewer threads.
+ *
+ * The Cancellation flag of the calling thread is installed in the threads
+ * running its tasks, so a cancelled calculation stops on all threads. The
+ * flag is checked before each task.
+ */
+
+#include <cstddef>
+#include <functional>
+
+class ThreadPool {
+public:
+	/**\brief Call task(n) for 0 <= n < count in parallel
+	 *
+	 * If a task throws, the tasks not yet started are skipped. The first
+	 * exception is rethrown in the calling thread, after the running tasks
+	 * have ended.
+	 *
+	 * \param count Number of tasks
+	 * \param task Function to call with the index of the task
+	 * \param threads Maximum number of threads working on the tasks,
+	 *                including the calling thread, 0 for one per core
+	 */
+	static void ForEach(size_t count, const std::function<void(size_t)> &task,
+			unsigned int threads = 0);
+
+	static unsigned int GetThreads(); ///< Number of cores, at least 1
+
+private:
+	struct Job;
+	class Workers;
+};
+
+#endif /* SYSTEM_THREADPOOL_H */
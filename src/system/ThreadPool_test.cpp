@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name               : ThreadPool_test.cpp
+// Purpose            : Tests for the shared pool of threads
+// Thread Safe        : Yes
+// Platform dependent : No
+// Compiler Options   :
+// Author             : Tobias Schaefer
+// Created            : 17.10.2026
+// Copyright          : (C) 2026 Tobias Schaefer <tobiassch@users.sourceforge.net>
+// Licence            : GNU General Public License version 3.0 (GPLv3)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef USE_CPPUNIT
+
+#include "ThreadPool.h"
+
+#include "Cancellation.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+class ThreadPoolTest: public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( ThreadPoolTest );
+	CPPUNIT_TEST(testForEach);
+	CPPUNIT_TEST(testException);
+	CPPUNIT_TEST(testNested);
+	CPPUNIT_TEST(testCancellation);
+	CPPUNIT_TEST_SUITE_END();
+public:
+
+	void testForEach() {
+		// Every task runs exactly once, for any number of threads.
+		for (unsigned int threads = 0; threads <= 5; threads++) {
+			std::vector<std::atomic<int>> calls(1000);
+			ThreadPool::ForEach(calls.size(), [&](size_t n) {
+				calls[n]++;
+			}, threads);
+			for (const std::atomic<int> &c : calls)
+				CPPUNIT_ASSERT_EQUAL(1, c.load());
+		}
+		ThreadPool::ForEach(0, [](size_t) {
+			CPPUNIT_ASSERT(false);
+		});
+	}
+
+	void testException() {
+		std::atomic<size_t> calls(0);
+		bool thrown = false;
+		try {
+			ThreadPool::ForEach(10000, [&](size_t n) {
+				calls++;
+				if (n == 10)
+					throw std::runtime_error("Task failed.");
+			}, 4);
+		} catch (const std::runtime_error &ex) {
+			thrown = true;
+		}
+		CPPUNIT_ASSERT(thrown);
+		// The remaining tasks were skipped.
+		CPPUNIT_ASSERT(calls < 10000);
+
+		// The pool is still usable.
+		std::atomic<size_t> sum(0);
+		ThreadPool::ForEach(100, [&](size_t n) {
+			sum += n;
+		}, 4);
+		CPPUNIT_ASSERT_EQUAL((size_t) 4950, sum.load());
+	}
+
+	void testNested() {
+		std::atomic<size_t> sum(0);
+		ThreadPool::ForEach(8, [&](size_t a) {
+			ThreadPool::ForEach(100, [&](size_t b) {
+				sum += a * b;
+			}, 4);
+		}, 4);
+		CPPUNIT_ASSERT_EQUAL((size_t) 28 * 4950, sum.load());
+	}
+
+	void testCancellation() {
+		// The flag of the calling thread stops the tasks on all threads.
+		std::atomic<bool> cancel(false);
+		std::atomic<size_t> calls(0);
+		bool cancelled = false;
+		try {
+			Cancellation::Scope scope(&cancel);
+			ThreadPool::ForEach(10000, [&](size_t n) {
+				calls++;
+				if (n == 10)
+					cancel = true;
+				Cancellation::Check();
+			}, 4);
+		} catch (const Cancellation::Exception &ex) {
+			cancelled = true;
+		}
+		CPPUNIT_ASSERT(cancelled);
+		CPPUNIT_ASSERT(calls < 10000);
+		CPPUNIT_ASSERT(Cancellation::Current() == nullptr);
+	}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ThreadPoolTest);
+#endif